@@ -12,6 +12,7 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
 #include <thread>
 #include <memory>
 
@@ -25,6 +26,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QSaveFile>
 #include <QtCore/QString>
+#include <QtCore/QThread>
 #include <QtGui/QImageReader>
 #include <QtCore/QVector>
 #include <QtCore/QUrlQuery>
@@ -39,6 +41,7 @@
 #include "BakeAssetTask.h"
 #include "SendAssetTask.h"
 #include "UploadAssetTask.h"
+#include "UploadChunkedAssetTask.h"
 
 static const uint8_t MIN_CORES_FOR_MULTICORE = 4;
 static const uint8_t CPU_AFFINITY_COUNT_HIGH = 2;
@@ -113,24 +116,76 @@ QString getBakeMapping(const AssetUtils::AssetHash& hash, const QString& relativ
 
 const QString ASSET_SERVER_LOGGING_TARGET_NAME = "asset-server";
 
-void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) {
+void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                            int priority) {
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
     if (it == _pendingBakes.end()) {
-        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
+        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath, _chunkedAssets);
         task->setAutoDelete(false);
+        if (_pendingBakes.isEmpty()) {
+            _bakeStats.busySinceUsecs = usecTimestampNow();
+        }
         _pendingBakes[assetHash] = task;
 
         connect(task.get(), &BakeAssetTask::bakeComplete, this, &AssetServer::handleCompletedBake);
         connect(task.get(), &BakeAssetTask::bakeFailed, this, &AssetServer::handleFailedBake);
         connect(task.get(), &BakeAssetTask::bakeAborted, this, &AssetServer::handleAbortedBake);
 
-        _bakingTaskPool.start(task.get());
+        _bakingTaskPool.start(task.get(), priority);
     } else {
         qDebug() << "Already in queue";
     }
 }
 
+void AssetServer::cancelBake(const AssetUtils::AssetHash& assetHash) {
+    auto it = _pendingBakes.find(assetHash);
+    if (it == _pendingBakes.end()) {
+        return;
+    }
+
+    if (_bakingTaskPool.tryTake(it->get())) {
+        qDebug() << "Cancelled queued bake for" << assetHash;
+        finishBake(assetHash, BakeOutcome::Aborted);
+    } else {
+        // the task reports back through handleAbortedBake
+        qDebug() << "Aborting bake for" << assetHash;
+        it.value()->abort();
+    }
+}
+
+void AssetServer::finishBake(const AssetUtils::AssetHash& assetHash, BakeOutcome outcome) {
+    auto it = _pendingBakes.find(assetHash);
+    if (it == _pendingBakes.end()) {
+        return;
+    }
+
+    if (outcome == BakeOutcome::Aborted) {
+        ++_bakeStats.numAborted;
+    } else {
+        if (outcome == BakeOutcome::Completed) {
+            ++_bakeStats.numCompleted;
+        } else {
+            ++_bakeStats.numFailed;
+        }
+
+        const auto& usage = it.value()->getUsage();
+        _bakeStats.totalQueuedUsecs += usage.queuedUsecs;
+        _bakeStats.totalBakeUsecs += usage.bakeUsecs;
+        _bakeStats.totalCpuUsecs += usage.cpuUsecs;
+        _bakeStats.maxPeakMemoryBytes = std::max(_bakeStats.maxPeakMemoryBytes, usage.peakMemoryBytes);
+
+        qDebug() << "Bake of" << assetHash << "waited" << usage.queuedUsecs / USECS_PER_MSEC << "ms and took"
+            << usage.bakeUsecs / USECS_PER_MSEC << "ms, using" << usage.cpuUsecs / USECS_PER_MSEC << "ms of CPU and"
+            << usage.peakMemoryBytes / (1024 * 1024) << "MB of memory";
+    }
+
+    _pendingBakes.erase(it);
+    if (_pendingBakes.isEmpty()) {
+        _bakeStats.busyUsecs += usecTimestampNow() - _bakeStats.busySinceUsecs;
+    }
+}
+
 QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash) {
     return _filesDirectory.absoluteFilePath(assetHash);
 }
@@ -181,18 +236,38 @@ std::pair<AssetUtils::BakingStatus, QString> AssetServer::getAssetStatus(const A
 }
 
 void AssetServer::bakeAssets() {
+    QHash<AssetUtils::AssetHash, int> numReferences;
+    for (const auto& mapping : _fileMappings) {
+        ++numReferences[mapping.second];
+    }
+
     auto it = _fileMappings.cbegin();
     for (; it != _fileMappings.cend(); ++it) {
         auto path = it->first;
         auto hash = it->second;
-        maybeBake(path, hash);
+        maybeBake(path, hash, numReferences.value(hash));
     }
 }
 
-void AssetServer::maybeBake(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) {
+// The assets used by the most mappings are baked first, since the most content is waiting on them.
+// Textures go ahead of the models that use them when the counts are equal.
+static int bakePriority(const AssetUtils::AssetPath& path, int numReferences) {
+    static const int MAX_PRIORITY_REFERENCES = 1 << 20;
+    int typePriority = assetTypeForFilename(path) == BakedAssetType::Texture ? 1 : 0;
+    return std::min(numReferences, MAX_PRIORITY_REFERENCES) * 2 + typePriority;
+}
+
+void AssetServer::maybeBake(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash, int numReferences) {
     if (needsToBeBaked(path, hash)) {
+        if (numReferences <= 0) {
+            numReferences = (int)std::count_if(_fileMappings.cbegin(), _fileMappings.cend(),
+                                               [&hash](const AssetUtils::Mappings::value_type& mapping) {
+                return mapping.second == hash;
+            });
+        }
+
         qDebug() << "Queuing bake of: " << path;
-        bakeAsset(hash, path, getPathToAssetHash(hash));
+        bakeAsset(hash, path, getPathToAssetHash(hash), bakePriority(path, numReferences));
     }
 }
 
@@ -291,8 +366,18 @@ void updateConsumedCores() {
 }
 
 
+// the oven uses several threads for some bakes, so leave it room by default
+static int defaultBakeThreadCount() {
+    return std::max(QThread::idealThreadCount() / 2, 1);
+}
+
+// keep popular assets mapped, within what the address space and open file limits allow
+static const qint64 ASSET_CACHE_MAX_MAPPED_BYTES = sizeof(void*) > 4 ? 4LL * 1024 * 1024 * 1024 : 256LL * 1024 * 1024;
+static const int ASSET_CACHE_MAX_ASSETS = 512;
+
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
+    _assetCache(ASSET_CACHE_MAX_MAPPED_BYTES, ASSET_CACHE_MAX_ASSETS),
     _transferTaskPool(this),
     _bakingTaskPool(this),
     _filesizeLimit(AssetUtils::MAX_UPLOAD_SIZE)
@@ -304,11 +389,12 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     // so the ideal is greater than the number of cores on the system.
     static const int TASK_POOL_THREAD_COUNT = 50;
     _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
-    _bakingTaskPool.setMaxThreadCount(1);
+    _bakingTaskPool.setMaxThreadCount(defaultBakeThreadCount());
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload, PacketType::AssetMappingOperation }, this, "queueRequests");
+    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload, PacketType::AssetMappingOperation,
+                                              PacketType::AssetChunkQuery, PacketType::AssetChunkedUpload }, this, "queueRequests");
 
 #ifdef Q_OS_WIN
     updateConsumedCores();
@@ -331,17 +417,8 @@ void AssetServer::aboutToFinish() {
     _transferTaskPool.clear();
 
     // abort each of our still running bake tasks, remove pending bakes that were never put on the thread pool
-    auto it = _pendingBakes.begin();
-    while (it != _pendingBakes.end()) {
-        auto pendingRunnable =  _bakingTaskPool.tryTake(it->get());
-
-        if (pendingRunnable) {
-            it = _pendingBakes.erase(it);
-        } else {
-            qDebug() << "Aborting bake for" << it.key();
-            it.value()->abort();
-            ++it;
-        }
+    for (const auto& hash : _pendingBakes.keys()) {
+        cancelBake(hash);
     }
 
     // make sure all bakers are finished or aborted
@@ -423,6 +500,14 @@ void AssetServer::completeSetup() {
         setFinished(true);
         return;
     }
+    _chunkedAssets.setFilesDirectory(_filesDirectory);
+
+    static const QString BAKE_THREADS_OPTION = "bake_threads";
+    int bakeThreads = assetServerObject[BAKE_THREADS_OPTION].toInt(0);
+    if (bakeThreads > 0) {
+        _bakingTaskPool.setMaxThreadCount(bakeThreads);
+    }
+    qCInfo(asset_server) << "Baking assets on" << _bakingTaskPool.maxThreadCount() << "threads.";
 
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
@@ -435,6 +520,7 @@ void AssetServer::completeSetup() {
         auto hashedFiles = files.filter(hashFileRegex);
 
         qCInfo(asset_server) << "There are" << hashedFiles.size() << "asset files in the asset directory.";
+        qCInfo(asset_server) << "There are" << _chunkedAssets.getAssetHashes().size() << "assets stored as chunks.";
 
         if (_fileMappings.size() > 0) {
             cleanupUnmappedFiles();
@@ -468,6 +554,8 @@ void AssetServer::completeSetup() {
     packetReceiver.registerListener(PacketType::AssetGetInfo, this, "handleAssetGetInfo");
     packetReceiver.registerListener(PacketType::AssetUpload, this, "handleAssetUpload");
     packetReceiver.registerListener(PacketType::AssetMappingOperation, this, "handleAssetMappingOperation");
+    packetReceiver.registerListener(PacketType::AssetChunkQuery, this, "handleAssetChunkQuery");
+    packetReceiver.registerListener(PacketType::AssetChunkedUpload, this, "handleAssetChunkedUpload");
 
     replayRequests();
 }
@@ -510,6 +598,12 @@ void AssetServer::replayRequests() {
             case PacketType::AssetMappingOperation:
                 handleAssetMappingOperation(request.first, request.second);
                 break;
+            case PacketType::AssetChunkQuery:
+                handleAssetChunkQuery(request.first, request.second);
+                break;
+            case PacketType::AssetChunkedUpload:
+                handleAssetChunkedUpload(request.first, request.second);
+                break;
             default:
                 qCWarning(asset_server) << "Unknown queued request type:" << request.first->getType();
                 break;
@@ -537,6 +631,7 @@ void AssetServer::cleanupUnmappedFiles() {
             if (!matched) {
                 // remove the unmapped file
                 QFile removeableFile { fileInfo.absoluteFilePath() };
+                _assetCache.remove(filename);
 
                 if (removeableFile.remove()) {
                     qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
@@ -548,6 +643,33 @@ void AssetServer::cleanupUnmappedFiles() {
             }
         }
     }
+
+    bool removedManifest { false };
+    for (const auto& hash : _chunkedAssets.getAssetHashes()) {
+        bool matched { false };
+        for (auto& pair : _fileMappings) {
+            if (pair.second == hash) {
+                matched = true;
+                break;
+            }
+        }
+        if (!matched && _chunkedAssets.removeAsset(hash)) {
+            qCDebug(asset_server) << "\tDeleted" << hash << "from chunked assets since it is unmapped.";
+            _assetCache.remove(hash);
+            removedManifest = true;
+
+            // assets that also had a whole file had their baked paths removed along with it above
+            bool hadFile = std::any_of(files.begin(), files.end(), [&hash](const QFileInfo& fileInfo) {
+                return fileInfo.fileName() == hash;
+            });
+            if (!hadFile) {
+                removeBakedPathsForDeletedAsset(hash);
+            }
+        }
+    }
+    if (removedManifest) {
+        _chunkedAssets.collectUnreferencedChunks(_transferTaskPool);
+    }
 }
 
 void AssetServer::cleanupBakedFilesForDeletedAssets() {
@@ -844,10 +966,18 @@ void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, Sh
     QString fileName = QString(hexHash);
     QFileInfo fileInfo { _filesDirectory.filePath(fileName) };
 
+    qint64 assetSize;
     if (fileInfo.exists() && fileInfo.isReadable()) {
         qCDebug(asset_server) << "Opening file: " << fileInfo.filePath();
+        assetSize = fileInfo.size();
+    } else {
+        // assets uploaded in chunks only have a manifest, -1 if there isn't one either
+        assetSize = _chunkedAssets.getAssetSize(fileName);
+    }
+
+    if (assetSize >= 0) {
         replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-        replyPacket->writePrimitive(fileInfo.size());
+        replyPacket->writePrimitive(assetSize);
     } else {
         qCDebug(asset_server) << "Asset not found: " << QString(hexHash);
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
@@ -866,8 +996,27 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
         return;
     }
 
+    auto request = SendAssetTask::readRequest(message, senderNode);
+    QString key = QString(request.assetHash.toHex()) + ":" + QString::number(request.byteRange.fromInclusive) + ":"
+        + QString::number(request.byteRange.toExclusive);
+
+    {
+        // an identical request is already being read, so wait for its result rather than reading the asset again
+        QMutexLocker lock { &_coalescedAssetGetsMutex };
+        auto it = _coalescedAssetGets.find(key);
+        if (it != _coalescedAssetGets.end()) {
+            it->push_back(request);
+            ++_numCoalescedAssetGets;
+            return;
+        }
+        _coalescedAssetGets.insert(key, std::vector<SendAssetTask::Request>());
+    }
+
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(request, _filesDirectory, _chunkedAssets, _assetCache, [this, key] {
+        QMutexLocker lock { &_coalescedAssetGetsMutex };
+        return _coalescedAssetGets.take(key);
+    });
     _transferTaskPool.start(task);
 }
 
@@ -907,6 +1056,81 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     }
 }
 
+void AssetServer::handleAssetChunkQuery(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    MessageID messageID;
+    uint32_t numChunks;
+
+    if (message->getSize() < qint64(sizeof(messageID) + sizeof(numChunks))) {
+        qCDebug(asset_server) << "ERROR bad chunk query";
+        return;
+    }
+
+    message->readPrimitive(&messageID);
+    message->readPrimitive(&numChunks);
+
+    auto replyPacket = NLPacketList::create(PacketType::AssetChunkQueryReply, QByteArray(), true, true);
+    replyPacket->writePrimitive(messageID);
+
+    bool canWriteToAssetServer = true;
+    if (senderNode) {
+        canWriteToAssetServer = senderNode->getCanWriteToAssetServer();
+    }
+
+    if (!canWriteToAssetServer) {
+        // only nodes that may upload are told which chunks are here
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::PermissionDenied);
+    } else if (message->getBytesLeftToRead() != qint64(numChunks) * AssetUtils::SHA256_HASH_LENGTH) {
+        qCDebug(asset_server) << "ERROR bad chunk query";
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
+    } else {
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
+        replyPacket->writePrimitive(numChunks);
+        for (uint32_t i = 0; i < numChunks; ++i) {
+            QByteArray chunkHash = message->read(AssetUtils::SHA256_HASH_LENGTH);
+            uint8_t isPresent = _chunkedAssets.hasChunk(chunkHash) ? 1 : 0;
+            replyPacket->writePrimitive(isPresent);
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (senderNode) {
+        nodeList->sendPacketList(std::move(replyPacket), *senderNode);
+    } else {
+        nodeList->sendPacketList(std::move(replyPacket), message->getSenderSockAddr());
+    }
+}
+
+void AssetServer::handleAssetChunkedUpload(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    bool canWriteToAssetServer = true;
+    if (senderNode) {
+        canWriteToAssetServer = senderNode->getCanWriteToAssetServer();
+    }
+
+    if (canWriteToAssetServer) {
+        qCDebug(asset_server) << "Starting an UploadChunkedAssetTask for upload from" << message->getSourceID();
+
+        auto task = new UploadChunkedAssetTask(message, senderNode, _filesDirectory, _chunkedAssets, _filesizeLimit);
+        _transferTaskPool.start(task);
+    } else {
+        auto permissionErrorPacket = NLPacket::create(PacketType::AssetUploadReply, sizeof(MessageID) + sizeof(AssetUtils::AssetServerError), true);
+
+        MessageID messageID;
+        message->readPrimitive(&messageID);
+
+        // write the message ID and a permission denied error
+        permissionErrorPacket->writePrimitive(messageID);
+        permissionErrorPacket->writePrimitive(AssetUtils::AssetServerError::PermissionDenied);
+
+        // send off the packet
+        auto nodeList = DependencyManager::get<NodeList>();
+        if (senderNode) {
+            nodeList->sendPacket(std::move(permissionErrorPacket), *senderNode);
+        } else {
+            nodeList->sendPacket(std::move(permissionErrorPacket), message->getSenderSockAddr());
+        }
+    }
+}
+
 void AssetServer::sendStatsPacket() {
     QJsonObject serverStats;
 
@@ -957,6 +1181,55 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    quint64 cacheHits = _assetCache.getNumHits();
+    quint64 cacheRequests = cacheHits + _assetCache.getNumMisses();
+    QJsonObject cacheStats;
+    cacheStats["1. Hits"] = (double)cacheHits;
+    cacheStats["2. Misses"] = (double)_assetCache.getNumMisses();
+    cacheStats["3. Hit Ratio (%)"] = cacheRequests > 0 ? (100.0 * cacheHits) / cacheRequests : 0.0;
+    cacheStats["4. Bytes Served"] = (double)_assetCache.getBytesServed();
+    cacheStats["5. Cached Assets"] = _assetCache.getNumAssets();
+    cacheStats["6. Mapped (MB)"] = (double)_assetCache.getMappedBytes() / (1024 * 1024);
+    cacheStats["7. Coalesced Requests"] = (double)_numCoalescedAssetGets;
+    serverStats["Asset Cache"] = cacheStats;
+
+    QJsonObject chunkedUploadStats;
+    chunkedUploadStats["1. Uploads"] = (double)_chunkedAssets.getNumUploads();
+    chunkedUploadStats["2. Bytes Sent"] = (double)_chunkedAssets.getBytesSent();
+    chunkedUploadStats["3. Bytes Deduplicated"] = (double)_chunkedAssets.getBytesDeduplicated();
+    serverStats["Chunked Uploads"] = chunkedUploadStats;
+
+    int numBaking = 0;
+    for (const auto& task : _pendingBakes) {
+        if (task->isBaking()) {
+            ++numBaking;
+        }
+    }
+    quint64 numBaked = _bakeStats.numCompleted + _bakeStats.numFailed;
+    quint64 busyUsecs = _bakeStats.busyUsecs;
+    if (!_pendingBakes.isEmpty()) {
+        busyUsecs += usecTimestampNow() - _bakeStats.busySinceUsecs;
+    }
+
+    QJsonObject bakeStats;
+    bakeStats["1. Threads"] = _bakingTaskPool.maxThreadCount();
+    bakeStats["2. Queued"] = _pendingBakes.size() - numBaking;
+    bakeStats["3. Baking"] = numBaking;
+    bakeStats["4. Completed"] = (double)_bakeStats.numCompleted;
+    bakeStats["5. Failed"] = (double)_bakeStats.numFailed;
+    bakeStats["6. Aborted"] = (double)_bakeStats.numAborted;
+    bakeStats["7. Bakes Per Minute"] = busyUsecs > 0 ? (double)numBaked * SECS_PER_MINUTE * USECS_PER_SECOND / busyUsecs : 0.0;
+
+    QJsonObject perBakeStats;
+    if (numBaked > 0) {
+        perBakeStats["1. Average Wait (s)"] = (double)_bakeStats.totalQueuedUsecs / numBaked / USECS_PER_SECOND;
+        perBakeStats["2. Average Bake (s)"] = (double)_bakeStats.totalBakeUsecs / numBaked / USECS_PER_SECOND;
+        perBakeStats["3. Average CPU (s)"] = (double)_bakeStats.totalCpuUsecs / numBaked / USECS_PER_SECOND;
+    }
+    perBakeStats["4. Max Peak Memory (MB)"] = (double)_bakeStats.maxPeakMemoryBytes / (1024 * 1024);
+    bakeStats["8. Per Bake"] = perBakeStats;
+    serverStats["Baking"] = bakeStats;
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1168,11 +1441,20 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
         }
 
         // we now have a set of hashes that are unmapped - we will delete those asset files
+        bool removedManifest { false };
         for (auto& hash : hashesToCheckForDeletion) {
-            // remove the unmapped file
+            // remove the unmapped file, and its manifest if it was uploaded in chunks
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
+            _assetCache.remove(hash);
+            cancelBake(hash);
 
-            if (removeableFile.remove()) {
+            bool removedFile = removeableFile.remove();
+            if (_chunkedAssets.removeAsset(hash)) {
+                removedManifest = true;
+                removedFile = true;
+            }
+
+            if (removedFile) {
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
 
                 removeBakedPathsForDeletedAsset(hash);
@@ -1181,6 +1463,10 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
             }
         }
 
+        if (removedManifest) {
+            _chunkedAssets.collectUnreferencedChunks(_transferTaskPool);
+        }
+
         return true;
     } else {
         qCWarning(asset_server) << "Failed to persist deleted mappings, rolling back";
@@ -1309,7 +1595,7 @@ void AssetServer::handleFailedBake(QString originalAssetHash, QString assetPath,
 
     writeMetaFile(originalAssetHash, meta);
 
-    _pendingBakes.remove(originalAssetHash);
+    finishBake(originalAssetHash, BakeOutcome::Failed);
 }
 
 void AssetServer::handleCompletedBake(QString originalAssetHash, QString originalAssetPath,
@@ -1332,7 +1618,7 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
 
         writeMetaFile(originalAssetHash, meta);
 
-        _pendingBakes.remove(originalAssetHash);
+        finishBake(originalAssetHash, errorCompletingBake ? BakeOutcome::Failed : BakeOutcome::Completed);
     };
 
     bool errorCompletingBake { false };
@@ -1465,7 +1751,7 @@ void AssetServer::handleAbortedBake(QString originalAssetHash, QString assetPath
     qDebug() << "Aborted bake:" << originalAssetHash;
 
     // for an aborted bake we don't do anything but remove the BakeAssetTask from our pending bakes
-    _pendingBakes.remove(originalAssetHash);
+    finishBake(originalAssetHash, BakeOutcome::Aborted);
 }
 
 static const QString BAKE_VERSION_KEY = "bake_version";
@@ -1583,6 +1869,7 @@ bool AssetServer::setBakingEnabled(const AssetUtils::AssetPathList& paths, bool
                 maybeBake(path, hash);
                 qDebug() << "Enabled baking for" << path;
             } else if (!enabled && !currentlyDisabled) {
+                cancelBake(hash);
                 removeBakedPathsForDeletedAsset(hash);
                 setMapping(bakedMapping, hash);
                 qDebug() << "Disabled baking for" << path;
@@ -12,6 +12,9 @@
 #ifndef hifi_AssetServer_h
 #define hifi_AssetServer_h
 
+#include <atomic>
+#include <vector>
+
 #include <QtCore/QDir>
 #include <QtCore/QThreadPool>
 #include <QRunnable>
@@ -19,7 +22,10 @@
 #include <ThreadedAssignment.h>
 
 #include "AssetUtils.h"
+#include "ChunkedAssetStore.h"
+#include "MappedAssetCache.h"
 #include "ReceivedMessage.h"
+#include "SendAssetTask.h"
 
 #include "RegisteredMetaTypes.h"
 
@@ -87,6 +93,8 @@ private slots:
     void handleAssetGetInfo(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetGet(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetUpload(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer senderNode);
+    void handleAssetChunkQuery(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetChunkedUpload(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void sendStatsPacket() override;
@@ -130,17 +138,31 @@ private:
     std::pair<AssetUtils::BakingStatus, QString> getAssetStatus(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash);
 
     void bakeAssets();
-    void maybeBake(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash);
+
+    /// Queue a bake if the asset needs one; numReferences is how many mappings use the hash, counted when not given
+    void maybeBake(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash, int numReferences = 0);
     void createEmptyMetaFile(const AssetUtils::AssetHash& hash);
     bool hasMetaFile(const AssetUtils::AssetHash& hash);
     bool needsToBeBaked(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& assetHash);
-    void bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
+    void bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                   int priority = 0);
+
+    /// Drop a queued bake, or abort it if it is already running
+    void cancelBake(const AssetUtils::AssetHash& assetHash);
 
     /// Move baked content for asset to baked directory and update baked status
     void handleCompletedBake(QString originalAssetHash, QString assetPath, QString bakedTempOutputDir);
     void handleFailedBake(QString originalAssetHash, QString assetPath, QString errors);
     void handleAbortedBake(QString originalAssetHash, QString assetPath);
 
+    enum class BakeOutcome {
+        Completed,
+        Failed,
+        Aborted
+    };
+    /// Account for a finished bake and remove it from the pending bakes
+    void finishBake(const AssetUtils::AssetHash& assetHash, BakeOutcome outcome);
+
     /// Create meta file to describe baked content for original asset
     std::pair<bool, AssetMeta> readMetaFile(AssetUtils::AssetHash hash);
     bool writeMetaFile(AssetUtils::AssetHash originalAssetHash, const AssetMeta& meta = AssetMeta());
@@ -153,12 +175,37 @@ private:
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
+    /// Assets uploaded in chunks; declared before the task pools, since the tasks read and write it
+    ChunkedAssetStore _chunkedAssets;
+
+    /// Asset files kept mapped between downloads; declared before the task pool so that it outlives the tasks
+    MappedAssetCache _assetCache;
+
+    /// AssetGet requests waiting on an identical request that is already being read, keyed by hash and byte range;
+    /// also declared before the task pool, since the tasks take their followers from it
+    QMutex _coalescedAssetGetsMutex;
+    QHash<QString, std::vector<SendAssetTask::Request>> _coalescedAssetGets;
+    std::atomic<quint64> _numCoalescedAssetGets { 0 };
+
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
 
+    struct BakeStats {
+        quint64 numCompleted { 0 };
+        quint64 numFailed { 0 };
+        quint64 numAborted { 0 };           // including the bakes cancelled before they started
+        quint64 totalQueuedUsecs { 0 };     // the totals are over the completed and failed bakes
+        quint64 totalBakeUsecs { 0 };
+        quint64 totalCpuUsecs { 0 };
+        quint64 maxPeakMemoryBytes { 0 };
+        quint64 busyUsecs { 0 };            // time there were bakes pending, not counting the current stretch
+        quint64 busySinceUsecs { 0 };
+    };
+    BakeStats _bakeStats;
+
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
     using RequestQueue = QVector<QPair<QSharedPointer<ReceivedMessage>, SharedNodePointer>>;
@@ -11,23 +11,105 @@
 
 #include "BakeAssetTask.h"
 
+#include <algorithm>
 #include <mutex>
 
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
 #include <QCoreApplication>
 
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <Psapi.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
 #include <PathUtils.h>
+#include <SharedUtil.h>
+
+#include "ChunkedAssetStore.h"
 
 static const int OVEN_STATUS_CODE_SUCCESS { 0 };
 static const int OVEN_STATUS_CODE_FAIL { 1 };
 static const int OVEN_STATUS_CODE_ABORT { 2 };
 
+static const int OVEN_USAGE_SAMPLE_INTERVAL_MS { 250 };
+
+// reads the CPU time and peak resident memory of a running process, where the platform allows it
+static bool readProcessUsage(qint64 pid, quint64& cpuUsecs, quint64& peakMemoryBytes) {
+#if defined(Q_OS_LINUX)
+    QFile statFile(QString("/proc/%1/stat").arg(pid));
+    QFile statusFile(QString("/proc/%1/status").arg(pid));
+    if (!statFile.open(QIODevice::ReadOnly) || !statusFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    // the command name can contain spaces, so count the fields from the state that follows it
+    QByteArray stat = statFile.readAll();
+    int commandEnd = stat.lastIndexOf(')');
+    if (commandEnd < 0) {
+        return false;
+    }
+    QList<QByteArray> fields = stat.mid(commandEnd + 2).split(' ');
+    static const int UTIME_FIELD = 11;
+    static const int STIME_FIELD = 12;
+    if (fields.size() <= STIME_FIELD) {
+        return false;
+    }
+    static const quint64 TICKS_PER_SECOND = sysconf(_SC_CLK_TCK);
+    quint64 ticks = fields[UTIME_FIELD].toULongLong() + fields[STIME_FIELD].toULongLong();
+    cpuUsecs = ticks * USECS_PER_SECOND / TICKS_PER_SECOND;
+
+    peakMemoryBytes = 0;
+    for (const QByteArray& line : statusFile.readAll().split('\n')) {
+        if (line.startsWith("VmHWM:")) {
+            peakMemoryBytes = line.mid(6).trimmed().split(' ').first().toULongLong() * 1024;
+            break;
+        }
+    }
+    return true;
+#elif defined(Q_OS_WIN)
+    HANDLE process = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, (DWORD)pid);
+    if (!process) {
+        return false;
+    }
+
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    PROCESS_MEMORY_COUNTERS counters;
+    bool success = GetProcessTimes(process, &creationTime, &exitTime, &kernelTime, &userTime) &&
+        GetProcessMemoryInfo(process, &counters, sizeof(counters));
+    CloseHandle(process);
+    if (!success) {
+        return false;
+    }
+
+    // FILETIMEs count 100ns intervals
+    auto toUsecs = [](const FILETIME& time) {
+        return (((quint64)time.dwHighDateTime << 32) | time.dwLowDateTime) / 10;
+    };
+    cpuUsecs = toUsecs(kernelTime) + toUsecs(userTime);
+    peakMemoryBytes = counters.PeakWorkingSetSize;
+    return true;
+#else
+    Q_UNUSED(pid);
+    Q_UNUSED(cpuUsecs);
+    Q_UNUSED(peakMemoryBytes);
+    return false;
+#endif
+}
+
 std::once_flag registerMetaTypesFlag;
 
-BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) :
+BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                             const ChunkedAssetStore& chunkedAssets) :
     _assetHash(assetHash),
     _assetPath(assetPath),
-    _filePath(filePath)
+    _filePath(filePath),
+    _chunkedAssets(chunkedAssets),
+    _createdUsecs(usecTimestampNow())
 {
 
     std::call_once(registerMetaTypesFlag, []() {
@@ -42,11 +124,25 @@ void BakeAssetTask::run() {
         return;
     }
 
+    quint64 startUsecs = usecTimestampNow();
+    _usage.queuedUsecs = startUsecs - _createdUsecs;
+    auto stopClock = [this, startUsecs] {
+        _usage.bakeUsecs = usecTimestampNow() - startUsecs;
+    };
+
+    // cancelled while it was waiting for a thread
+    if (_wasAborted) {
+        stopClock();
+        emit bakeAborted(_assetHash, _assetPath);
+        return;
+    }
+
     // Make a new temporary directory for the Oven to work in
     QString tempOutputDir = PathUtils::generateTemporaryDir();
     QString tempOutputDirName = QDir(tempOutputDir).dirName();
     if (tempOutputDir.isEmpty()) {
         QString errors = "Could not create temporary working directory";
+        stopClock();
         emit bakeFailed(_assetHash, _assetPath, errors);
         PathUtils::deleteMyTemporaryDir(tempOutputDirName);
         return;
@@ -55,9 +151,12 @@ void BakeAssetTask::run() {
     // Copy file to bake the temporary dir and give a name the oven can work with
     auto assetName = _assetPath.split("/").last();
     auto tempAssetPath = tempOutputDir + "/" + assetName;
-    auto success = QFile::copy(_filePath, tempAssetPath);
+    // assets uploaded as chunks are reassembled for the oven
+    auto success = QFile::exists(_filePath) ? QFile::copy(_filePath, tempAssetPath)
+                                            : _chunkedAssets.writeAssetToFile(_assetHash, tempAssetPath);
     if (!success) {
         QString errors = "Couldn't copy file to bake to temporary directory";
+        stopClock();
         emit bakeFailed(_assetHash, _assetPath, errors);
         PathUtils::deleteMyTemporaryDir(tempOutputDirName);
         return;
@@ -77,8 +176,9 @@ void BakeAssetTask::run() {
     QEventLoop loop;
 
     connect(_ovenProcess.get(), static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
-            this, [&loop, this, tempOutputDir, tempAssetPath, tempOutputDirName](int exitCode, QProcess::ExitStatus exitStatus) {
+            this, [&loop, this, stopClock, tempOutputDir, tempAssetPath, tempOutputDirName](int exitCode, QProcess::ExitStatus exitStatus) {
         qDebug() << "Baking process finished: " << exitCode << exitStatus;
+        stopClock();
 
         if (exitStatus == QProcess::CrashExit) {
             PathUtils::deleteMyTemporaryDir(tempOutputDirName);
@@ -121,24 +221,51 @@ void BakeAssetTask::run() {
         PathUtils::deleteMyTemporaryDir(tempOutputDirName);
 
         QString errors = "Oven process failed to start";
+        stopClock();
         emit bakeFailed(_assetHash, _assetPath, errors);
         return;
     }
 
     _isBaking = true;
 
+    // aborted while the oven was starting
+    if (_wasAborted) {
+        _ovenProcess->terminate();
+    }
+
+    QTimer usageTimer;
+    usageTimer.setInterval(OVEN_USAGE_SAMPLE_INTERVAL_MS);
+    connect(&usageTimer, &QTimer::timeout, this, [this] {
+        sampleOvenUsage();
+    }, Qt::DirectConnection);
+    sampleOvenUsage();
+    usageTimer.start();
+
     loop.exec();
 }
 
+void BakeAssetTask::sampleOvenUsage() {
+    if (!_ovenProcess || _ovenProcess->state() != QProcess::Running) {
+        return;
+    }
+
+    quint64 cpuUsecs;
+    quint64 peakMemoryBytes;
+    if (readProcessUsage(_ovenProcess->processId(), cpuUsecs, peakMemoryBytes)) {
+        _usage.cpuUsecs = std::max(_usage.cpuUsecs, cpuUsecs);
+        _usage.peakMemoryBytes = std::max(_usage.peakMemoryBytes, peakMemoryBytes);
+    }
+}
+
 void BakeAssetTask::abort() {
     if (QThread::currentThread() != thread()) {
         QMetaObject::invokeMethod(this, "abort");
         return;
     }
     qDebug() << "Aborting BakeAssetTask for" << _assetHash;
-    if (_ovenProcess->state() != QProcess::NotRunning) {
+    _wasAborted = true;
+    if (_ovenProcess && _ovenProcess->state() != QProcess::NotRunning) {
         qDebug() << "Teminating oven process for" << _assetHash;
-        _wasAborted = true;
         _ovenProcess->terminate();
     }
 }
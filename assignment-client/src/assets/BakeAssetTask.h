@@ -12,6 +12,7 @@
 #ifndef hifi_BakeAssetTask_h
 #define hifi_BakeAssetTask_h
 
+#include <atomic>
 #include <memory>
 
 #include <QtCore/QDebug>
@@ -22,18 +23,32 @@
 
 #include <AssetUtils.h>
 
+class ChunkedAssetStore;
+
 class BakeAssetTask : public QObject, public QRunnable {
     Q_OBJECT
 public:
-    BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
+    BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                  const ChunkedAssetStore& chunkedAssets);
 
     // Thread-safe inspection methods
     bool isBaking() { return _isBaking.load(); }
     bool wasAborted() const { return _wasAborted.load(); }
 
+    // What the bake cost, complete once one of the bake signals has been emitted. The oven's CPU time and peak memory
+    // are sampled while it runs, on the platforms where that is cheap, so they miss the last moments of the bake.
+    struct Usage {
+        quint64 queuedUsecs { 0 };          // waiting for a baking thread
+        quint64 bakeUsecs { 0 };
+        quint64 cpuUsecs { 0 };             // user and system time of the oven
+        quint64 peakMemoryBytes { 0 };      // peak resident memory of the oven
+    };
+    const Usage& getUsage() const { return _usage; }
+
     void run() override;
 
 public slots:
+    // safe to call before the task has started running, in which case it reports the abort as soon as it does
     void abort();
 
 signals:
@@ -42,12 +57,17 @@ signals:
     void bakeAborted(QString assetHash, QString assetPath);
     
 private:
+    void sampleOvenUsage();
+
     std::atomic<bool> _isBaking { false };
     AssetUtils::AssetHash _assetHash;
     AssetUtils::AssetPath _assetPath;
     QString _filePath;
+    const ChunkedAssetStore& _chunkedAssets;
     std::unique_ptr<QProcess> _ovenProcess { nullptr };
     std::atomic<bool> _wasAborted { false };
+    quint64 _createdUsecs { 0 };
+    Usage _usage;
 };
 
 #endif // hifi_BakeAssetTask_h
@@ -0,0 +1,265 @@
+//
+//  ChunkedAssetStore.cpp
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ChunkedAssetStore.h"
+
+#include <functional>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QRegExp>
+#include <QtCore/QRunnable>
+#include <QtCore/QSaveFile>
+#include <QtCore/QSet>
+
+#include "AssetServerLogging.h"
+
+static const QString CHUNKS_SUBDIR = "chunks";
+static const QString MANIFESTS_SUBDIR = "manifests";
+
+// a manifest is this magic and the format version, then the asset size and its chunks' hashes and sizes in order
+static const char MANIFEST_MAGIC[] = "HFAM";
+static const int MANIFEST_MAGIC_SIZE = sizeof(MANIFEST_MAGIC) - 1;
+static const quint32 MANIFEST_FORMAT_VERSION = 1;
+
+void ChunkedAssetStore::setFilesDirectory(const QDir& filesDirectory) {
+    _chunksDirectory = filesDirectory;
+    _manifestsDirectory = filesDirectory;
+
+    if (!filesDirectory.mkpath(CHUNKS_SUBDIR) || !_chunksDirectory.cd(CHUNKS_SUBDIR) ||
+        !filesDirectory.mkpath(MANIFESTS_SUBDIR) || !_manifestsDirectory.cd(MANIFESTS_SUBDIR)) {
+        qCWarning(asset_server) << "Unable to create the directories for chunked assets in" << filesDirectory.path();
+    }
+}
+
+QString ChunkedAssetStore::getChunkPath(const QByteArray& hash) const {
+    return _chunksDirectory.filePath(QString(hash.toHex()));
+}
+
+QString ChunkedAssetStore::getManifestPath(const AssetUtils::AssetHash& hash) const {
+    return _manifestsDirectory.filePath(hash);
+}
+
+bool ChunkedAssetStore::hasChunk(const QByteArray& hash) const {
+    return QFile::exists(getChunkPath(hash));
+}
+
+QByteArray ChunkedAssetStore::readChunk(const QByteArray& hash) const {
+    QFile file(getChunkPath(hash));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+bool ChunkedAssetStore::writeChunk(const QByteArray& hash, const QByteArray& data) {
+    QSaveFile file(getChunkPath(hash));
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(asset_server) << "Failed to write chunk" << hash.toHex() << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool ChunkedAssetStore::hasAsset(const AssetUtils::AssetHash& hash) const {
+    return QFile::exists(getManifestPath(hash));
+}
+
+bool ChunkedAssetStore::readManifest(const AssetUtils::AssetHash& hash, AssetUtils::AssetChunks& chunks) const {
+    QFile file(getManifestPath(hash));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    if (file.read(MANIFEST_MAGIC_SIZE) != QByteArray(MANIFEST_MAGIC, MANIFEST_MAGIC_SIZE)) {
+        qCWarning(asset_server) << "Manifest for" << hash << "is not a chunk manifest";
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 formatVersion;
+    quint64 size;
+    quint32 numChunks;
+    stream >> formatVersion >> size >> numChunks;
+    if (stream.status() != QDataStream::Ok || formatVersion != MANIFEST_FORMAT_VERSION) {
+        qCWarning(asset_server) << "Manifest for" << hash << "has an unknown format";
+        return false;
+    }
+
+    chunks.clear();
+    chunks.reserve(numChunks);
+    qint64 offset = 0;
+    for (quint32 i = 0; i < numChunks; ++i) {
+        AssetUtils::AssetChunk chunk;
+        chunk.hash.resize(AssetUtils::SHA256_HASH_LENGTH);
+        quint32 chunkSize;
+        stream.readRawData(chunk.hash.data(), chunk.hash.size());
+        stream >> chunkSize;
+        chunk.offset = offset;
+        chunk.size = chunkSize;
+        offset += chunkSize;
+        chunks.push_back(chunk);
+    }
+
+    if (stream.status() != QDataStream::Ok || offset != (qint64)size) {
+        qCWarning(asset_server) << "Manifest for" << hash << "is truncated";
+        return false;
+    }
+    return true;
+}
+
+bool ChunkedAssetStore::writeManifest(const AssetUtils::AssetHash& hash, const AssetUtils::AssetChunks& chunks) {
+    quint64 size = 0;
+    for (const auto& chunk : chunks) {
+        size += chunk.size;
+    }
+
+    QSaveFile file(getManifestPath(hash));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(asset_server) << "Failed to write manifest for" << hash << file.errorString();
+        return false;
+    }
+
+    file.write(MANIFEST_MAGIC, MANIFEST_MAGIC_SIZE);
+    QDataStream stream(&file);
+    stream << MANIFEST_FORMAT_VERSION << size << (quint32)chunks.size();
+    for (const auto& chunk : chunks) {
+        stream.writeRawData(chunk.hash.constData(), chunk.hash.size());
+        stream << (quint32)chunk.size;
+    }
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(asset_server) << "Failed to write manifest for" << hash << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QStringList ChunkedAssetStore::getAssetHashes() const {
+    QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+    return _manifestsDirectory.entryList(QDir::Files).filter(hashFileRegex);
+}
+
+qint64 ChunkedAssetStore::getAssetSize(const AssetUtils::AssetHash& hash) const {
+    AssetUtils::AssetChunks chunks;
+    if (!readManifest(hash, chunks)) {
+        return -1;
+    }
+    return chunks.empty() ? 0 : chunks.back().offset + chunks.back().size;
+}
+
+bool ChunkedAssetStore::readAsset(const AssetUtils::AssetHash& hash, QByteArray& data) const {
+    AssetUtils::AssetChunks chunks;
+    if (!readManifest(hash, chunks)) {
+        return false;
+    }
+
+    data.clear();
+    if (!chunks.empty()) {
+        data.reserve(chunks.back().offset + chunks.back().size);
+    }
+    for (const auto& chunk : chunks) {
+        QByteArray chunkData = readChunk(chunk.hash);
+        if (chunkData.size() != chunk.size) {
+            qCWarning(asset_server) << "Chunk" << chunk.hash.toHex() << "of" << hash << "is missing";
+            data.clear();
+            return false;
+        }
+        data.append(chunkData);
+    }
+    return true;
+}
+
+bool ChunkedAssetStore::writeAssetToFile(const AssetUtils::AssetHash& hash, const QString& filePath) const {
+    AssetUtils::AssetChunks chunks;
+    if (!readManifest(hash, chunks)) {
+        return false;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    for (const auto& chunk : chunks) {
+        QByteArray chunkData = readChunk(chunk.hash);
+        if (chunkData.size() != chunk.size || file.write(chunkData) != chunkData.size()) {
+            file.remove();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ChunkedAssetStore::removeAsset(const AssetUtils::AssetHash& hash) {
+    return QFile::remove(getManifestPath(hash));
+}
+
+namespace {
+
+class CollectChunksTask : public QRunnable {
+public:
+    CollectChunksTask(std::function<void()> collect) : _collect(collect) {}
+
+    void run() override { _collect(); }
+
+private:
+    std::function<void()> _collect;
+};
+
+}
+
+void ChunkedAssetStore::collectUnreferencedChunks(QThreadPool& pool) {
+    if (_isCollectionQueued.exchange(true)) {
+        // the queued collection hasn't read the manifests yet, so it will find these chunks too
+        return;
+    }
+
+    pool.start(new CollectChunksTask([this] {
+        _isCollectionQueued = false;
+        removeUnreferencedChunks();
+    }));
+}
+
+int ChunkedAssetStore::removeUnreferencedChunks() {
+    QWriteLocker lock(&_uploadLock);
+
+    QSet<QString> referencedChunks;
+    for (const auto& hash : getAssetHashes()) {
+        AssetUtils::AssetChunks chunks;
+        if (!readManifest(hash, chunks)) {
+            // keep everything rather than lose chunks that an unreadable manifest might still need
+            qCWarning(asset_server) << "Not removing unreferenced chunks, since the manifest for" << hash << "can't be read";
+            return 0;
+        }
+        for (const auto& chunk : chunks) {
+            referencedChunks.insert(chunk.hash.toHex());
+        }
+    }
+
+    int numRemoved = 0;
+    for (const auto& chunkName : _chunksDirectory.entryList(QDir::Files)) {
+        if (!referencedChunks.contains(chunkName) &&
+            QFile::remove(_chunksDirectory.filePath(chunkName))) {
+            ++numRemoved;
+        }
+    }
+
+    if (numRemoved > 0) {
+        qCDebug(asset_server) << "Removed" << numRemoved << "chunks no asset uses any more";
+    }
+    return numRemoved;
+}
+
+void ChunkedAssetStore::addUploadBytes(qint64 bytesSent, qint64 bytesDeduplicated) {
+    ++_numUploads;
+    _bytesSent += bytesSent;
+    _bytesDeduplicated += bytesDeduplicated;
+}
@@ -0,0 +1,85 @@
+//
+//  ChunkedAssetStore.h
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ChunkedAssetStore_h
+#define hifi_ChunkedAssetStore_h
+
+#include <atomic>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QStringList>
+#include <QtCore/QThreadPool>
+
+#include <AssetChunking.h>
+#include <AssetUtils.h>
+
+// Assets uploaded in chunks are stored as a manifest listing their chunks, and each chunk is stored once however many
+// assets share it. Chunks are named by their hash under files/chunks, and manifests by their asset's hash under
+// files/manifests, so none of them are mistaken for whole asset files. An asset stored both ways is served from its
+// whole file.
+//
+// Safe to use from any thread once the directory is set.
+class ChunkedAssetStore {
+public:
+    void setFilesDirectory(const QDir& filesDirectory);
+
+    // read-locked by an upload from before it writes its first chunk until it has written its manifest, so that its
+    // chunks aren't collected as unreferenced in between
+    QReadWriteLock& getUploadLock() { return _uploadLock; }
+
+    bool hasChunk(const QByteArray& hash) const;
+    QByteArray readChunk(const QByteArray& hash) const;
+    // the data has to have been checked against the hash
+    bool writeChunk(const QByteArray& hash, const QByteArray& data);
+
+    bool hasAsset(const AssetUtils::AssetHash& hash) const;
+    bool readManifest(const AssetUtils::AssetHash& hash, AssetUtils::AssetChunks& chunks) const;
+    bool writeManifest(const AssetUtils::AssetHash& hash, const AssetUtils::AssetChunks& chunks);
+    QStringList getAssetHashes() const;
+
+    // the size of the asset, or -1 if it isn't stored as chunks
+    qint64 getAssetSize(const AssetUtils::AssetHash& hash) const;
+
+    // reassembles the asset from its chunks
+    bool readAsset(const AssetUtils::AssetHash& hash, QByteArray& data) const;
+    bool writeAssetToFile(const AssetUtils::AssetHash& hash, const QString& filePath) const;
+
+    // removes the manifest; its chunks stay until they are collected
+    bool removeAsset(const AssetUtils::AssetHash& hash);
+
+    // queues removeUnreferencedChunks() on the pool unless it is already queued, since it waits for the uploads in
+    // progress and reads every manifest
+    void collectUnreferencedChunks(QThreadPool& pool);
+    int removeUnreferencedChunks();
+
+    void addUploadBytes(qint64 bytesSent, qint64 bytesDeduplicated);
+    quint64 getNumUploads() const { return _numUploads; }
+    quint64 getBytesSent() const { return _bytesSent; }
+    quint64 getBytesDeduplicated() const { return _bytesDeduplicated; }
+
+private:
+    QString getChunkPath(const QByteArray& hash) const;
+    QString getManifestPath(const AssetUtils::AssetHash& hash) const;
+
+    QDir _chunksDirectory;
+    QDir _manifestsDirectory;
+
+    QReadWriteLock _uploadLock;
+    std::atomic<bool> _isCollectionQueued { false };
+
+    std::atomic<quint64> _numUploads { 0 };
+    std::atomic<quint64> _bytesSent { 0 };
+    std::atomic<quint64> _bytesDeduplicated { 0 };
+};
+
+#endif // hifi_ChunkedAssetStore_h
@@ -0,0 +1,128 @@
+//
+//  MappedAssetCache.cpp
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MappedAssetCache.h"
+
+#include <QtCore/QDir>
+
+#include "ChunkedAssetStore.h"
+
+MappedAsset::MappedAsset(const QString& filePath) : _file(filePath) {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    _size = _file.size();
+    if (_size > 0) {
+        _mapped = _file.map(0, _size);
+    }
+
+    if (_mapped) {
+        _data = reinterpret_cast<const char*>(_mapped);
+    } else {
+        // fall back to reading the file, for empty files and where the address space is short
+        _contents = _file.readAll();
+        _data = _contents.constData();
+        _size = _contents.size();
+    }
+    _isValid = true;
+}
+
+MappedAsset::MappedAsset(const QByteArray& contents) :
+    _contents(contents),
+    _data(_contents.constData()),
+    _size(_contents.size()),
+    _isValid(true)
+{
+}
+
+MappedAsset::~MappedAsset() {
+    if (_mapped) {
+        _file.unmap(_mapped);
+    }
+}
+
+MappedAssetCache::MappedAssetCache(qint64 maxMappedBytes, int maxAssets) :
+    _maxMappedBytes(maxMappedBytes),
+    _maxAssets(maxAssets)
+{
+}
+
+MappedAssetPointer MappedAssetCache::get(const QDir& filesDirectory, const ChunkedAssetStore& chunkedAssets,
+                                         const AssetUtils::AssetHash& hash) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _assets.find(hash);
+        if (it != _assets.end()) {
+            _lru.splice(_lru.begin(), _lru, it->lruPosition);
+            ++_numHits;
+            return it->asset;
+        }
+    }
+
+    ++_numMisses;
+    auto asset = std::make_shared<const MappedAsset>(filesDirectory.filePath(hash));
+    if (!asset->isValid()) {
+        QByteArray contents;
+        if (!chunkedAssets.readAsset(hash, contents)) {
+            return nullptr;
+        }
+        asset = std::make_shared<const MappedAsset>(contents);
+    }
+
+    // too big to keep, but still good for this request
+    if (asset->getSize() > _maxMappedBytes) {
+        return asset;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _assets.find(hash);
+    if (it != _assets.end()) {
+        // mapped by another request meanwhile
+        _lru.splice(_lru.begin(), _lru, it->lruPosition);
+        return it->asset;
+    }
+
+    _lru.push_front(hash);
+    _assets.insert(hash, { asset, _lru.begin() });
+    _mappedBytes += asset->getSize();
+    evict();
+    return asset;
+}
+
+void MappedAssetCache::remove(const AssetUtils::AssetHash& hash) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _assets.find(hash);
+    if (it != _assets.end()) {
+        _mappedBytes -= it->asset->getSize();
+        _lru.erase(it->lruPosition);
+        _assets.erase(it);
+    }
+}
+
+void MappedAssetCache::evict() {
+    while (!_lru.empty() && (_mappedBytes > _maxMappedBytes || _assets.size() > _maxAssets)) {
+        auto it = _assets.find(_lru.back());
+        _mappedBytes -= it->asset->getSize();
+        _assets.erase(it);
+        _lru.pop_back();
+    }
+}
+
+qint64 MappedAssetCache::getMappedBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _mappedBytes;
+}
+
+int MappedAssetCache::getNumAssets() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _assets.size();
+}
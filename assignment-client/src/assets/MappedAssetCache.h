@@ -0,0 +1,95 @@
+//
+//  MappedAssetCache.h
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MappedAssetCache_h
+#define hifi_MappedAssetCache_h
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+
+#include "AssetUtils.h"
+
+class ChunkedAssetStore;
+class QDir;
+
+// An asset file mapped into memory, or read into it where it can't be mapped. Stays valid for as long as it is held,
+// even once it has been evicted from the cache.
+class MappedAsset {
+public:
+    MappedAsset(const QString& filePath);
+    // an asset already in memory, such as one reassembled from its chunks
+    explicit MappedAsset(const QByteArray& contents);
+    ~MappedAsset();
+
+    bool isValid() const { return _isValid; }
+    const char* getData() const { return _data; }
+    qint64 getSize() const { return _size; }
+
+private:
+    QFile _file;
+    uchar* _mapped { nullptr };
+    QByteArray _contents;
+    const char* _data { nullptr };
+    qint64 _size { 0 };
+    bool _isValid { false };
+};
+
+using MappedAssetPointer = std::shared_ptr<const MappedAsset>;
+
+// The most recently requested asset files, kept mapped so that popular assets are served from memory rather than
+// opened and read again for every request. Assets are named by their hash, so a cached one can't go stale, but it has
+// to be removed before its file is deleted. Safe to use from any thread.
+class MappedAssetCache {
+public:
+    MappedAssetCache(qint64 maxMappedBytes, int maxAssets);
+
+    // the mapped asset file, or nullptr if it doesn't exist; assets stored as chunks are reassembled into memory,
+    // and count against the same limits
+    MappedAssetPointer get(const QDir& filesDirectory, const ChunkedAssetStore& chunkedAssets, const AssetUtils::AssetHash& hash);
+    void remove(const AssetUtils::AssetHash& hash);
+
+    void addBytesServed(qint64 bytes) { _bytesServed += bytes; }
+
+    quint64 getNumHits() const { return _numHits; }
+    quint64 getNumMisses() const { return _numMisses; }
+    quint64 getBytesServed() const { return _bytesServed; }
+    qint64 getMappedBytes() const;
+    int getNumAssets() const;
+
+private:
+    void evict();
+
+    const qint64 _maxMappedBytes;
+    const int _maxAssets;
+
+    // guards the cached assets; held only to look them up and update the LRU order, not to map them
+    mutable std::mutex _mutex;
+    using LRUList = std::list<AssetUtils::AssetHash>;
+    struct Entry {
+        MappedAssetPointer asset;
+        LRUList::iterator lruPosition;
+    };
+    QHash<AssetUtils::AssetHash, Entry> _assets;
+    LRUList _lru; // most recently used first
+    qint64 _mappedBytes { 0 };
+
+    std::atomic<quint64> _numHits { 0 };
+    std::atomic<quint64> _numMisses { 0 };
+    std::atomic<quint64> _bytesServed { 0 };
+};
+
+#endif // hifi_MappedAssetCache_h
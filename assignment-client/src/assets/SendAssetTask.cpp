@@ -13,8 +13,6 @@
 
 #include <cmath>
 
-#include <QFile>
-
 #include <DependencyManager.h>
 #include <NetworkLogging.h>
 #include <NLPacket.h>
@@ -26,95 +24,108 @@
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
-    QRunnable(),
-    _message(message),
-    _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
-{
-    
-}
-
-void SendAssetTask::run() {
-    MessageID messageID;
-    ByteRange byteRange;
+SendAssetTask::Request SendAssetTask::readRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& senderNode) {
+    Request request;
+    request.message = message;
+    request.senderNode = senderNode;
 
-    _message->readPrimitive(&messageID);
-    QByteArray assetHash = _message->read(AssetUtils::SHA256_HASH_LENGTH);
+    message->readPrimitive(&request.messageID);
+    request.assetHash = message->read(AssetUtils::SHA256_HASH_LENGTH);
 
     // `start` and `end` indicate the range of data to retrieve for the asset identified by `assetHash`.
     // `start` is inclusive, `end` is exclusive. Requesting `start` = 1, `end` = 10 will retrieve 9 bytes of data,
     // starting at index 1.
-    _message->readPrimitive(&byteRange.fromInclusive);
-    _message->readPrimitive(&byteRange.toExclusive);
+    message->readPrimitive(&request.byteRange.fromInclusive);
+    message->readPrimitive(&request.byteRange.toExclusive);
+
+    return request;
+}
+
+SendAssetTask::SendAssetTask(Request request, const QDir& resourcesDir, const ChunkedAssetStore& chunkedAssets,
+                             MappedAssetCache& assetCache, TakeCoalescedRequests takeCoalescedRequests) :
+    QRunnable(),
+    _request(request),
+    _resourcesDir(resourcesDir),
+    _chunkedAssets(chunkedAssets),
+    _assetCache(assetCache),
+    _takeCoalescedRequests(takeCoalescedRequests)
+{
     
-    QString hexHash = assetHash.toHex();
+}
+
+void SendAssetTask::run() {
+    QString hexHash = _request.assetHash.toHex();
     
-    qDebug() << "Received a request for the file (" << messageID << "): " << hexHash << " from "
-        << byteRange.fromInclusive << " to " << byteRange.toExclusive;
+    qDebug() << "Received a request for the file (" << _request.messageID << "): " << hexHash << " from "
+        << _request.byteRange.fromInclusive << " to " << _request.byteRange.toExclusive;
     
-    qDebug() << "Starting task to send asset: " << hexHash << " for messageID " << messageID;
+    qDebug() << "Starting task to send asset: " << hexHash << " for messageID " << _request.messageID;
+
+    // popular assets stay mapped between requests, and are written into the replies straight from the mapping
+    MappedAssetPointer asset;
+    if (_request.byteRange.isValid()) {
+        asset = _assetCache.get(_resourcesDir, _chunkedAssets, hexHash);
+    }
+
+    sendReply(_request, asset);
+
+    // the requests for the same range that arrived meanwhile are answered from the same read
+    if (_takeCoalescedRequests) {
+        auto coalescedRequests = _takeCoalescedRequests();
+        for (const auto& request : coalescedRequests) {
+            sendReply(request, asset);
+        }
+        if (!coalescedRequests.empty()) {
+            qCDebug(networking) << "Sent asset" << hexHash << "to" << coalescedRequests.size() << "coalesced requests";
+        }
+    }
+}
+
+void SendAssetTask::sendReply(const Request& request, const MappedAssetPointer& asset) {
+    QString hexHash = request.assetHash.toHex();
+    ByteRange byteRange = request.byteRange;
+
     auto replyPacketList = NLPacketList::create(PacketType::AssetGetReply, QByteArray(), true, true);
 
-    replyPacketList->write(assetHash);
+    replyPacketList->write(request.assetHash);
 
-    replyPacketList->writePrimitive(messageID);
+    replyPacketList->writePrimitive(request.messageID);
 
     if (!byteRange.isValid()) {
         replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
-    } else {
-        QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
-        QFile file { filePath };
-
-        if (file.open(QIODevice::ReadOnly)) {
-
-            // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
-
-            // check if we're being asked to read data that we just don't have
-            // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
-                replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
-                qCDebug(networking) << "Bad byte range: " << hexHash << " "
-                    << byteRange.fromInclusive << ":" << byteRange.toExclusive;
-            } else {
-                // we have a valid byte range, handle it and send the asset
-                auto size = byteRange.size();
-
-                if (byteRange.fromInclusive >= 0) {
-
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
-
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
-
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
-                }
-
-                qCDebug(networking) << "Sending asset: " << hexHash;
-            }
-            file.close();
+    } else if (asset) {
+        // first fixup the range based on the now known file size
+        byteRange.fixupRange(asset->getSize());
+
+        // check if we're being asked to read data that we just don't have
+        // because of the file size
+        if (asset->getSize() < byteRange.fromInclusive || asset->getSize() < byteRange.toExclusive) {
+            replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
+            qCDebug(networking) << "Bad byte range: " << hexHash << " "
+                << byteRange.fromInclusive << ":" << byteRange.toExclusive;
         } else {
-            qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
-            replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
+            // we have a valid byte range, handle it and send the asset
+            auto size = byteRange.size();
+
+            // a negative range starts back from the end of the file
+            qint64 offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : asset->getSize() + byteRange.fromInclusive;
+
+            replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+            replyPacketList->writePrimitive(size);
+            replyPacketList->write(asset->getData() + offset, size);
+            _assetCache.addBytesServed(size);
+
+            qCDebug(networking) << "Sending asset: " << hexHash;
         }
+    } else {
+        qCDebug(networking) << "Asset not found: " << _resourcesDir.filePath(hexHash) << "(" << hexHash << ")";
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
     }
 
     auto nodeList = DependencyManager::get<NodeList>();
-    if (_senderNode) {
-        nodeList->sendPacketList(std::move(replyPacketList), *_senderNode);
+    if (request.senderNode) {
+        nodeList->sendPacketList(std::move(replyPacketList), *request.senderNode);
     } else {
-        nodeList->sendPacketList(std::move(replyPacketList), _message->getSenderSockAddr());
+        nodeList->sendPacketList(std::move(replyPacketList), request.message->getSenderSockAddr());
     }
 }
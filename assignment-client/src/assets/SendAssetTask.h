@@ -12,27 +12,53 @@
 #ifndef hifi_SendAssetTask_h
 #define hifi_SendAssetTask_h
 
+#include <functional>
+#include <vector>
+
 #include <QtCore/QByteArray>
+#include <QtCore/QDir>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QString>
 #include <QtCore/QRunnable>
 
 #include "AssetUtils.h"
-#include "AssetServer.h"
+#include "ByteRange.h"
+#include "ChunkedAssetStore.h"
+#include "ClientServerUtils.h"
+#include "MappedAssetCache.h"
 #include "Node.h"
+#include "ReceivedMessage.h"
 
 class NLPacket;
 
 class SendAssetTask : public QRunnable {
 public:
-    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir);
+    // an AssetGet request, read from its message up front so that identical requests can share a task
+    struct Request {
+        QSharedPointer<ReceivedMessage> message;
+        SharedNodePointer senderNode;
+        MessageID messageID { 0 };
+        QByteArray assetHash;
+        ByteRange byteRange;
+    };
+    static Request readRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& senderNode);
+
+    // hands over the identical requests that arrived while this task was reading, and stops more from joining it
+    using TakeCoalescedRequests = std::function<std::vector<Request>()>;
+
+    SendAssetTask(Request request, const QDir& resourcesDir, const ChunkedAssetStore& chunkedAssets,
+                  MappedAssetCache& assetCache, TakeCoalescedRequests takeCoalescedRequests = nullptr);
 
     void run() override;
 
 private:
-    QSharedPointer<ReceivedMessage> _message;
-    SharedNodePointer _senderNode;
+    void sendReply(const Request& request, const MappedAssetPointer& asset);
+
+    Request _request;
     QDir _resourcesDir;
+    const ChunkedAssetStore& _chunkedAssets;
+    MappedAssetCache& _assetCache;
+    TakeCoalescedRequests _takeCoalescedRequests;
 };
 
 #endif
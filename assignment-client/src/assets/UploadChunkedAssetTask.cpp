@@ -0,0 +1,145 @@
+//
+//  UploadChunkedAssetTask.cpp
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UploadChunkedAssetTask.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+
+#include <AssetUtils.h>
+#include <NodeList.h>
+#include <NLPacketList.h>
+
+#include "AssetServerLogging.h"
+#include "ClientServerUtils.h"
+
+UploadChunkedAssetTask::UploadChunkedAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
+                                               const QDir& resourcesDir, ChunkedAssetStore& chunkedAssets,
+                                               uint64_t filesizeLimit) :
+    _receivedMessage(receivedMessage),
+    _senderNode(senderNode),
+    _resourcesDir(resourcesDir),
+    _chunkedAssets(chunkedAssets),
+    _filesizeLimit(filesizeLimit)
+{
+
+}
+
+void UploadChunkedAssetTask::run() {
+    MessageID messageID;
+    _receivedMessage->readPrimitive(&messageID);
+
+    auto replyPacket = NLPacket::create(PacketType::AssetUploadReply, -1, true);
+    replyPacket->writePrimitive(messageID);
+
+    QByteArray hash;
+    auto error = storeChunks(hash);
+    replyPacket->writePrimitive(error);
+    if (error == AssetUtils::AssetServerError::NoError) {
+        replyPacket->write(hash);
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (_senderNode) {
+        nodeList->sendPacket(std::move(replyPacket), *_senderNode);
+    } else {
+        nodeList->sendPacket(std::move(replyPacket), _receivedMessage->getSenderSockAddr());
+    }
+}
+
+AssetUtils::AssetServerError UploadChunkedAssetTask::storeChunks(QByteArray& hash) {
+    uint64_t fileSize { 0 };
+    uint32_t numChunks { 0 };
+    _receivedMessage->readPrimitive(&fileSize);
+    _receivedMessage->readPrimitive(&numChunks);
+
+    if (fileSize > _filesizeLimit) {
+        return AssetUtils::AssetServerError::AssetTooLarge;
+    }
+
+    // keeps the chunks written here from being collected until the manifest that uses them is written
+    QReadLocker lock(&_chunkedAssets.getUploadLock());
+
+    QCryptographicHash hasher(QCryptographicHash::Sha256);
+    AssetUtils::AssetChunks chunks;
+    qint64 offset = 0;
+    qint64 bytesSent = 0;
+
+    for (uint32_t i = 0; i < numChunks; ++i) {
+        AssetUtils::AssetChunk chunk;
+        chunk.hash = _receivedMessage->read(AssetUtils::SHA256_HASH_LENGTH);
+
+        uint32_t chunkSize { 0 };
+        uint8_t hasData { 0 };
+        _receivedMessage->readPrimitive(&chunkSize);
+        _receivedMessage->readPrimitive(&hasData);
+        if (chunk.hash.size() != (int)AssetUtils::SHA256_HASH_LENGTH) {
+            qCWarning(asset_server) << "Chunked upload is truncated at chunk" << i;
+            return AssetUtils::AssetServerError::FileOperationFailed;
+        }
+        chunk.offset = offset;
+        chunk.size = chunkSize;
+
+        QByteArray data;
+        if (hasData) {
+            data = _receivedMessage->read(chunkSize);
+            if (data.size() != (int)chunkSize || AssetUtils::hashData(data) != chunk.hash) {
+                qCWarning(asset_server) << "Chunk" << i << "of an upload doesn't match its hash";
+                return AssetUtils::AssetServerError::FileOperationFailed;
+            }
+            if (!_chunkedAssets.hasChunk(chunk.hash) && !_chunkedAssets.writeChunk(chunk.hash, data)) {
+                return AssetUtils::AssetServerError::FileOperationFailed;
+            }
+            bytesSent += chunkSize;
+        } else {
+            data = _chunkedAssets.readChunk(chunk.hash);
+            if (data.size() != (int)chunkSize) {
+                qCDebug(asset_server) << "Chunk" << chunk.hash.toHex() << "of an upload is no longer stored";
+                return AssetUtils::AssetServerError::ChunksMissing;
+            }
+        }
+
+        hasher.addData(data);
+        offset += chunkSize;
+        chunks.push_back(chunk);
+    }
+
+    if (offset != (qint64)fileSize || _receivedMessage->getBytesLeftToRead() > 0) {
+        qCWarning(asset_server) << "Chunked upload of" << offset << "bytes doesn't match its size of" << fileSize;
+        return AssetUtils::AssetServerError::FileOperationFailed;
+    }
+
+    hash = hasher.result();
+    QString hexHash = hash.toHex();
+
+    if (_senderNode) {
+        qCDebug(asset_server) << "Hash for chunked upload from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID())
+            << "is: (" << hexHash << ") -" << bytesSent << "of" << fileSize << "bytes sent";
+    } else {
+        qCDebug(asset_server) << "Hash for chunked upload from" << _receivedMessage->getSenderSockAddr()
+            << "is: (" << hexHash << ") -" << bytesSent << "of" << fileSize << "bytes sent";
+    }
+    _chunkedAssets.addUploadBytes(bytesSent, fileSize - bytesSent);
+
+    // an asset already stored whole or as chunks doesn't need another manifest
+    if (QFile::exists(_resourcesDir.filePath(hexHash)) || _chunkedAssets.hasAsset(hexHash)) {
+        qCDebug(asset_server) << "Not writing a manifest for existing asset: " << hexHash;
+        return AssetUtils::AssetServerError::NoError;
+    }
+
+    if (!_chunkedAssets.writeManifest(hexHash, chunks)) {
+        return AssetUtils::AssetServerError::FileOperationFailed;
+    }
+
+    qCDebug(asset_server) << "Wrote manifest for" << hexHash << "with" << chunks.size() << "chunks. Upload complete";
+    return AssetUtils::AssetServerError::NoError;
+}
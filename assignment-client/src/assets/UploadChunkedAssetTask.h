@@ -0,0 +1,47 @@
+//
+//  UploadChunkedAssetTask.h
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_UploadChunkedAssetTask_h
+#define hifi_UploadChunkedAssetTask_h
+
+#include <QtCore/QDir>
+#include <QtCore/QRunnable>
+#include <QtCore/QSharedPointer>
+
+#include "ChunkedAssetStore.h"
+#include "ReceivedMessage.h"
+
+class Node;
+
+// Stores an asset uploaded as its chunks, where only the chunks the asset server didn't already have carry their data.
+// Every chunk is checked against its hash and the whole asset against the hash it is stored under, as for a whole upload.
+class UploadChunkedAssetTask : public QRunnable {
+public:
+    UploadChunkedAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode,
+                           const QDir& resourcesDir, ChunkedAssetStore& chunkedAssets, uint64_t filesizeLimit);
+
+    void run() override;
+
+    // reads the upload after its message ID and stores it, setting the asset's hash; run() replies with the result
+    AssetUtils::AssetServerError storeChunks(QByteArray& hash);
+
+private:
+
+    QSharedPointer<ReceivedMessage> _receivedMessage;
+    QSharedPointer<Node> _senderNode;
+    QDir _resourcesDir;
+    ChunkedAssetStore& _chunkedAssets;
+    uint64_t _filesizeLimit;
+};
+
+#endif // hifi_UploadChunkedAssetTask_h
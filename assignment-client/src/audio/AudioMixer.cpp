@@ -44,14 +44,17 @@ using namespace std;
 static const float DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE = 0.5f;    // attenuation = -6dB * log2(distance)
 static const int DISABLE_STATIC_JITTER_FRAMES = -1;
 static const float DEFAULT_NOISE_MUTING_THRESHOLD = 1.0f;
+static const float DISABLE_AUDIBILITY_RADIUS = 0.0f;
 static const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 static const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
 static const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
+static const int DEFAULT_NUM_INGEST_THREADS = 2;
 
 int AudioMixer::_numStaticJitterFrames{ DISABLE_STATIC_JITTER_FRAMES };
 float AudioMixer::_noiseMutingThreshold{ DEFAULT_NOISE_MUTING_THRESHOLD };
 float AudioMixer::_attenuationPerDoublingInDistance{ DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE };
+float AudioMixer::_audibilityRadius{ DISABLE_AUDIBILITY_RADIUS };
 map<QString, shared_ptr<CodecPlugin>> AudioMixer::_availableCodecs{ };
 QStringList AudioMixer::_codecPreferenceOrder{};
 vector<AudioMixer::ZoneDescription> AudioMixer::_audioZones;
@@ -85,8 +88,11 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     auto nodeList = DependencyManager::get<NodeList>();
     auto& packetReceiver = nodeList->getPacketReceiver();
 
-    // packets whose consequences are limited to their own node can be parallelized
-    packetReceiver.registerListenerForTypes({
+    // packets whose consequences are limited to their own node can be parallelized,
+    // the ingest pool lives on the networking thread so that it can hand them straight to its ingest threads
+    _ingestPool.moveToThread(nodeList->thread());
+    // the pool only touches its own synchronized queues, so it can take packets on the receiving thread
+    packetReceiver.registerHandlerForTypes({
             PacketType::MicrophoneAudioNoEcho,
             PacketType::MicrophoneAudioWithEcho,
             PacketType::InjectAudio,
@@ -101,7 +107,7 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
             PacketType::InjectorGainSet,
             PacketType::AudioSoloRequest,
             PacketType::StopInjector },
-            this, "queueAudioPacket");
+            &_ingestPool, &AudioMixerIngestPool::queueAudioPacket, PacketReceiver::Delivery::Inline);
 
     // packets whose consequences are global should be processed on the main thread
     packetReceiver.registerListener(PacketType::MuteEnvironment, this, "handleMuteEnvironmentPacket");
@@ -124,14 +130,6 @@ void AudioMixer::aboutToFinish() {
     DependencyManager::destroy<PluginManager>();
 }
 
-void AudioMixer::queueAudioPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
-    if (message->getType() == PacketType::SilentAudioFrame) {
-        _numSilentPackets++;
-    }
-
-    getOrCreateClientData(node.data())->queuePacket(message, node);
-}
-
 void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> message) {
     // make sure we have a replicated node for the original sender of the packet
     auto nodeList = DependencyManager::get<NodeList>();
@@ -157,7 +155,7 @@ void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> mess
                                                                      versionForPacketType(rewrittenType),
                                                                      message->getSenderSockAddr(), Node::NULL_LOCAL_ID);
 
-    getOrCreateClientData(replicatedNode.data())->queuePacket(replicatedMessage, replicatedNode);
+    _ingestPool.queuePacket(replicatedMessage, replicatedNode);
 }
 
 void AudioMixer::handleMuteEnvironmentPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
@@ -289,7 +287,32 @@ void AudioMixer::sendStatsPacket() {
     statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
     statsObject["avg_listeners_(silent)_per_frame"] = (float)_stats.sumListenersSilent / (float)_numStatFrames;
 
-    statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
+    statsObject["silent_packets_per_frame"] = (float)_ingestPool.takeNumSilentPackets() / (float)_numStatFrames;
+
+    // ingest stats
+    QJsonObject ingestStats;
+    ingestStats["threads"] = _ingestPool.numThreads();
+    auto ingestThreadStats = _ingestPool.sampleStats();
+    for (size_t i = 0; i < ingestThreadStats.size(); ++i) {
+        QJsonObject threadStats;
+        threadStats["packets_per_frame"] = (float)ingestThreadStats[i].packets / (float)_numStatFrames;
+        threadStats["us_busy_per_frame"] = (qint64)(ingestThreadStats[i].busyUsecs / _numStatFrames);
+        ingestStats[QString("thread_%1").arg(i)] = threadStats;
+    }
+    statsObject["ingest_stats"] = ingestStats;
+
+    // slave stats
+    QJsonObject slaveStats;
+    auto slaveThreadStats = _slavePool.sampleStats();
+    for (size_t i = 0; i < slaveThreadStats.size(); ++i) {
+        QJsonObject threadStats;
+        threadStats["us_busy_per_frame"] = (qint64)(slaveThreadStats[i].busyUsecs / _numStatFrames);
+        threadStats["us_idle_per_frame"] = (qint64)(slaveThreadStats[i].idleUsecs / _numStatFrames);
+        threadStats["chunks_per_frame"] = (float)slaveThreadStats[i].chunks / (float)_numStatFrames;
+        threadStats["steals_per_frame"] = (float)slaveThreadStats[i].steals / (float)_numStatFrames;
+        slaveStats[QString("thread_%1").arg(i)] = threadStats;
+    }
+    statsObject["slave_stats"] = slaveStats;
 
     // timing stats
     QJsonObject timingStats;
@@ -306,8 +329,11 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_sleepTiming, "sleep");
     addTiming(_frameTiming, "frame");
     addTiming(_packetsTiming, "packets");
+    addTiming(_prepareTiming, "prepare");
+    addTiming(_ingestPauseTiming, "ingest_pause");
     addTiming(_mixTiming, "mix");
     addTiming(_eventsTiming, "events");
+    timingStats["us_per_encode"] = (qint64)(_stats.encodeTime / 1000 / _numStatFrames);
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
@@ -326,10 +352,14 @@ void AudioMixer::sendStatsPacket() {
     mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    mixStats["1_hrtf_cache_hits"] = (int)(_stats.hrtfCacheHits / (float)_numStatFrames);
+    mixStats["1_hrtf_cache_misses"] = (int)(_stats.hrtfCacheMisses / (float)_numStatFrames);
+    mixStats["1_hrtf_cache_buckets"] = (int)_workerSharedData.hrtfCache.size();
 
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
     mixStats["2_active_streams"] = (int)(_stats.active / (float)_numStatFrames);
+    mixStats["2_culled_streams"] = (int)(_stats.culled / (float)_numStatFrames);
 
     mixStats["3_skippped_to_active"] = (int)(_stats.skippedToActive / (float)_numStatFrames);
     mixStats["3_skippped_to_inactive"] = (int)(_stats.skippedToInactive / (float)_numStatFrames);
@@ -337,13 +367,15 @@ void AudioMixer::sendStatsPacket() {
     mixStats["3_inactive_to_active"] = (int)(_stats.inactiveToActive / (float)_numStatFrames);
     mixStats["3_active_to_skippped"] = (int)(_stats.activeToSkipped / (float)_numStatFrames);
     mixStats["3_active_to_inactive"] = (int)(_stats.activeToInactive / (float)_numStatFrames);
+    mixStats["3_to_culled"] = (int)(_stats.toCulled / (float)_numStatFrames);
+    mixStats["3_culled_to_unculled"] = (int)(_stats.culledToUnculled / (float)_numStatFrames);
 
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
 
     statsObject["mix_stats"] = mixStats;
 
-    _numStatFrames = _numSilentPackets = 0;
+    _numStatFrames = 0;
     _stats.reset();
 
     // add stats for each listerner
@@ -429,12 +461,15 @@ void AudioMixer::start() {
 
         auto frameTimer = _frameTiming.timer();
 
-        // process (node-isolated) audio packets across slave threads
+        // stop the ingest threads from touching stream state until this frame has been mixed
         {
-            auto packetsTimer = _packetsTiming.timer();
+            auto pauseTimer = _ingestPauseTiming.timer();
+            _ingestPool.pause();
+        }
 
-            // first clear the concurrent vector of added streams that the slaves will add to when they process packets
-            _workerSharedData.addedStreams.clear();
+        // process (node-isolated) audio packets that were not already handled by the ingest threads across slave threads
+        {
+            auto packetsTimer = _packetsTiming.timer();
 
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 _slavePool.processPackets(cbegin, cend);
@@ -453,6 +488,25 @@ void AudioMixer::start() {
             QCoreApplication::processEvents();
         }
 
+        // index the streams by position so that each listener only visits the ones within audible range
+        {
+            auto prepareTimer = _prepareTiming.timer();
+
+            auto& streamGrid = _workerSharedData.streamGrid;
+            streamGrid.clear();
+            if (_audibilityRadius > 0.0f) {
+                streamGrid.setCellSize(_audibilityRadius);
+                nodeList->eachNode([&](const SharedNodePointer& node) {
+                    AudioMixerClientData* clientData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+                    if (clientData) {
+                        for (auto& stream : clientData->getAudioStreams()) {
+                            streamGrid.insert(stream->getPosition(), stream.get());
+                        }
+                    }
+                });
+            }
+        }
+
         int numToRetain = -1;
         assert(_throttlingRatio >= 0.0f && _throttlingRatio <= 1.0f);
         if (_throttlingRatio > EPSILON) {
@@ -470,6 +524,14 @@ void AudioMixer::start() {
             slave.stats.reset();
         });
 
+        // drop the shared HRTF renders that no listener used this frame
+        _workerSharedData.hrtfCache.prune(frame);
+
+        // every listener has now seen the streams added since the last mix, clear them before the ingest threads
+        // (and the next frame's packet processing) start adding to them again
+        _workerSharedData.addedStreams.clear();
+        _ingestPool.resume();
+
         ++frame;
         ++_numStatFrames;
 
@@ -548,6 +610,7 @@ void AudioMixer::throttle(chrono::microseconds duration, int frame) {
 void AudioMixer::clearDomainSettings() {
     _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
     _attenuationPerDoublingInDistance = DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE;
+    _audibilityRadius = DISABLE_AUDIBILITY_RADIUS;
     _noiseMutingThreshold = DEFAULT_NOISE_MUTING_THRESHOLD;
     _codecPreferenceOrder.clear();
     _audioZones.clear();
@@ -558,6 +621,8 @@ void AudioMixer::clearDomainSettings() {
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
     qCDebug(audio) << "AVX2 Support:" << (cpuSupportsAVX2() ? "enabled" : "disabled");
 
+    _ingestPool.setNumThreads(DEFAULT_NUM_INGEST_THREADS);
+
     if (settingsObject.contains(AUDIO_THREADING_GROUP_KEY)) {
         QJsonObject audioThreadingGroupObject = settingsObject[AUDIO_THREADING_GROUP_KEY].toObject();
         const QString AUTO_THREADS = "auto_threads";
@@ -571,6 +636,43 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        const QString NUM_INGEST_THREADS = "num_ingest_threads";
+        if (audioThreadingGroupObject.contains(NUM_INGEST_THREADS)) {
+            bool ok;
+            int numIngestThreads = audioThreadingGroupObject[NUM_INGEST_THREADS].toString().toInt(&ok);
+            if (ok) {
+                _ingestPool.setNumThreads(numIngestThreads);
+            }
+        }
+
+        AudioMixerHRTFCache::Settings hrtfCacheSettings;
+        const QString HRTF_CACHE = "hrtf_cache";
+        hrtfCacheSettings.enabled = audioThreadingGroupObject[HRTF_CACHE].toBool(hrtfCacheSettings.enabled);
+        if (hrtfCacheSettings.enabled) {
+            bool ok;
+            const QString HRTF_CACHE_MIN_DISTANCE = "hrtf_cache_min_distance";
+            float minDistance = audioThreadingGroupObject[HRTF_CACHE_MIN_DISTANCE].toString().toFloat(&ok);
+            if (ok && minDistance > 0.0f) {
+                hrtfCacheSettings.minDistance = minDistance;
+            }
+
+            const QString HRTF_CACHE_AZIMUTH_STEP = "hrtf_cache_azimuth_step";
+            float azimuthStep = audioThreadingGroupObject[HRTF_CACHE_AZIMUTH_STEP].toString().toFloat(&ok);
+            if (ok && azimuthStep > 0.0f) {
+                hrtfCacheSettings.azimuthStep = azimuthStep;
+            }
+
+            const QString HRTF_CACHE_GAIN_STEP = "hrtf_cache_gain_step";
+            float gainStep = audioThreadingGroupObject[HRTF_CACHE_GAIN_STEP].toString().toFloat(&ok);
+            if (ok && gainStep > 0.0f) {
+                hrtfCacheSettings.gainStep = gainStep;
+            }
+
+            qCDebug(audio) << "Shared HRTF cache enabled, min distance:" << hrtfCacheSettings.minDistance
+                << "azimuth step:" << hrtfCacheSettings.azimuthStep << "gain step:" << hrtfCacheSettings.gainStep;
+        }
+        _workerSharedData.hrtfCache.setSettings(hrtfCacheSettings);
+
         const QString THROTTLE_START_KEY = "throttle_start";
         const QString THROTTLE_BACKOFF_KEY = "throttle_backoff";
 
@@ -674,6 +776,16 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        const QString AUDIBILITY_RADIUS = "audibility_radius";
+        if (audioEnvGroupObject[AUDIBILITY_RADIUS].isString()) {
+            bool ok = false;
+            float audibilityRadius = audioEnvGroupObject[AUDIBILITY_RADIUS].toString().toFloat(&ok);
+            if (ok && audibilityRadius >= 0.0f) {
+                _audibilityRadius = audibilityRadius;
+                qCDebug(audio) << "Audibility radius changed to" << _audibilityRadius;
+            }
+        }
+
         const QString NOISE_MUTING_THRESHOLD = "noise_muting_threshold";
         if (audioEnvGroupObject[NOISE_MUTING_THRESHOLD].isString()) {
             bool ok = false;
@@ -21,6 +21,7 @@
 #include <plugins/Forward.h>
 
 #include "AudioMixerStats.h"
+#include "AudioMixerIngestPool.h"
 #include "AudioMixerSlavePool.h"
 
 class PositionalAudioStream;
@@ -53,6 +54,7 @@ public:
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
     static float getAttenuationPerDoublingInDistance() { return _attenuationPerDoublingInDistance; }
+    static float getAudibilityRadius() { return _audibilityRadius; }
     static const std::vector<ZoneDescription>& getAudioZones() { return _audioZones; }
     static const std::vector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const std::vector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
@@ -77,7 +79,6 @@ private slots:
     void handleNodeKilled(SharedNodePointer killedNode);
     void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
 
-    void queueAudioPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> packet);
     void removeHRTFsForFinishedInjector(const QUuid& streamID);
     void start();
@@ -100,12 +101,12 @@ private:
     float _trailingMixRatio { 0.0f };
     float _throttlingRatio { 0.0f };
 
-    int _numSilentPackets { 0 };
-
     int _numStatFrames { 0 };
     AudioMixerStats _stats;
 
     AudioMixerSlavePool _slavePool { _workerSharedData };
+    AudioMixerIngestPool _ingestPool { _workerSharedData.addedStreams,
+                                       [this](Node* node) { return getOrCreateClientData(node); } };
 
     class Timer {
     public:
@@ -137,10 +138,12 @@ private:
     Timer _mixTiming;
     Timer _eventsTiming;
     Timer _packetsTiming;
+    Timer _ingestPauseTiming;
 
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
     static float _noiseMutingThreshold;
     static float _attenuationPerDoublingInDistance;
+    static float _audibilityRadius; // 0 disables spatial culling
     static std::map<QString, CodecPluginPointer> _availableCodecs;
     static QStringList _codecPreferenceOrder;
 
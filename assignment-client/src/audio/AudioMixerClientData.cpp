@@ -51,75 +51,87 @@ AudioMixerClientData::~AudioMixerClientData() {
 }
 
 void AudioMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+    std::lock_guard<std::mutex> lock(_packetQueueMutex);
     if (!_packetQueue.node) {
         _packetQueue.node = node;
     }
     _packetQueue.push(message);
 }
 
-int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
-    SharedNodePointer node = _packetQueue.node;
-    assert(_packetQueue.empty() || node);
-    _packetQueue.node.clear();
-
-    while (!_packetQueue.empty()) {
-        auto& packet = _packetQueue.front();
-
-        switch (packet->getType()) {
-            case PacketType::MicrophoneAudioNoEcho:
-            case PacketType::MicrophoneAudioWithEcho:
-            case PacketType::InjectAudio:
-            case PacketType::SilentAudioFrame: {
-                if (node->isUpstream()) {
-                    setupCodecForReplicatedAgent(packet);
-                }
-
-                processStreamPacket(*packet, addedStreams);
+void AudioMixerClientData::processQueuedPackets(ConcurrentAddedStreams& addedStreams) {
+    // take the queued packets so that more can be queued while we process these
+    PacketQueue packetQueue;
+    {
+        std::lock_guard<std::mutex> lock(_packetQueueMutex);
+        std::swap(packetQueue, _packetQueue);
+    }
 
-                optionallyReplicatePacket(*packet, *node);
-                break;
-            }
-            case PacketType::AudioStreamStats: {
-                parseData(*packet);
-                break;
-            }
-            case PacketType::NegotiateAudioFormat:
-                negotiateAudioFormat(*packet, node);
-                break;
-            case PacketType::RequestsDomainListData:
-                parseRequestsDomainListData(*packet);
-                break;
-            case PacketType::PerAvatarGainSet:
-                parsePerAvatarGainSet(*packet, node);
-                break;
-            case PacketType::InjectorGainSet:
-                parseInjectorGainSet(*packet, node);
-                break;
-            case PacketType::NodeIgnoreRequest:
-                parseNodeIgnoreRequest(packet, node);
-                break;
-            case PacketType::RadiusIgnoreRequest:
-                parseRadiusIgnoreRequest(packet, node);
-                break;
-            case PacketType::AudioSoloRequest:
-                parseSoloRequest(packet, node);
-                break;
-            case PacketType::StopInjector:
-                parseStopInjectorPacket(packet);
-                break;
-            default:
-                Q_UNREACHABLE();
-        }
+    SharedNodePointer node = packetQueue.node;
+    assert(packetQueue.empty() || node);
 
-        _packetQueue.pop();
+    while (!packetQueue.empty()) {
+        processPacket(packetQueue.front(), node, addedStreams);
+        packetQueue.pop();
     }
-    assert(_packetQueue.empty());
+}
+
+int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
+    processQueuedPackets(addedStreams);
 
     // now that we have processed all packets for this frame
     // we can prepare the sources from this client to be ready for mixing
     return checkBuffersBeforeFrameSend();
 }
 
+void AudioMixerClientData::processPacket(const QSharedPointer<ReceivedMessage>& packet, const SharedNodePointer& node,
+                                         ConcurrentAddedStreams& addedStreams) {
+    switch (packet->getType()) {
+        case PacketType::MicrophoneAudioNoEcho:
+        case PacketType::MicrophoneAudioWithEcho:
+        case PacketType::InjectAudio:
+        case PacketType::SilentAudioFrame: {
+            if (node->isUpstream()) {
+                setupCodecForReplicatedAgent(packet);
+            }
+
+            processStreamPacket(*packet, addedStreams);
+
+            optionallyReplicatePacket(*packet, *node);
+            break;
+        }
+        case PacketType::AudioStreamStats: {
+            parseData(*packet);
+            break;
+        }
+        case PacketType::NegotiateAudioFormat:
+            negotiateAudioFormat(*packet, node);
+            break;
+        case PacketType::RequestsDomainListData:
+            parseRequestsDomainListData(*packet);
+            break;
+        case PacketType::PerAvatarGainSet:
+            parsePerAvatarGainSet(*packet, node);
+            break;
+        case PacketType::InjectorGainSet:
+            parseInjectorGainSet(*packet, node);
+            break;
+        case PacketType::NodeIgnoreRequest:
+            parseNodeIgnoreRequest(packet, node);
+            break;
+        case PacketType::RadiusIgnoreRequest:
+            parseRadiusIgnoreRequest(packet, node);
+            break;
+        case PacketType::AudioSoloRequest:
+            parseSoloRequest(packet, node);
+            break;
+        case PacketType::StopInjector:
+            parseStopInjectorPacket(packet);
+            break;
+        default:
+            Q_UNREACHABLE();
+    }
+}
+
 bool isReplicatedPacket(PacketType packetType) {
     return packetType == PacketType::ReplicatedMicrophoneAudioNoEcho
         || packetType == PacketType::ReplicatedMicrophoneAudioWithEcho
@@ -12,7 +12,9 @@
 #ifndef hifi_AudioMixerClientData_h
 #define hifi_AudioMixerClientData_h
 
+#include <mutex>
 #include <queue>
+#include <unordered_map>
 
 #include <tbb/concurrent_vector.h>
 
@@ -28,6 +30,7 @@
 
 #include "PositionalAudioStream.h"
 #include "AvatarAudioStream.h"
+#include "AudioMixerHRTFCache.h"
 
 class AudioMixerClientData : public NodeData {
     Q_OBJECT
@@ -49,7 +52,13 @@ public:
     using SharedStreamPointer = std::shared_ptr<PositionalAudioStream>;
     using AudioStreamVector = std::vector<SharedStreamPointer>;
 
+    // thread-safe, called from the thread that receives packets
     void queuePacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer node);
+
+    // process the packets queued so far, called either by an ingest thread as packets arrive or from processPackets
+    void processQueuedPackets(ConcurrentAddedStreams& addedStreams);
+
+    // process any remaining queued packets and pop a frame from each stream
     int processPackets(ConcurrentAddedStreams& addedStreams); // returns the number of available streams this frame
 
     AudioStreamVector& getAudioStreams() { return _audioStreams; }
@@ -120,6 +129,8 @@ public:
         PositionalAudioStream* positionalStream;
         bool ignoredByListener { false };
         bool ignoringListener { false };
+        bool usingSharedHRTF { false };
+        AudioMixerHRTFCache::Bucket sharedHRTFBucket;
 
         MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream) :
             nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
@@ -132,6 +143,9 @@ public:
         MixableStreamsVector active;
         MixableStreamsVector inactive;
         MixableStreamsVector skipped;
+
+        // streams beyond the audibility radius, only revisited when the spatial grid finds them in range
+        std::unordered_map<PositionalAudioStream*, MixableStream> culled;
     };
 
     Streams& getStreams() { return _streams; }
@@ -172,7 +186,11 @@ private:
     struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
         QWeakPointer<Node> node;
     };
-    PacketQueue _packetQueue;
+    std::mutex _packetQueueMutex;
+    PacketQueue _packetQueue; // guarded by _packetQueueMutex
+
+    void processPacket(const QSharedPointer<ReceivedMessage>& packet, const SharedNodePointer& node,
+                       ConcurrentAddedStreams& addedStreams);
 
     AudioStreamVector _audioStreams; // microphone stream from avatar has a null stream ID
 
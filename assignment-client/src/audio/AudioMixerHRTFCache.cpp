@@ -0,0 +1,143 @@
+//
+//  AudioMixerHRTFCache.cpp
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerHRTFCache.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <AudioHelpers.h>
+#include <NumericalConstants.h>
+
+static const int HRTF_DATASET_INDEX = 1;
+static const float DB_PER_LOG2 = 6.02059991f;       // 20 * log10(2)
+static const float MIN_CACHED_GAIN = 1.0e-5f;       // -100dB
+static const int DISTANCE_STEPS_PER_OCTAVE = 4;
+static const unsigned int MAX_IDLE_FRAMES = 10;      // 100ms
+
+size_t AudioMixerHRTFCache::KeyHashCompare::hash(const Key& key) {
+    size_t hash = qHash(key.streamID);
+    hash = hash * 31 + key.nodeLocalID;
+    hash = hash * 31 + (size_t)key.azimuth;
+    hash = hash * 31 + (size_t)key.gain;
+    hash = hash * 31 + (size_t)key.distance;
+    return hash;
+}
+
+bool AudioMixerHRTFCache::mix(const NodeIDStreamID& streamID, AudioRingBuffer::ConstIterator input, float* output,
+                              float azimuth, float distance, float gain, unsigned int frame,
+                              Bucket& bucket, const AudioHRTF* listenerHRTF) {
+    // quantize the parameters, the bucket renders with the quantized values so every listener hears the same thing
+    float azimuthStep = std::max(_settings.azimuthStep, 0.1f) * (PI / 180.0f);
+    float gainStep = std::max(_settings.gainStep, 0.01f);
+
+    int azimuthBucket = (int)std::lround(azimuth / azimuthStep);
+    int gainBucket = (int)std::lround(fastLog2f(std::max(gain, MIN_CACHED_GAIN)) * DB_PER_LOG2 / gainStep);
+    int distanceBucket = (int)std::lround(fastLog2f(distance) * DISTANCE_STEPS_PER_OCTAVE);
+
+    Key key { streamID.nodeLocalID, streamID.streamID, azimuthBucket, gainBucket, distanceBucket };
+
+    // a bucket without filter history continues from this listener's previous render, which is copied out before the
+    // bucket is locked: holding two buckets at once could deadlock with a listener moving the other way
+    AudioHRTF seed;
+    bool hasSeed = false;
+    {
+        Entries::const_accessor existing;
+        if (!_entries.find(existing, key) || !hasHistory(existing->second, frame)) {
+            existing.release();
+            if (listenerHRTF) {
+                seed.copyState(*listenerHRTF);
+                hasSeed = true;
+            } else {
+                hasSeed = copyState(streamID, bucket, seed, frame);
+            }
+        }
+    }
+    bucket = { azimuthBucket, gainBucket, distanceBucket };
+
+    // the accessor holds the bucket exclusively, other listeners of this bucket wait for the render to finish
+    Entries::accessor entry;
+    bool isNew = _entries.insert(entry, key);
+
+    bool reused = (!isNew && entry->second.frame == frame);
+    if (!reused) {
+        if (isNew) {
+            entry->second.hrtf.reset(new AudioHRTF);
+            entry->second.previousState.reset(new AudioHRTF);
+            entry->second.samples.reset(new float[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO]);
+        }
+
+        if (isNew || !hasHistory(entry->second, frame)) {
+            // the bucket is new or was idle, its own filter history is missing or stale
+            if (hasSeed) {
+                entry->second.hrtf->copyState(seed);
+            } else {
+                entry->second.hrtf->reset();
+            }
+        }
+
+        // listeners leaving this bucket later in this frame continue from the state before this render
+        entry->second.previousState->copyState(*entry->second.hrtf);
+
+        float quantizedAzimuth = azimuthBucket * azimuthStep;
+        float quantizedGain = (gain > 0.0f) ? fastExp2f(gainBucket * gainStep / DB_PER_LOG2) : 0.0f;
+        float quantizedDistance = fastExp2f((float)distanceBucket / DISTANCE_STEPS_PER_OCTAVE);
+
+        int16_t inputSamples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+        input.readSamples(inputSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+        float* samples = entry->second.samples.get();
+        memset(samples, 0, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO * sizeof(float));
+        entry->second.hrtf->render(inputSamples, samples, HRTF_DATASET_INDEX, quantizedAzimuth, quantizedDistance,
+                                   quantizedGain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        entry->second.frame = frame;
+    }
+
+    const float* samples = entry->second.samples.get();
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
+        output[i] += samples[i];
+    }
+
+    return reused;
+}
+
+bool AudioMixerHRTFCache::copyState(const NodeIDStreamID& streamID, const Bucket& bucket, AudioHRTF& hrtf,
+                                    unsigned int frame) const {
+    Key key { streamID.nodeLocalID, streamID.streamID, bucket.azimuth, bucket.gain, bucket.distance };
+
+    Entries::const_accessor entry;
+    if (!_entries.find(entry, key) || !hasHistory(entry->second, frame)) {
+        return false;
+    }
+
+    if (entry->second.frame == frame) {
+        // already rendered this frame, continue from where that render started
+        hrtf.copyState(*entry->second.previousState);
+    } else {
+        hrtf.copyState(*entry->second.hrtf);
+    }
+    return true;
+}
+
+void AudioMixerHRTFCache::prune(unsigned int frame) {
+    // idle buckets are kept for a few frames, so listeners returning to them reuse the allocations
+    std::vector<Key> unused;
+    for (auto& entry : _entries) {
+        if (frame - entry.second.frame > MAX_IDLE_FRAMES) {
+            unused.push_back(entry.first);
+        }
+    }
+
+    for (auto& key : unused) {
+        _entries.erase(key);
+    }
+}
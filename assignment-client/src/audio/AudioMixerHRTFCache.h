@@ -0,0 +1,100 @@
+//
+//  AudioMixerHRTFCache.h
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerHRTFCache_h
+#define hifi_AudioMixerHRTFCache_h
+
+#include <memory>
+
+#include <tbb/concurrent_hash_map.h>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <AudioRingBuffer.h>
+#include <PositionalAudioStream.h>
+
+// Shares the HRTF render of a far-field source between the listeners that hear it with (nearly) the same parameters.
+// Azimuth, gain and distance are quantized into buckets; the first listener to need a bucket in a frame renders it,
+// and every other listener in that bucket accumulates the same output. A bucket without filter history continues from
+// the previous render of the listener that starts it, so moving between buckets crossfades instead of clicking.
+class AudioMixerHRTFCache {
+public:
+    struct Settings {
+        bool enabled { false };
+        float minDistance { 8.0f };         // meters, closer sources are always rendered per listener
+        float azimuthStep { 5.0f };         // degrees
+        float gainStep { 1.0f };            // dB
+    };
+
+    void setSettings(const Settings& settings) { _settings = settings; }
+    const Settings& getSettings() const { return _settings; }
+
+    bool shouldCache(float distance) const { return _settings.enabled && distance >= _settings.minDistance; }
+
+    // the quantized parameters of a listener's last shared render of a stream
+    struct Bucket {
+        int azimuth { 0 };
+        int gain { 0 };
+        int distance { 0 };
+    };
+
+    // accumulates the shared render of this stream into output (interleaved stereo), rendering it if this is the first
+    // use of the bucket in this frame; returns true if an existing render was reused.
+    // bucket is updated to the bucket used. If that bucket has no filter history it continues from listenerHRTF when
+    // given (the listener rendered the stream itself last), otherwise from the listener's previous bucket.
+    bool mix(const NodeIDStreamID& streamID, AudioRingBuffer::ConstIterator input, float* output,
+             float azimuth, float distance, float gain, unsigned int frame,
+             Bucket& bucket, const AudioHRTF* listenerHRTF);
+
+    // copies the filter history a listener's render from this bucket would continue from into hrtf;
+    // returns false if the bucket has none (it was dropped or idle)
+    bool copyState(const NodeIDStreamID& streamID, const Bucket& bucket, AudioHRTF& hrtf, unsigned int frame) const;
+
+    // drops the buckets that have been idle for a while (must not run concurrently with mix)
+    void prune(unsigned int frame);
+
+    size_t size() const { return _entries.size(); }
+
+private:
+    struct Key {
+        Node::LocalID nodeLocalID;
+        StreamID streamID;
+        int azimuth;
+        int gain;
+        int distance;
+
+        bool operator==(const Key& other) const {
+            return nodeLocalID == other.nodeLocalID && streamID == other.streamID && azimuth == other.azimuth &&
+                gain == other.gain && distance == other.distance;
+        }
+    };
+
+    struct KeyHashCompare {
+        static size_t hash(const Key& key);
+        static bool equal(const Key& a, const Key& b) { return a == b; }
+    };
+
+    struct Entry {
+        std::unique_ptr<AudioHRTF> hrtf;
+        std::unique_ptr<AudioHRTF> previousState;   // state of hrtf before the render of this frame
+        std::unique_ptr<float[]> samples;
+        unsigned int frame { 0 };
+    };
+
+    using Entries = tbb::concurrent_hash_map<Key, Entry, KeyHashCompare>;
+
+    static bool hasHistory(const Entry& entry, unsigned int frame) { return frame - entry.frame <= 1; }
+
+    Settings _settings;
+    Entries _entries;
+};
+
+#endif // hifi_AudioMixerHRTFCache_h
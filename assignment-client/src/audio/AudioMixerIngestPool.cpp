@@ -0,0 +1,178 @@
+//
+//  AudioMixerIngestPool.cpp
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerIngestPool.h"
+
+#include <assert.h>
+
+#include <PortableHighResolutionClock.h>
+
+void AudioMixerIngestThread::run() {
+    while (true) {
+        SharedNodePointer node;
+        {
+            Lock lock(_mutex);
+            _workCondition.wait(lock, [&] {
+                return _stop || (!_isPaused && !_nodes.empty());
+            });
+
+            if (_stop) {
+                return;
+            }
+
+            node = std::move(_nodes.front());
+            _nodes.pop();
+            _isBusy = true;
+        }
+
+        auto start = p_high_resolution_clock::now();
+
+        AudioMixerClientData* data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (data) {
+            data->processQueuedPackets(_pool._addedStreams);
+        }
+        node.reset();
+
+        _busyUsecs += std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - start).count();
+
+        {
+            Lock lock(_mutex);
+            _isBusy = false;
+        }
+        _idleCondition.notify_all();
+    }
+}
+
+void AudioMixerIngestThread::push(SharedNodePointer node) {
+    {
+        Lock lock(_mutex);
+        _nodes.push(std::move(node));
+    }
+    ++_numPackets;
+    _workCondition.notify_one();
+}
+
+AudioMixerIngestPool::AudioMixerIngestPool(AudioMixerClientData::ConcurrentAddedStreams& addedStreams,
+                                           ClientDataOperator clientDataOperator) :
+    _addedStreams(addedStreams),
+    _clientDataOperator(clientDataOperator)
+{
+}
+
+AudioMixerIngestPool::~AudioMixerIngestPool() {
+    setNumThreads(0);
+}
+
+void AudioMixerIngestPool::queueAudioPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+    if (message->getType() == PacketType::SilentAudioFrame) {
+        ++_numSilentPackets;
+    }
+
+    queuePacket(message, node);
+}
+
+void AudioMixerIngestPool::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+    _clientDataOperator(node.data())->queuePacket(message, node);
+
+    std::lock_guard<std::mutex> lock(_threadsMutex);
+    if (!_threads.empty()) {
+        // shard by local ID so that a node's packets are always processed in order by the same thread
+        _threads[node->getLocalID() % _threads.size()]->push(node);
+    }
+}
+
+void AudioMixerIngestPool::pause() {
+    assert(!_isPaused);
+    _isPaused = true;
+
+    std::lock_guard<std::mutex> threadsLock(_threadsMutex);
+    for (auto& thread : _threads) {
+        AudioMixerIngestThread::Lock lock(thread->_mutex);
+        thread->_isPaused = true;
+        thread->_idleCondition.wait(lock, [&] { return !thread->_isBusy; });
+    }
+}
+
+void AudioMixerIngestPool::resume() {
+    assert(_isPaused);
+    _isPaused = false;
+
+    std::lock_guard<std::mutex> threadsLock(_threadsMutex);
+    for (auto& thread : _threads) {
+        {
+            AudioMixerIngestThread::Lock lock(thread->_mutex);
+            thread->_isPaused = false;
+        }
+        thread->_workCondition.notify_one();
+    }
+}
+
+std::vector<AudioMixerIngestPool::Stats> AudioMixerIngestPool::sampleStats() {
+    std::vector<Stats> stats;
+
+    std::lock_guard<std::mutex> lock(_threadsMutex);
+    stats.reserve(_threads.size());
+    for (auto& thread : _threads) {
+        Stats threadStats;
+        threadStats.packets = thread->_numPackets.exchange(0);
+        threadStats.busyUsecs = thread->_busyUsecs.exchange(0);
+        stats.push_back(threadStats);
+    }
+    return stats;
+}
+
+void AudioMixerIngestPool::setNumThreads(int numThreads) {
+    // clamp to allowed size
+    {
+        int maxThreads = QThread::idealThreadCount();
+        if (maxThreads == -1) {
+            // idealThreadCount returns -1 if cores cannot be detected
+            static const int MAX_THREADS_IF_UNKNOWN = 4;
+            maxThreads = MAX_THREADS_IF_UNKNOWN;
+        }
+
+        int clampedThreads = std::min(std::max(0, numThreads), maxThreads);
+        if (clampedThreads != numThreads) {
+            qWarning("%s: clamped to %d (was %d)", __FUNCTION__, clampedThreads, numThreads);
+            numThreads = clampedThreads;
+        }
+    }
+
+    if (numThreads == _numThreads) {
+        return;
+    }
+
+    qDebug("%s: set %d threads (was %d)", __FUNCTION__, numThreads, _numThreads);
+
+    // hold the threads lock throughout so no packet is handed to a thread that is going away, the old threads
+    // are stopped before new ones start so that a node is never processed by two threads at once
+    std::lock_guard<std::mutex> lock(_threadsMutex);
+
+    // any nodes left in the queues of the stopped threads still have their packets queued on their client data,
+    // where they are picked up by the next frame's processPackets
+    for (auto& thread : _threads) {
+        {
+            AudioMixerIngestThread::Lock threadLock(thread->_mutex);
+            thread->_stop = true;
+        }
+        thread->_workCondition.notify_one();
+        thread->wait();
+    }
+    _threads.clear();
+
+    for (int i = 0; i < numThreads; ++i) {
+        auto thread = new AudioMixerIngestThread(*this);
+        thread->_isPaused = _isPaused;
+        thread->start();
+        _threads.emplace_back(thread);
+    }
+    _numThreads = numThreads;
+}
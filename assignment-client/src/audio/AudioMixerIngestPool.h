@@ -0,0 +1,112 @@
+//
+//  AudioMixerIngestPool.h
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerIngestPool_h
+#define hifi_AudioMixerIngestPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+#include <QThread>
+
+#include <NodeList.h>
+#include <ReceivedMessage.h>
+
+#include "AudioMixerClientData.h"
+
+class AudioMixerIngestPool;
+
+// processes the packets of the nodes in one shard (Node::LocalID % numThreads) as they arrive
+class AudioMixerIngestThread : public QThread {
+    Q_OBJECT
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    using ConditionVariable = std::condition_variable;
+
+public:
+    AudioMixerIngestThread(AudioMixerIngestPool& pool) : _pool(pool) {}
+
+    void run() override final;
+
+private:
+    friend class AudioMixerIngestPool;
+
+    void push(SharedNodePointer node);
+
+    AudioMixerIngestPool& _pool;
+
+    Mutex _mutex;
+    ConditionVariable _workCondition;
+    ConditionVariable _idleCondition;
+
+    // guarded by _mutex
+    std::queue<SharedNodePointer> _nodes;
+    bool _isPaused { false };
+    bool _isBusy { false };
+    bool _stop { false };
+
+    std::atomic<uint64_t> _numPackets { 0 };
+    std::atomic<uint64_t> _busyUsecs { 0 };
+};
+
+// Ingest pool for audio mixers
+//   Receives audio packets on the networking thread and, when running with ingest threads, decodes them into
+//   their AudioMixerClientData as they arrive instead of in a burst at the start of the next frame.
+//   The mixer pauses the pool for the part of the frame that reads stream state (packet processing through mixing).
+class AudioMixerIngestPool : public QObject {
+    Q_OBJECT
+
+public:
+    using ClientDataOperator = std::function<AudioMixerClientData*(Node*)>;
+
+    AudioMixerIngestPool(AudioMixerClientData::ConcurrentAddedStreams& addedStreams, ClientDataOperator clientDataOperator);
+    ~AudioMixerIngestPool();
+
+    // 0 processes packets on the slave pool at the start of each frame
+    void setNumThreads(int numThreads);
+    int numThreads() const { return _numThreads; }
+
+    // thread-safe, queue a packet for its node and wake the thread responsible for it
+    void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
+
+    // blocks until every ingest thread is done with the packets it is processing, called from the mixer thread
+    void pause();
+    void resume();
+
+    int takeNumSilentPackets() { return _numSilentPackets.exchange(0); }
+
+    struct Stats {
+        uint64_t packets { 0 };
+        uint64_t busyUsecs { 0 };
+    };
+    std::vector<Stats> sampleStats();
+
+public slots:
+    void queueAudioPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
+
+private:
+    friend class AudioMixerIngestThread;
+
+    std::mutex _threadsMutex; // guards _threads against resizing while packets are queued
+    std::vector<std::unique_ptr<AudioMixerIngestThread>> _threads;
+    bool _isPaused { false };
+    int _numThreads { 0 };
+
+    AudioMixerClientData::ConcurrentAddedStreams& _addedStreams;
+    ClientDataOperator _clientDataOperator;
+    std::atomic<int> _numSilentPackets { 0 };
+};
+
+#endif // hifi_AudioMixerIngestPool_h
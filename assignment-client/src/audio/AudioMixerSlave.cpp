@@ -24,6 +24,7 @@
 #include <OctreeConstants.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
+#include <PortableHighResolutionClock.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <StDev.h>
@@ -97,7 +98,10 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         ++stats.sumListeners;
 
         // mix the audio
+        auto mixStart = p_high_resolution_clock::now();
         bool mixHasAudio = prepareMix(node);
+        stats.mixTime += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            p_high_resolution_clock::now() - mixStart).count();
 
         // send audio packet
         if (mixHasAudio || data->shouldFlushEncoder()) {
@@ -105,7 +109,10 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
             if (mixHasAudio) {
                 // encode the audio
                 QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+                auto encodeStart = p_high_resolution_clock::now();
                 data->encode(decodedBuffer, encodedBuffer);
+                stats.encodeTime += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    p_high_resolution_clock::now() - encodeStart).count();
             } else {
                 // time to flush (resets shouldFlush until the next encode)
                 data->encodeFrameOfZeros(encodedBuffer);
@@ -286,6 +293,70 @@ bool shouldBeSkipped(MixableStream& stream, const Node& listener,
     return false;
 };
 
+bool shouldBeCulled(const MixableStream& stream, const AvatarAudioStream& listenerAudioStream, float audibilityRadius) {
+    glm::vec3 relativePosition = stream.positionalStream->getPosition() - listenerAudioStream.getPosition();
+    return glm::length2(relativePosition) > audibilityRadius * audibilityRadius;
+};
+
+void AudioMixerSlave::cullStream(MixableStream& stream, AudioMixerClientData& listenerData) {
+    // the stream will not be rendered until it is back in range, drop its tail
+    resetHRTFState(stream);
+
+    auto positionalStream = stream.positionalStream;
+    listenerData.getStreams().culled.emplace(positionalStream, move(stream));
+    ++stats.toCulled;
+}
+
+void AudioMixerSlave::updateCulledStreams(Node& listener, AudioMixerClientData& listenerData,
+                                          const AvatarAudioStream& listenerAudioStream, float audibilityRadius) {
+    auto& streams = listenerData.getStreams();
+    if (streams.culled.empty()) {
+        return;
+    }
+
+    // culled streams are not walked every frame, drop the removed ones now
+    if (!_sharedData.removedNodes.empty() || !_sharedData.removedStreams.empty()) {
+        for (auto it = streams.culled.begin(); it != streams.culled.end();) {
+            if (shouldBeRemoved(it->second, _sharedData)) {
+                it = streams.culled.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // the staged ignore changes were not applied to culled streams, so refresh their flags from the full sets
+    auto uncull = [&](MixableStream&& stream) {
+        stream.ignoredByListener = contains(listener.getIgnoredNodeIDs(), stream.nodeStreamID.nodeID);
+        stream.ignoringListener = contains(listenerData.getIgnoringNodeIDs(), stream.nodeStreamID.nodeID);
+
+        if (stream.ignoredByListener || stream.ignoringListener) {
+            streams.skipped.push_back(move(stream));
+        } else {
+            streams.inactive.push_back(move(stream));
+        }
+        ++stats.culledToUnculled;
+    };
+
+    if (audibilityRadius <= 0.0f) {
+        // culling was turned off (or the listener is soloing), bring every stream back
+        for (auto& culled : streams.culled) {
+            uncull(move(culled.second));
+        }
+        streams.culled.clear();
+        return;
+    }
+
+    _sharedData.streamGrid.query(listenerAudioStream.getPosition(), audibilityRadius,
+                                 [&](const AudioSpatialGrid<PositionalAudioStream*>::Entry& entry) {
+        auto it = streams.culled.find(entry.value);
+        if (it != streams.culled.end()) {
+            uncull(move(it->second));
+            streams.culled.erase(it);
+        }
+    });
+}
+
 float approximateVolume(const MixableStream& stream, const AvatarAudioStream* listenerAudioStream) {
     if (stream.positionalStream->getLastPopOutputTrailingLoudness() == 0.0f) {
         return 0.0f;
@@ -320,12 +391,23 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
     addStreams(*listener, *listenerData);
 
+    // only consider the streams within audible range, soloed streams are heard at any distance
+    float audibilityRadius = isSoloing ? 0.0f : AudioMixer::getAudibilityRadius();
+    bool isCulling = audibilityRadius > 0.0f;
+
+    updateCulledStreams(*listener, *listenerData, *listenerAudioStream, audibilityRadius);
+
     // Process skipped streams
     erase_if(streams.skipped, [&](MixableStream& stream) {
         if (shouldBeRemoved(stream, _sharedData)) {
             return true;
         }
 
+        if (isCulling && shouldBeCulled(stream, *listenerAudioStream, audibilityRadius)) {
+            cullStream(stream, *listenerData);
+            return true;
+        }
+
         if (!shouldBeSkipped(stream, *listener, *listenerAudioStream, *listenerData)) {
             if (shouldBeInactive(stream)) {
                 streams.inactive.push_back(move(stream));
@@ -350,6 +432,11 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             return true;
         }
 
+        if (isCulling && shouldBeCulled(stream, *listenerAudioStream, audibilityRadius)) {
+            cullStream(stream, *listenerData);
+            return true;
+        }
+
         if (shouldBeSkipped(stream, *listener, *listenerAudioStream, *listenerData)) {
             streams.skipped.push_back(move(stream));
             ++stats.inactiveToSkipped;
@@ -375,6 +462,11 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             return true;
         }
 
+        if (isCulling && shouldBeCulled(stream, *listenerAudioStream, audibilityRadius)) {
+            cullStream(stream, *listenerData);
+            return true;
+        }
+
         if (isThrottling) {
             // we're throttling, so we need to update the approximate volume for any un-skipped streams
             // unless this is simply for an echo (in which case the approx volume is 1.0)
@@ -463,16 +555,11 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     stats.skipped += (int)streams.skipped.size();
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
+    stats.culled += (int)streams.culled.size();
 
     // clear the newly ignored, un-ignored, ignoring, and un-ignoring streams now that we've processed them
     listenerData->clearStagedIgnoreChanges();
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
-    auto mixEnd = p_high_resolution_clock::now();
-    auto mixTime = std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - mixStart);
-    stats.mixTime += mixTime.count();
-#endif
-
     // check for silent audio before limiting
     // limiting uses a dither and can only guarantee abs(sample) <= 1
     bool hasAudio = false;
@@ -535,6 +622,11 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
             // call renderSilent with a forced silent block to reduce artifacts
             // (this is not done for stereo streams since they do not go through the HRTF)
             if (!streamToAdd->isStereo() && !isEcho) {
+                if (mixableStream.usingSharedHRTF) {
+                    // the tail to flush is in the shared render
+                    releaseSharedHRTF(mixableStream);
+                }
+
                 static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
                 mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                                            AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
@@ -565,8 +657,25 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
         mixableStream.hrtf->mixMono(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualEchoMixes;
+    } else if (!isSoloing && _sharedData.hrtfCache.shouldCache(distance)) {
+
+        // far-field source: share the render with the other listeners in the same bucket
+        const AudioHRTF* listenerHRTF = mixableStream.usingSharedHRTF ? nullptr : mixableStream.hrtf.get();
+        if (_sharedData.hrtfCache.mix(mixableStream.nodeStreamID, streamPopOutput, _mixSamples,
+                                      azimuth, distance, gain, _frame, mixableStream.sharedHRTFBucket, listenerHRTF)) {
+            ++stats.hrtfCacheHits;
+        } else {
+            ++stats.hrtfCacheMisses;
+            ++stats.hrtfRenders;
+        }
+
+        mixableStream.usingSharedHRTF = true;
     } else {
 
+        if (mixableStream.usingSharedHRTF) {
+            releaseSharedHRTF(mixableStream);
+        }
+
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
@@ -598,9 +707,20 @@ void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream&
 
 void AudioMixerSlave::resetHRTFState(AudioMixerClientData::MixableStream& mixableStream) {
      mixableStream.hrtf->reset();
+    mixableStream.usingSharedHRTF = false;
     ++stats.hrtfResets;
 }
 
+void AudioMixerSlave::releaseSharedHRTF(AudioMixerClientData::MixableStream& mixableStream) {
+    // the per-listener filter history went stale while the shared render was in use, continue from the shared one
+    if (_sharedData.hrtfCache.copyState(mixableStream.nodeStreamID, mixableStream.sharedHRTFBucket,
+                                        *mixableStream.hrtf, _frame)) {
+        mixableStream.usingSharedHRTF = false;
+    } else {
+        resetHRTFState(mixableStream);
+    }
+}
+
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
     auto audioPacket = NLPacket::create(type, size);
     audioPacket->writePrimitive(sequence);
@@ -17,12 +17,14 @@
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
+#include <AudioSpatialGrid.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 #include <NodeList.h>
 #include <PositionalAudioStream.h>
 
 #include "AudioMixerClientData.h"
+#include "AudioMixerHRTFCache.h"
 #include "AudioMixerStats.h"
 
 class AvatarAudioStream;
@@ -36,6 +38,8 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioMixerHRTFCache hrtfCache;
+        AudioSpatialGrid<PositionalAudioStream*> streamGrid;
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -65,8 +69,12 @@ private:
                               float masterAvatarGain,
                               float masterInjectorGain);
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
+    void releaseSharedHRTF(AudioMixerClientData::MixableStream& mixableStream);
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
+    void updateCulledStreams(Node& listener, AudioMixerClientData& listenerData,
+                             const AvatarAudioStream& listenerAudioStream, float audibilityRadius);
+    void cullStream(AudioMixerClientData::MixableStream& stream, AudioMixerClientData& listenerData);
 
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
@@ -14,16 +14,22 @@
 #include <assert.h>
 #include <algorithm>
 
+#include <PortableHighResolutionClock.h>
+
 void AudioMixerSlaveThread::run() {
     while (true) {
         wait();
 
+        auto start = p_high_resolution_clock::now();
+
         // iterate over all available nodes
         SharedNodePointer node;
         while (try_pop(node)) {
             (this->*_function)(node);
         }
 
+        _busyUsecs = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - start).count();
+
         bool stopping = _stop;
         notify(stopping);
         if (stopping) {
@@ -46,6 +52,9 @@ void AudioMixerSlaveThread::wait() {
         _pool._configure(*this);
     }
     _function = _pool._function;
+
+    _next = _end = 0;
+    _numChunks = _numSteals = 0;
 }
 
 void AudioMixerSlaveThread::notify(bool stopping) {
@@ -61,7 +70,20 @@ void AudioMixerSlaveThread::notify(bool stopping) {
 }
 
 bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+    if (_next == _end) {
+        bool stolen;
+        if (!_pool._queue.pop(_index, _next, _end, stolen)) {
+            return false;
+        }
+
+        ++_numChunks;
+        if (stolen) {
+            ++_numSteals;
+        }
+    }
+
+    node = _pool._nodes[_next++];
+    return true;
 }
 
 void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
@@ -83,10 +105,11 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
-    });
+    // split the nodes between the slaves, who steal from each other once they run out
+    _nodes.assign(_begin, _end);
+    _queue.reset(_nodes.size(), _numThreads);
+
+    auto start = p_high_resolution_clock::now();
 
     {
         Lock lock(_mutex);
@@ -104,7 +127,27 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
         assert(_numStarted == _numThreads);
     }
 
-    assert(_queue.empty());
+    uint64_t elapsedUsecs =
+        std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - start).count();
+
+    _stats.resize(_slaves.size());
+    for (size_t i = 0; i < _slaves.size(); ++i) {
+        auto& slave = *_slaves[i];
+        auto& stats = _stats[i];
+        stats.busyUsecs += slave._busyUsecs;
+        stats.idleUsecs += elapsedUsecs - std::min(slave._busyUsecs, elapsedUsecs);
+        stats.chunks += slave._numChunks;
+        stats.steals += slave._numSteals;
+    }
+
+    // release the nodes until the next run
+    _nodes.clear();
+}
+
+std::vector<AudioMixerSlavePool::Stats> AudioMixerSlavePool::sampleStats() {
+    std::vector<Stats> stats(_slaves.size());
+    std::swap(stats, _stats);
+    return stats;
 }
 
 void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> functor) {
@@ -157,6 +200,7 @@ void AudioMixerSlavePool::resize(int numThreads) {
         // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
             auto slave = new AudioMixerSlaveThread(*this, _workerSharedData);
+            slave->_index = (int)_slaves.size();
             slave->start();
             _slaves.emplace_back(slave);
         }
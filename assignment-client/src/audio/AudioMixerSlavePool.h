@@ -18,7 +18,7 @@
 
 #include <QThread>
 #include <shared/QtHelpers.h>
-#include <TBBHelpers.h>
+#include <WorkStealingQueue.h>
 
 #include "AudioMixerSlave.h"
 
@@ -46,12 +46,21 @@ private:
     AudioMixerSlavePool& _pool;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
     bool _stop { false };
+
+    // work-stealing state, owned by this thread while the pool runs
+    int _index { 0 };
+    size_t _next { 0 };
+    size_t _end { 0 };
+
+    // timing of the last run, read by the pool once every thread has finished
+    uint64_t _busyUsecs { 0 };
+    uint32_t _numChunks { 0 };
+    uint32_t _numSteals { 0 };
 };
 
 // Slave pool for audio mixers
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -76,6 +85,15 @@ public:
     void queueStats(QJsonObject& stats);
 #endif
 
+    // per-thread scheduling stats, accumulated over every run since the last sample
+    struct Stats {
+        uint64_t busyUsecs { 0 };   // running jobs
+        uint64_t idleUsecs { 0 };   // waiting for the other threads to finish
+        uint64_t chunks { 0 };
+        uint64_t steals { 0 };
+    };
+    std::vector<Stats> sampleStats();
+
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
@@ -101,7 +119,9 @@ private:
     int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
+    std::vector<SharedNodePointer> _nodes;
+    WorkStealingQueue _queue;
+    std::vector<Stats> _stats;
     ConstIter _begin;
     ConstIter _end;
 
@@ -21,6 +21,8 @@ void AudioMixerStats::reset() {
     hrtfRenders = 0;
     hrtfResets = 0;
     hrtfUpdates = 0;
+    hrtfCacheHits = 0;
+    hrtfCacheMisses = 0;
 
     manualStereoMixes = 0;
     manualEchoMixes = 0;
@@ -31,14 +33,16 @@ void AudioMixerStats::reset() {
     inactiveToActive = 0;
     activeToSkipped = 0;
     activeToInactive = 0;
+    toCulled = 0;
+    culledToUnculled = 0;
 
     skipped = 0;
     inactive = 0;
     active = 0;
+    culled = 0;
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
-#endif
+    encodeTime = 0;
 }
 
 void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
@@ -51,6 +55,8 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     hrtfRenders += otherStats.hrtfRenders;
     hrtfResets += otherStats.hrtfResets;
     hrtfUpdates += otherStats.hrtfUpdates;
+    hrtfCacheHits += otherStats.hrtfCacheHits;
+    hrtfCacheMisses += otherStats.hrtfCacheMisses;
 
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
@@ -61,12 +67,14 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     inactiveToActive += otherStats.inactiveToActive;
     activeToSkipped += otherStats.activeToSkipped;
     activeToInactive += otherStats.activeToInactive;
+    toCulled += otherStats.toCulled;
+    culledToUnculled += otherStats.culledToUnculled;
 
     skipped += otherStats.skipped;
     inactive += otherStats.inactive;
     active += otherStats.active;
+    culled += otherStats.culled;
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
-#endif
+    encodeTime += otherStats.encodeTime;
 }
@@ -12,9 +12,7 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
 #include <cstdint>
-#endif
 
 struct AudioMixerStats {
     int sumStreams { 0 };
@@ -26,6 +24,8 @@ struct AudioMixerStats {
     int hrtfRenders { 0 };
     int hrtfResets { 0 };
     int hrtfUpdates { 0 };
+    int hrtfCacheHits { 0 };
+    int hrtfCacheMisses { 0 };
 
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
@@ -36,14 +36,16 @@ struct AudioMixerStats {
     int inactiveToActive { 0 };
     int activeToSkipped { 0 };
     int activeToInactive { 0 };
+    int toCulled { 0 };
+    int culledToUnculled { 0 };
 
     int skipped { 0 };
     int inactive { 0 };
     int active { 0 };
+    int culled { 0 };
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
-    uint64_t mixTime { 0 };
-#endif
+    uint64_t mixTime { 0 }; // ns
+    uint64_t encodeTime { 0 }; // ns
 
     void reset();
     void accumulate(const AudioMixerStats& otherStats);
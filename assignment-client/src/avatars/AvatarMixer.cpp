@@ -71,7 +71,7 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &AvatarMixer::handleAvatarKilled);
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListener(PacketType::AvatarData, this, "queueIncomingPacket");
+    packetReceiver.registerHandler(PacketType::AvatarData, this, &AvatarMixer::queueIncomingPacket);
     packetReceiver.registerListener(PacketType::AdjustAvatarSorting, this, "handleAdjustAvatarSorting");
     packetReceiver.registerListener(PacketType::AvatarQuery, this, "handleAvatarQueryPacket");
     packetReceiver.registerListener(PacketType::AvatarIdentity, this, "handleAvatarIdentityPacket");
@@ -79,11 +79,11 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     packetReceiver.registerListener(PacketType::NodeIgnoreRequest, this, "handleNodeIgnoreRequestPacket");
     packetReceiver.registerListener(PacketType::RadiusIgnoreRequest, this, "handleRadiusIgnoreRequestPacket");
     packetReceiver.registerListener(PacketType::RequestsDomainListData, this, "handleRequestsDomainListDataPacket");
-    packetReceiver.registerListener(PacketType::SetAvatarTraits, this, "queueIncomingPacket");
-    packetReceiver.registerListener(PacketType::BulkAvatarTraitsAck, this, "queueIncomingPacket");
+    packetReceiver.registerHandler(PacketType::SetAvatarTraits, this, &AvatarMixer::queueIncomingPacket);
+    packetReceiver.registerHandler(PacketType::BulkAvatarTraitsAck, this, &AvatarMixer::queueIncomingPacket);
     packetReceiver.registerListenerForTypes({ PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase },
         this, "handleOctreePacket");
-    packetReceiver.registerListener(PacketType::ChallengeOwnership, this, "queueIncomingPacket");
+    packetReceiver.registerHandler(PacketType::ChallengeOwnership, this, &AvatarMixer::queueIncomingPacket);
 
     packetReceiver.registerListenerForTypes({
         PacketType::ReplicatedAvatarIdentity,
@@ -253,7 +253,7 @@ void AvatarMixer::start() {
         auto frameDuration = timeFrame(frameTimestamp); // calculates last frame duration and sleeps remainder of target amount
         throttle(frameDuration, frame); // determines _throttlingRatio for upcoming mix frame
 
-        int lockWait, nodeTransform, functor;
+        int functor;
 
         // Set our query each frame
         {
@@ -283,16 +283,11 @@ void AvatarMixer::start() {
             auto start = usecTimestampNow();
 
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
-                auto end = usecTimestampNow();
-                _processQueuedAvatarDataPacketsLockWaitElapsedTime += (end - start);
-
                 _slavePool.processIncomingPackets(cbegin, cend);
-            }, &lockWait, &nodeTransform, &functor);
+            }, &functor);
             auto end = usecTimestampNow();
             _processQueuedAvatarDataPacketsElapsedTime += (end - start);
 
-            _broadcastAvatarDataLockWait += lockWait;
-            _broadcastAvatarDataNodeTransform += nodeTransform;
             _broadcastAvatarDataNodeFunctor += functor;
         }
 
@@ -308,12 +303,10 @@ void AvatarMixer::start() {
 
                     ++_sumListeners;
                 });
-            }, &lockWait, &nodeTransform, &functor);
+            }, &functor);
             auto end = usecTimestampNow();
             _displayNameManagementElapsedTime += (end - start);
 
-            _broadcastAvatarDataLockWait += lockWait;
-            _broadcastAvatarDataNodeTransform += nodeTransform;
             _broadcastAvatarDataNodeFunctor += functor;
         }
 
@@ -325,12 +318,10 @@ void AvatarMixer::start() {
                 _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
-            }, &lockWait, &nodeTransform, &functor);
+            }, &functor);
             auto end = usecTimestampNow();
             _broadcastAvatarDataElapsedTime += (end - start);
 
-            _broadcastAvatarDataLockWait += lockWait;
-            _broadcastAvatarDataNodeTransform += nodeTransform;
             _broadcastAvatarDataNodeFunctor += functor;
         }
 
@@ -792,15 +783,12 @@ void AvatarMixer::sendStatsPacket() {
 
     QJsonObject processQueuedAvatarDataPacketsStats;
     processQueuedAvatarDataPacketsStats["1_total"] = TIGHT_LOOP_STAT_UINT64(_processQueuedAvatarDataPacketsElapsedTime);
-    processQueuedAvatarDataPacketsStats["2_lockWait"] = TIGHT_LOOP_STAT_UINT64(_processQueuedAvatarDataPacketsLockWaitElapsedTime);
     parallelTasks["processQueuedAvatarDataPackets"] = processQueuedAvatarDataPacketsStats;
 
     QJsonObject broadcastAvatarDataStats;
 
     broadcastAvatarDataStats["1_total"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataElapsedTime);
     broadcastAvatarDataStats["2_innner"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataInner);
-    broadcastAvatarDataStats["3_lockWait"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataLockWait);
-    broadcastAvatarDataStats["4_NodeTransform"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataNodeTransform);
     broadcastAvatarDataStats["5_Functor"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataNodeFunctor);
 
     parallelTasks["broadcastAvatarData"] = broadcastAvatarDataStats;
@@ -838,6 +826,8 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["sent_5_averageTraitsBytes"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsBytesSent);
     slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
+    slavesAggregatObject["sent_8_averagePrioritiesRescored"] = TIGHT_LOOP_STAT(aggregateStats.numPrioritiesRescored);
+    slavesAggregatObject["sent_9_averageSharedEncodings"] = TIGHT_LOOP_STAT(aggregateStats.numSharedEncodings);
 
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
@@ -848,6 +838,18 @@ void AvatarMixer::sendStatsPacket() {
 
     statsObject["slaves_aggregate (per frame)"] = slavesAggregatObject;
 
+    QJsonObject slaveThreadsObject;
+    auto slaveThreadStats = _slavePool.sampleStats();
+    for (size_t i = 0; i < slaveThreadStats.size(); ++i) {
+        QJsonObject threadStats;
+        threadStats["timing_1_busy"] = TIGHT_LOOP_STAT_UINT64(slaveThreadStats[i].busyUsecs);
+        threadStats["timing_2_idle"] = TIGHT_LOOP_STAT_UINT64(slaveThreadStats[i].idleUsecs);
+        threadStats["chunks"] = TIGHT_LOOP_STAT_UINT64(slaveThreadStats[i].chunks);
+        threadStats["steals"] = TIGHT_LOOP_STAT_UINT64(slaveThreadStats[i].steals);
+        slaveThreadsObject[QString("thread_%1").arg(i)] = threadStats;
+    }
+    statsObject["slave_threads (per frame)"] = slaveThreadsObject;
+
     _handleViewFrustumPacketElapsedTime = 0;
     _handleAvatarIdentityPacketElapsedTime = 0;
     _handleKillAvatarPacketElapsedTime = 0;
@@ -857,7 +859,6 @@ void AvatarMixer::sendStatsPacket() {
     _processEventsElapsedTime = 0;
     _queueIncomingPacketElapsedTime = 0;
     _processQueuedAvatarDataPacketsElapsedTime = 0;
-    _processQueuedAvatarDataPacketsLockWaitElapsedTime = 0;
 
     QJsonObject avatarsObject;
     auto nodeList = DependencyManager::get<NodeList>();
@@ -906,8 +907,6 @@ void AvatarMixer::sendStatsPacket() {
 
     _broadcastAvatarDataElapsedTime = 0;
     _broadcastAvatarDataInner = 0;
-    _broadcastAvatarDataLockWait = 0;
-    _broadcastAvatarDataNodeTransform = 0;
     _broadcastAvatarDataNodeFunctor = 0;
 
     _displayNameManagementElapsedTime = 0;
@@ -129,8 +129,6 @@ private:
 
     quint64 _broadcastAvatarDataElapsedTime { 0 }; // total time spent in broadcastAvatarData since last stats window
     quint64 _broadcastAvatarDataInner { 0 };
-    quint64 _broadcastAvatarDataLockWait { 0 };
-    quint64 _broadcastAvatarDataNodeTransform { 0 };
     quint64 _broadcastAvatarDataNodeFunctor { 0 };
 
     quint64 _handleAdjustAvatarSortingElapsedTime { 0 };
@@ -141,7 +139,6 @@ private:
     quint64 _handleRadiusIgnoreRequestPacketElapsedTime { 0 };
     quint64 _handleRequestsDomainListDataPacketElapsedTime { 0 };
     quint64 _processQueuedAvatarDataPacketsElapsedTime { 0 };
-    quint64 _processQueuedAvatarDataPacketsLockWaitElapsedTime { 0 };
 
     quint64 _processEventsElapsedTime { 0 };
     quint64 _sendStatsElapsedTime { 0 };
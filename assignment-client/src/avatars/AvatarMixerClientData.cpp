@@ -459,6 +459,16 @@ void AvatarMixerClientData::readViewFrustumPacket(const QByteArray& message) {
 
         _currentViewFrustums.push_back(frustum);
     }
+
+    ++_viewsVersion;
+}
+
+void AvatarMixerClientData::setPrioritySortWeights(float angularWeight, float centerWeight) {
+    if (angularWeight != _priorityAngularWeight || centerWeight != _priorityCenterWeight) {
+        _priorityAngularWeight = angularWeight;
+        _priorityCenterWeight = centerWeight;
+        ++_viewsVersion;
+    }
 }
 
 bool AvatarMixerClientData::otherAvatarInView(const AABox& otherAvatarBox) {
@@ -498,6 +508,7 @@ void AvatarMixerClientData::cleanupKilledNode(const QUuid&, Node::LocalID nodeLo
     removeLastBroadcastSequenceNumber(nodeLocalID);
     removeLastBroadcastTime(nodeLocalID);
     _lastSentTraitsTimestamps.erase(nodeLocalID);
+    _otherAvatarPriorities.erase(nodeLocalID);
     _perNodeSentTraitVersions.erase(nodeLocalID);
     _perNodeAckedTraitVersions.erase(nodeLocalID);
     for (auto&& pendingTraitVersions : _perNodePendingTraitVersions) {
@@ -27,6 +27,7 @@
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <PortableHighResolutionClock.h>
+#include <PrioritySortUtil.h>
 #include <SimpleMovingAverage.h>
 #include <UUIDHasher.h>
 #include <shared/ConicalViewFrustum.h>
@@ -123,6 +124,19 @@ public:
 
     const ConicalViewFrustums& getViewFrustums() const { return _currentViewFrustums; }
 
+    // the view-dependent terms of another avatar's sort priority, kept until that avatar or our views move
+    struct OtherAvatarPriority {
+        glm::vec3 position;
+        float radius { 0.0f };
+        uint32_t viewsVersion { 0 };
+        PrioritySortUtil::ViewTerms terms;
+    };
+    OtherAvatarPriority& getOtherAvatarPriority(NLPacket::LocalID otherAvatar) { return _otherAvatarPriorities[otherAvatar]; }
+
+    // bumped whenever the views or the sort weights change, invalidating every cached priority
+    uint32_t getViewsVersion() const { return _viewsVersion; }
+    void setPrioritySortWeights(float angularWeight, float centerWeight);
+
     uint64_t getLastOtherAvatarEncodeTime(NLPacket::LocalID otherAvatar) const;
     void setLastOtherAvatarEncodeTime(NLPacket::LocalID otherAvatar, uint64_t time);
 
@@ -190,6 +204,10 @@ private:
     SimpleMovingAverage _avgOtherAvatarTraitsRate;
     std::vector<QUuid> _radiusIgnoredOthers;
     ConicalViewFrustums _currentViewFrustums;
+    uint32_t _viewsVersion { 1 };
+    float _priorityAngularWeight { 0.0f };
+    float _priorityCenterWeight { 0.0f };
+    std::unordered_map<NLPacket::LocalID, OtherAvatarPriority> _otherAvatarPriorities;
 
     int _recentOtherAvatarsInView { 0 };
     int _recentOtherAvatarsOutOfView { 0 };
@@ -285,31 +285,20 @@ AABox computeBubbleBox(const AvatarData& avatar, float bubbleExpansionFactor) {
     return box;
 }
 
-namespace {
-    class SortableAvatar : public PrioritySortUtil::Sortable {
-    public:
-        SortableAvatar() = delete;
-        SortableAvatar(const MixerAvatar* avatar, const Node* avatarNode, uint64_t lastEncodeTime)
-            : _avatar(avatar), _node(avatarNode), _lastEncodeTime(lastEncodeTime) {
-        }
-        glm::vec3 getPosition() const override { return _avatar->getClientGlobalPosition(); }
-        float getRadius() const override {
-            glm::vec3 nodeBoxScale = _avatar->getGlobalBoundingBox().getScale();
-            return 0.5f * glm::max(nodeBoxScale.x, glm::max(nodeBoxScale.y, nodeBoxScale.z));
-        }
-        uint64_t getTimestamp() const override {
-            return _lastEncodeTime;
-        }
-        const Node* getNode() const { return _node; }
-        const MixerAvatar* getAvatar() const { return _avatar; }
-
-    private:
-        const MixerAvatar* _avatar;
-        const Node* _node;
-        uint64_t _lastEncodeTime;
+// moves the numToSelect highest priorities to the front of sortedAvatars, in order, leaving the rest unsorted
+void AvatarMixerSlave::selectHighestPriorities(std::vector<SortedAvatar>& sortedAvatars, int numToSelect) {
+    auto higherPriority = [](const SortedAvatar& left, const SortedAvatar& right) {
+        return left.priority > right.priority;
     };
 
-}  // Close anonymous namespace.
+    if (numToSelect <= 0 || numToSelect >= (int)sortedAvatars.size()) {
+        std::sort(sortedAvatars.begin(), sortedAvatars.end(), higherPriority);
+    } else {
+        auto selectedEnd = sortedAvatars.begin() + numToSelect;
+        std::nth_element(sortedAvatars.begin(), selectedEnd, sortedAvatars.end(), higherPriority);
+        std::sort(sortedAvatars.begin(), selectedEnd, higherPriority);
+    }
+}
 
 void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node) {
     const Node* destinationNode = node.data();
@@ -372,19 +361,20 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
     // prepare to sort
     const auto& cameraViews = destinationNodeData->getViewFrustums();
+    destinationNodeData->setPrioritySortWeights(AvatarData::_avatarSortCoefficientSize,
+                                                AvatarData::_avatarSortCoefficientCenter);
+    const uint32_t viewsVersion = destinationNodeData->getViewsVersion();
+    const uint64_t sortTimestamp = usecTimestampNow();
 
-    using AvatarPriorityQueue = PrioritySortUtil::PriorityQueue<SortableAvatar>;
-    // Keep two independent queues, one for heroes and one for the riff-raff.
-    enum PriorityVariants { kHero, kNonhero };
-    AvatarPriorityQueue avatarPriorityQueues[2] =
-    {
-        {cameraViews, AvatarData::_avatarSortCoefficientSize, 
-            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge},
-        {cameraViews, AvatarData::_avatarSortCoefficientSize,
-            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge}
-    };
+    // encodings shared between listeners are only valid for this broadcast
+    const int64_t encodingFrame = (int64_t)_lastFrameTimestamp.time_since_epoch().count();
 
-    avatarPriorityQueues[kNonhero].reserve(_end - _begin);
+    // Keep two independent lists, one for heroes and one for the riff-raff.
+    enum PriorityVariants { kHero, kNonhero };
+    for (auto& sortedAvatars : _sortedAvatars) {
+        sortedAvatars.clear();
+    }
+    _sortedAvatars[kNonhero].reserve(_end - _begin);
 
     for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
         Node* otherNodeRaw = (*listedNode).data();
@@ -468,8 +458,28 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             const MixerAvatar* avatarNodeData = sourceAvatarNodeData->getConstAvatarData();
             auto lastEncodeTime = destinationNodeData->getLastOtherAvatarEncodeTime(sourceAvatarNode->getLocalID());
 
-            avatarPriorityQueues[avatarNodeData->getHasPriority() ? kHero : kNonhero].push(
-                SortableAvatar(avatarNodeData, sourceAvatarNode, lastEncodeTime));
+            // only re-score the view-dependent terms when this avatar or our views have moved
+            glm::vec3 position = avatarNodeData->getClientGlobalPosition();
+            glm::vec3 boxScale = avatarNodeData->getGlobalBoundingBox().getScale();
+            float radius = 0.5f * glm::max(boxScale.x, glm::max(boxScale.y, boxScale.z));
+
+            auto& cachedPriority = destinationNodeData->getOtherAvatarPriority(sourceAvatarNode->getLocalID());
+            if (cachedPriority.viewsVersion != viewsVersion || cachedPriority.position != position ||
+                cachedPriority.radius != radius) {
+                cachedPriority.terms = PrioritySortUtil::computeViewTerms(cameraViews, position, radius,
+                    AvatarData::_avatarSortCoefficientSize, AvatarData::_avatarSortCoefficientCenter);
+                cachedPriority.position = position;
+                cachedPriority.radius = radius;
+                cachedPriority.viewsVersion = viewsVersion;
+                _stats.numPrioritiesRescored++;
+            }
+
+            float age = float((sortTimestamp - lastEncodeTime) / USECS_PER_SECOND);
+            float priority = PrioritySortUtil::priorityForAge(cachedPriority.terms, age,
+                                                              AvatarData::_avatarSortCoefficientAge);
+
+            _sortedAvatars[avatarNodeData->getHasPriority() ? kHero : kNonhero].push_back(
+                { sourceAvatarNode, lastEncodeTime, priority });
         }
         
         // If Node A's PAL WAS open but is no longer open, AND
@@ -495,7 +505,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
     // loop through our sorted avatars and allocate our bandwidth to them accordingly
 
-    int remainingAvatars = (int)avatarPriorityQueues[kHero].size() + (int)avatarPriorityQueues[kNonhero].size();
+    int remainingAvatars = (int)_sortedAvatars[kHero].size() + (int)_sortedAvatars[kNonhero].size();
     auto traitsPacketList = NLPacketList::create(PacketType::BulkAvatarTraits, QByteArray(), true, true);
 
     auto avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
@@ -507,10 +517,11 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
     // Loop over two priorities - hero avatars then everyone else:
     for (PriorityVariants currentVariant = kHero; currentVariant <= kNonhero; ++((int&)currentVariant)) {
-        const auto& sortedAvatarVector = avatarPriorityQueues[currentVariant].getSortedVector(numToSendEst);
+        auto& sortedAvatarVector = _sortedAvatars[currentVariant];
+        selectHighestPriorities(sortedAvatarVector, numToSendEst);
         for (const auto& sortedAvatar : sortedAvatarVector) {
-            const Node* sourceNode = sortedAvatar.getNode();
-            auto lastEncodeForOther = sortedAvatar.getTimestamp();
+            const Node* sourceNode = sortedAvatar.node;
+            auto lastEncodeForOther = sortedAvatar.lastEncodeTime;
 
             assert(sourceNode); // we can't have gotten here without the avatarData being a valid key in the map
 
@@ -542,7 +553,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             const MixerAvatar* sourceAvatar = sourceNodeData->getConstAvatarData();
 
             // Typically all out-of-view avatars but such avatars' priorities will rise with time:
-            bool isLowerPriority = sortedAvatar.getPriority() <= OUT_OF_VIEW_THRESHOLD;
+            bool isLowerPriority = sortedAvatar.priority <= OUT_OF_VIEW_THRESHOLD;
 
             if (isLowerPriority) {
                 detail = PALIsOpen ? AvatarData::PALMinimum : AvatarData::MinimumData;
@@ -564,16 +575,17 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
             QVector<JointData>& lastSentJointsForOther = destinationNodeData->getLastOtherAvatarSentJoints(sourceNode->getLocalID());
 
-            const bool distanceAdjust = true;
-            const bool dropFaceTracking = false;
             AvatarDataPacket::SendStatus sendStatus;
             sendStatus.sendUUID = true;
 
             do {
                 auto startSerialize = chrono::high_resolution_clock::now();
-                QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                    sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
-                    &lastSentJointsForOther, avatarSpaceAvailable);
+                bool sharedEncoding = false;
+                QByteArray bytes = sourceAvatar->toSharedByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
+                    sendStatus, destinationPosition, avatarSpaceAvailable, encodingFrame, sharedEncoding);
+                if (sharedEncoding) {
+                    _stats.numSharedEncodings++;
+                }
                 auto endSerialize = chrono::high_resolution_clock::now();
                 _stats.toByteArrayElapsedTime +=
                     (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
@@ -619,7 +631,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
         if (currentVariant == kHero) {  // Dump any remaining heroes into the commoners.
             for (auto avIter = sortedAvatarVector.begin() + numAvatarsSent; avIter < sortedAvatarVector.end(); ++avIter) {
-                avatarPriorityQueues[kNonhero].push(*avIter);
+                _sortedAvatars[kNonhero].push_back(*avIter);
             }
         }
     }
@@ -33,6 +33,8 @@ public:
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int numPrioritiesRescored { 0 };
+    int numSharedEncodings { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -59,6 +61,8 @@ public:
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        numPrioritiesRescored = 0;
+        numSharedEncodings = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -83,6 +87,8 @@ public:
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        numPrioritiesRescored += rhs.numPrioritiesRescored;
+        numSharedEncodings += rhs.numSharedEncodings;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -131,6 +137,13 @@ private:
                                         const AvatarMixerClientData* sendingNodeData,
                                         NLPacketList& traitsPacketList);
 
+    struct SortedAvatar {
+        const Node* node;
+        uint64_t lastEncodeTime;
+        float priority;
+    };
+    static void selectHighestPriorities(std::vector<SortedAvatar>& sortedAvatars, int numToSelect);
+
     void broadcastAvatarDataToAgent(const SharedNodePointer& node);
     void broadcastAvatarDataToDownstreamMixer(const SharedNodePointer& node);
 
@@ -143,6 +156,9 @@ private:
     float _throttlingRatio { 0.0f };
     float _avatarHeroFraction { 0.4f };
 
+    // other avatars considered for the current listener, heroes first; kept to reuse their storage
+    std::vector<SortedAvatar> _sortedAvatars[2];
+
     AvatarMixerSlaveStats _stats;
     SlaveSharedData* _sharedData;
 };
@@ -11,6 +11,8 @@
 
 #include "MixerAvatar.h"
 
+#include <algorithm>
+
 #include <QRegularExpression>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -415,3 +417,74 @@ void MixerAvatar::stopChallengeTimer() {
         QMetaObject::invokeMethod(&_challengeTimer, &QTimer::stop);
     }
 }
+
+QByteArray MixerAvatar::toSharedByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime,
+                                          QVector<JointData>& lastSentJointData, AvatarDataPacket::SendStatus& sendStatus,
+                                          glm::vec3 viewerPosition, int maxDataSize, int64_t frame, bool& shared) const {
+    const bool dropFaceTracking = false;
+    const bool distanceAdjust = true;
+
+    shared = false;
+
+    // continuations of a split encoding, and joint deltas, are specific to the listener
+    bool shareable = sendStatus.itemFlags == 0 && sendStatus.sendUUID &&
+        (dataDetail == PALMinimum || dataDetail == MinimumData || dataDetail == SendAllData);
+    if (!shareable) {
+        return toByteArray(dataDetail, lastSentTime, lastSentJointData, sendStatus, dropFaceTracking, distanceAdjust,
+                           viewerPosition, &lastSentJointData, maxDataSize);
+    }
+
+    // listeners last sent this avatar at different times can still want the same items
+    AvatarDataPacket::HasFlags wantedFlags = getWantedFlags(dataDetail, lastSentTime, dropFaceTracking);
+
+    QByteArray bytes;
+    QVector<JointData> sentJointData;
+    {
+        std::lock_guard<std::mutex> lock(_sharedEncodingsMutex);
+        if (_sharedEncodingsFrame != frame) {
+            _sharedEncodings.clear();
+            _sharedEncodingsFrame = frame;
+        }
+
+        auto it = std::find_if(_sharedEncodings.begin(), _sharedEncodings.end(), [&](const SharedEncoding& encoding) {
+            return encoding.detail == dataDetail && encoding.flags == wantedFlags;
+        });
+        if (it != _sharedEncodings.end()) {
+            bytes = it->bytes;
+            sentJointData = it->sentJointData;
+            shared = true;
+        }
+    }
+
+    if (!shared) {
+        // encode all of it, so that it can be shared with any listener that has the room
+        AvatarDataPacket::SendStatus fullSendStatus;
+        fullSendStatus.sendUUID = true;
+        bytes = toByteArray(dataDetail, lastSentTime, sentJointData, fullSendStatus, dropFaceTracking, distanceAdjust,
+                            viewerPosition, &sentJointData, 0);
+
+        if (fullSendStatus) {
+            std::lock_guard<std::mutex> lock(_sharedEncodingsMutex);
+            if (_sharedEncodingsFrame == frame) {
+                _sharedEncodings.push_back({ dataDetail, wantedFlags, bytes, sentJointData });
+            }
+        } else {
+            bytes.clear();
+        }
+    }
+
+    if (bytes.isEmpty() || (maxDataSize > 0 && bytes.size() > maxDataSize)) {
+        // not enough room left in the listener's packet, split it for them
+        shared = false;
+        return toByteArray(dataDetail, lastSentTime, lastSentJointData, sendStatus, dropFaceTracking, distanceAdjust,
+                           viewerPosition, &lastSentJointData, maxDataSize);
+    }
+
+    // SendAllData leaves the listener holding every joint that is not in its default pose
+    if (dataDetail == SendAllData) {
+        lastSentJointData = sentJointData;
+    }
+
+    sendStatus.itemFlags = 0;
+    return bytes;
+}
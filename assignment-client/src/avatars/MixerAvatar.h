@@ -14,6 +14,9 @@
 #ifndef hifi_MixerAvatar_h
 #define hifi_MixerAvatar_h
 
+#include <mutex>
+#include <vector>
+
 #include <AvatarData.h>
 
 class ResourceRequest;
@@ -36,6 +39,14 @@ public:
 
     void stopChallengeTimer();
 
+    // Encodes this avatar for one listener. The detail levels whose bytes do not depend on what that listener was sent
+    // before (PALMinimum, MinimumData and SendAllData) are encoded once per frame and shared by every listener that wants
+    // the same items; CullSmallData sends joint deltas and is always encoded per listener.
+    // Safe to call from several slave threads at once; frame identifies the broadcast the encodings are valid for.
+    QByteArray toSharedByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, QVector<JointData>& lastSentJointData,
+                                 AvatarDataPacket::SendStatus& sendStatus, glm::vec3 viewerPosition, int maxDataSize,
+                                 int64_t frame, bool& shared) const;
+
     // Avatar certification/verification:
     enum VerifyState {
         nonCertified, requestingFST, receivedFST, staticValidation, requestingOwner, ownerResponse,
@@ -66,6 +77,16 @@ private:
     bool _certifyFailed { false };
     bool _needsIdentityUpdate { false };
 
+    struct SharedEncoding {
+        AvatarDataDetail detail;
+        AvatarDataPacket::HasFlags flags;
+        QByteArray bytes;
+        QVector<JointData> sentJointData;   // what a listener has been sent once it receives bytes
+    };
+    mutable std::mutex _sharedEncodingsMutex;
+    mutable std::vector<SharedEncoding> _sharedEncodings; // guarded by _sharedEncodingsMutex
+    mutable int64_t _sharedEncodingsFrame { 0 }; // guarded by _sharedEncodingsMutex
+
     bool generateFSTHash();
     bool validateFSTHash(const QString& publicKey) const;
     QByteArray canonicalJson(const QString fstFile);
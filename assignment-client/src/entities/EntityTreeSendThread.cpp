@@ -20,12 +20,56 @@
 EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
     OctreeSendThread(myServer, node)
 {
-    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::editingEntityPointer, this, &EntityTreeSendThread::editingEntityPointer, Qt::QueuedConnection);
-    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntityPointer, this, &EntityTreeSendThread::deletingEntityPointer, Qt::QueuedConnection);
+    auto tree = std::static_pointer_cast<EntityTree>(myServer->getOctree());
+    auto pendingChanges = _pendingChanges;
+    _pendingChangeConnections.push_back(connect(tree.get(), &EntityTree::editingEntityPointer,
+        [pendingChanges](const EntityItemPointer& entity) {
+            pendingChanges->push({ PendingChange::EditingEntity, entity, nullptr });
+        }));
+    _pendingChangeConnections.push_back(connect(tree.get(), &EntityTree::deletingEntityPointer,
+        [pendingChanges](EntityItem* entity) {
+            pendingChanges->push({ PendingChange::DeletingEntity, nullptr, entity });
+        }));
 
     // connect to connection ID change on EntityNodeData so we can clear state for this receiver
     auto nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
-    connect(nodeData, &EntityNodeData::incomingConnectionIDChanged, this, &EntityTreeSendThread::resetState);
+    _pendingChangeConnections.push_back(connect(nodeData, &EntityNodeData::incomingConnectionIDChanged,
+        [pendingChanges] {
+            pendingChanges->push({ PendingChange::ResetState, nullptr, nullptr });
+        }));
+}
+
+EntityTreeSendThread::~EntityTreeSendThread() {
+    for (const auto& connection : _pendingChangeConnections) {
+        disconnect(connection);
+    }
+}
+
+void EntityTreeSendThread::PendingChanges::push(PendingChange change) {
+    std::lock_guard<std::mutex> lock(mutex);
+    changes.push_back(std::move(change));
+}
+
+void EntityTreeSendThread::applyPendingChanges() {
+    std::vector<PendingChange> changes;
+    {
+        std::lock_guard<std::mutex> lock(_pendingChanges->mutex);
+        changes.swap(_pendingChanges->changes);
+    }
+
+    for (const auto& change : changes) {
+        switch (change.type) {
+            case PendingChange::EditingEntity:
+                editingEntityPointer(change.editingEntity);
+                break;
+            case PendingChange::DeletingEntity:
+                deletingEntityPointer(change.deletingEntity);
+                break;
+            case PendingChange::ResetState:
+                resetState();
+                break;
+        }
+    }
 }
 
 void EntityTreeSendThread::resetState() {
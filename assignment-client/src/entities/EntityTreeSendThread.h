@@ -12,6 +12,8 @@
 #ifndef hifi_EntityTreeSendThread_h
 #define hifi_EntityTreeSendThread_h
 
+#include <memory>
+#include <mutex>
 #include <unordered_set>
 
 #include "../octree/OctreeSendThread.h"
@@ -29,15 +31,34 @@ class EntityTreeSendThread : public OctreeSendThread {
 
 public:
     EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node);
+    ~EntityTreeSendThread();
 
 protected:
     bool traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) override;
+    void applyPendingChanges() override;
+
+private:
+    // Tree and connection changes are signalled from other threads, and we may not have a thread of our own to queue
+    // them to, so they are kept here until the start of our next run. They are shared with the connections, which
+    // can outlive us for a call already in progress.
+    struct PendingChange {
+        enum Type { EditingEntity, DeletingEntity, ResetState };
+        Type type;
+        EntityItemPointer editingEntity;
+        EntityItem* deletingEntity;
+    };
+    struct PendingChanges {
+        std::mutex mutex;
+        std::vector<PendingChange> changes;
+
+        void push(PendingChange change);
+    };
+    std::shared_ptr<PendingChanges> _pendingChanges { std::make_shared<PendingChanges>() };
+    std::vector<QMetaObject::Connection> _pendingChangeConnections;
 
-private slots:
     void resetState(); // clears our known state forcing entities to appear unsent
 
-private:
     // the following two methods return booleans to indicate if any extra flagged entities were new additions to set
     bool addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
     bool addDescendantsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
@@ -58,7 +79,6 @@ private:
     int32_t _numEntitiesOffset { 0 };
     uint16_t _numEntities { 0 };
 
-private slots:
     void editingEntityPointer(const EntityItemPointer& entity);
     void deletingEntityPointer(EntityItem* entity);
 };
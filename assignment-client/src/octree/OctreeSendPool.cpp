@@ -0,0 +1,192 @@
+//
+//  OctreeSendPool.cpp
+//  assignment-client/src/octree
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include <SharedUtil.h>
+
+#include "OctreeSendThread.h"
+#include "OctreeServerConsts.h"
+
+// how long a worker keeps the tree read-locked for one window, so that edits aren't held off for a whole interval
+static const quint64 SEND_WINDOW_USECS = OCTREE_SEND_INTERVAL_USECS / 4;
+
+void OctreeSendWorker::run() {
+    std::vector<OctreeSendThread*> window;
+    while (_pool.claimWindow(window)) {
+        _pool.runWindow(window);
+    }
+}
+
+OctreeSendPool::OctreeSendPool(OctreePointer tree, int numThreads) : _tree(tree) {
+    numThreads = std::max(numThreads, 1);
+    for (int i = 0; i < numThreads; ++i) {
+        _workers.emplace_back(new OctreeSendWorker(*this));
+        _workers.back()->setObjectName(QString("Octree Send Worker %1").arg(i));
+        _workers.back()->start();
+    }
+}
+
+OctreeSendPool::~OctreeSendPool() {
+    {
+        Lock lock(_mutex);
+        _stopping = true;
+    }
+    _workerCondition.notify_all();
+
+    for (auto& worker : _workers) {
+        worker->wait();
+    }
+}
+
+void OctreeSendPool::add(OctreeSendThread* job) {
+    {
+        Lock lock(_mutex);
+        Job& added = _jobs[job];
+        added.dueUsecs = usecTimestampNow();
+    }
+    _workerCondition.notify_one();
+}
+
+void OctreeSendPool::remove(OctreeSendThread* job) {
+    Lock lock(_mutex);
+    auto it = _jobs.find(job);
+    if (it == _jobs.end()) {
+        return;
+    }
+
+    // jobs are only added and removed on this thread, so the iterator stays valid while we wait
+    _removeCondition.wait(lock, [&] { return !it->second.running; });
+    _jobs.erase(it);
+}
+
+std::vector<OctreeSendPool::JobStats> OctreeSendPool::getJobStats() const {
+    std::vector<JobStats> stats;
+
+    Lock lock(_mutex);
+    stats.reserve(_jobs.size());
+    for (const auto& entry : _jobs) {
+        const Job& job = entry.second;
+
+        JobStats jobStats;
+        jobStats.nodeUUID = entry.first->getNodeUuid();
+        jobStats.bytesSent = entry.first->getTotalBytesSent();
+        jobStats.runs = job.runs;
+        if (job.runs > 0) {
+            jobStats.averageLatencyUsecs = job.totalLatencyUsecs / job.runs;
+            jobStats.averageRunUsecs = job.totalRunUsecs / job.runs;
+        }
+        jobStats.maxLatencyUsecs = job.maxLatencyUsecs;
+        stats.push_back(jobStats);
+    }
+    return stats;
+}
+
+bool OctreeSendPool::claimWindow(std::vector<OctreeSendThread*>& window) {
+    window.clear();
+
+    Lock lock(_mutex);
+    while (!_stopping) {
+        quint64 now = usecTimestampNow();
+        quint64 nextDueUsecs = std::numeric_limits<quint64>::max();
+
+        std::vector<std::pair<quint64, OctreeSendThread*>> due;
+        for (const auto& entry : _jobs) {
+            const Job& job = entry.second;
+            if (job.running || job.finished) {
+                continue;
+            }
+
+            if (job.dueUsecs <= now) {
+                due.emplace_back(job.dueUsecs, entry.first);
+            } else {
+                nextDueUsecs = std::min(nextDueUsecs, job.dueUsecs);
+            }
+        }
+
+        if (!due.empty()) {
+            // share the due jobs out between the workers, most overdue first
+            size_t windowSize = (due.size() + _workers.size() - 1) / _workers.size();
+            std::partial_sort(due.begin(), due.begin() + windowSize, due.end());
+            for (size_t i = 0; i < windowSize; ++i) {
+                _jobs[due[i].second].running = true;
+                window.push_back(due[i].second);
+            }
+            return true;
+        }
+
+        if (nextDueUsecs == std::numeric_limits<quint64>::max()) {
+            _workerCondition.wait(lock);
+        } else {
+            _workerCondition.wait_for(lock, std::chrono::microseconds(nextDueUsecs - now));
+        }
+    }
+    return false;
+}
+
+void OctreeSendPool::runWindow(const std::vector<OctreeSendThread*>& window) {
+    struct Run {
+        quint64 start { 0 };
+        quint64 end { 0 };
+        bool keepRunning { true };
+    };
+    std::vector<Run> runs(window.size());
+    size_t numRun = 0;
+
+    quint64 windowStart = usecTimestampNow();
+    _tree->withReadLock([&] {
+        for (; numRun < window.size(); ++numRun) {
+            Run& run = runs[numRun];
+            run.start = usecTimestampNow();
+            if (numRun > 0 && run.start - windowStart > SEND_WINDOW_USECS) {
+                break;
+            }
+
+            // the job was claimed under the pool's lock, so no other worker runs it meanwhile
+            run.keepRunning = static_cast<GenericThread*>(window[numRun])->process();
+            run.end = usecTimestampNow();
+
+            if (!run.keepRunning) {
+                // the server removes the job in response; it can't do so until this run is marked done below
+                emit window[numRun]->finished();
+            }
+        }
+    });
+
+    {
+        Lock lock(_mutex);
+        for (size_t i = 0; i < window.size(); ++i) {
+            Job& job = _jobs[window[i]];
+            job.running = false;
+            if (i >= numRun) {
+                continue;   // didn't fit in the window, so it is still due
+            }
+
+            const Run& run = runs[i];
+            quint64 latency = run.start > job.dueUsecs ? run.start - job.dueUsecs : 0;
+            job.runs++;
+            job.totalLatencyUsecs += latency;
+            job.maxLatencyUsecs = std::max(job.maxLatencyUsecs, latency);
+            job.totalRunUsecs += run.end - run.start;
+            job.dueUsecs = run.start + OCTREE_SEND_INTERVAL_USECS;
+            job.finished = !run.keepRunning;
+        }
+    }
+
+    _removeCondition.notify_all();
+    if (numRun < window.size()) {
+        _workerCondition.notify_all();
+    }
+}
@@ -0,0 +1,100 @@
+//
+//  OctreeSendPool.h
+//  assignment-client/src/octree
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSendPool_h
+#define hifi_OctreeSendPool_h
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QThread>
+#include <QUuid>
+
+#include <Octree.h>
+
+class OctreeSendThread;
+class OctreeSendPool;
+
+class OctreeSendWorker : public QThread {
+    Q_OBJECT
+public:
+    OctreeSendWorker(OctreeSendPool& pool) : _pool(pool) {}
+
+    void run() override final;
+
+private:
+    OctreeSendPool& _pool;
+};
+
+// Runs the send jobs of every connected client on a fixed set of threads, rather than a thread per client.
+// Each job is due once per send interval and the most overdue jobs run first. A worker claims a window of due jobs
+// and runs them all inside one read lock of the tree, giving the lock back to writers once the window's budget is spent.
+//
+// The jobs are OctreeSendThreads initialized in non-threaded mode, so they stay on the thread that created them and
+// whatever they react to between runs has to be thread-safe. add() and remove() must be called from that one thread.
+class OctreeSendPool {
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    using ConditionVariable = std::condition_variable;
+
+public:
+    OctreeSendPool(OctreePointer tree, int numThreads = QThread::idealThreadCount());
+    ~OctreeSendPool();
+
+    void add(OctreeSendThread* job);
+
+    // stops scheduling the job, waiting for a run of it in progress to finish
+    void remove(OctreeSendThread* job);
+
+    int numThreads() const { return (int)_workers.size(); }
+
+    struct JobStats {
+        QUuid nodeUUID;
+        quint64 bytesSent { 0 };
+        quint64 runs { 0 };
+        quint64 averageLatencyUsecs { 0 };  // how long after being due the runs started
+        quint64 maxLatencyUsecs { 0 };
+        quint64 averageRunUsecs { 0 };
+    };
+    std::vector<JobStats> getJobStats() const;
+
+private:
+    friend class OctreeSendWorker;
+
+    struct Job {
+        quint64 dueUsecs { 0 };
+        bool running { false };
+        bool finished { false };    // process() returned false, waiting for remove()
+
+        quint64 runs { 0 };
+        quint64 totalLatencyUsecs { 0 };
+        quint64 maxLatencyUsecs { 0 };
+        quint64 totalRunUsecs { 0 };
+    };
+
+    // claims the most overdue jobs for a worker, waiting until some are due; returns false once the pool is stopping
+    bool claimWindow(std::vector<OctreeSendThread*>& window);
+    void runWindow(const std::vector<OctreeSendThread*>& window);
+
+    OctreePointer _tree;
+    std::vector<std::unique_ptr<OctreeSendWorker>> _workers;
+
+    mutable Mutex _mutex;
+    ConditionVariable _workerCondition;     // jobs were added or handed back
+    ConditionVariable _removeCondition;     // a run finished
+    std::unordered_map<OctreeSendThread*, Job> _jobs; // guarded by _mutex
+    bool _stopping { false }; // guarded by _mutex
+};
+
+#endif // hifi_OctreeSendPool_h
@@ -73,6 +73,8 @@ bool OctreeSendThread::process() {
 
     OctreeServer::didProcess(this);
 
+    applyPendingChanges();
+
     quint64  start = usecTimestampNow();
 
     // we'd better have a server at this point, or we're in trouble
@@ -101,8 +103,9 @@ bool OctreeSendThread::process() {
         return false; // exit early if we're shutting down
     }
 
-    // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap
-    if (isStillRunning()) {
+    // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap.
+    // Without a thread of our own we are run by the send pool, which does the waiting.
+    if (isStillRunning() && isThreaded()) {
         // dynamically sleep until we need to fire off the next set of octree elements
         int elapsed = (usecTimestampNow() - start);
         int usecToSleep =  OCTREE_SEND_INTERVAL_USECS - elapsed;
@@ -422,6 +425,7 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         }
     }
 
+    _totalBytesSent += _trueBytesSent;
     return _truePacketsSent;
 }
 
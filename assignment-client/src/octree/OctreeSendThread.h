@@ -37,6 +37,7 @@ public:
     bool isShuttingDown() { return _isShuttingDown; }
 
     QUuid getNodeUuid() const { return _nodeUuid; }
+    quint64 getTotalBytesSent() const { return _totalBytesSent; }
 
     static AtomicUIntStat _totalBytes;
     static AtomicUIntStat _totalWastedBytes;
@@ -52,6 +53,9 @@ protected:
     /// Implements generic processing behavior for this thread.
     virtual bool process() override;
 
+    /// Called at the start of each run to apply whatever changed since the last one
+    virtual void applyPendingChanges() { }
+
     virtual bool traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene);
     virtual bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) = 0;
@@ -73,6 +77,7 @@ private:
     int _truePacketsSent { 0 }; // available for debug stats
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
+    std::atomic<quint64> _totalBytesSent { 0 }; // for the per-client stats
     bool _isShuttingDown { false };
 };
 
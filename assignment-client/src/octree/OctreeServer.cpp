@@ -374,6 +374,12 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
                 statsString += QString("Persist file: %1\r\n").arg(_persistFilePath);
             }
 
+            auto editLog = _persistManager ? _persistManager->getEditLog() : nullptr;
+            if (editLog) {
+                statsString += QString("Edit log: %1 edits logged, %2 bytes, last flush took %3 usecs\r\n")
+                    .arg(editLog->getNumAppended()).arg(editLog->getSize()).arg(editLog->getLastFlushUsecs());
+            }
+
         } else {
             statsString += "Octree file not yet loaded...\r\n";
         }
@@ -439,6 +445,18 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("      writeDatagram() last second: %1 clients\r\n\r\n")
             .arg(locale.toString((uint)howManyThreadsDidCallWriteDatagram(oneSecondAgo)).rightJustified(COLUMN_WIDTH, ' '));
 
+        if (_sendPool) {
+            statsString += QString("                Send pool threads: %1 threads\r\n")
+                .arg(locale.toString(_sendPool->numThreads()).rightJustified(COLUMN_WIDTH, ' '));
+            for (const auto& jobStats : _sendPool->getJobStats()) {
+                statsString += QString("    %1: %2 bytes, %3 sends, latency avg %4 max %5 usecs, send avg %6 usecs\r\n")
+                    .arg(uuidStringWithoutCurlyBraces(jobStats.nodeUUID))
+                    .arg(locale.toString(jobStats.bytesSent)).arg(locale.toString(jobStats.runs))
+                    .arg(jobStats.averageLatencyUsecs).arg(jobStats.maxLatencyUsecs).arg(jobStats.averageRunUsecs);
+            }
+            statsString += "\r\n";
+        }
+
         float averageLoopTime = getAverageLoopTime();
         statsString += QString().sprintf("           Average packetLoop() time:      %7.2f msecs"
                                          "                 samples: %12d \r\n",
@@ -878,7 +896,14 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 
     // we want to be notified when the thread finishes
     connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+
+    // clients share a fixed set of send threads, rather than each having its own
+    if (!_sendPool) {
+        _sendPool.reset(new OctreeSendPool(_tree, _numSendThreads > 0 ? _numSendThreads : QThread::idealThreadCount()));
+        qDebug() << qPrintable(_safeServerName) << "server sending with" << _sendPool->numThreads() << "threads";
+    }
+    sendThread->initialize(false);
+    _sendPool->add(sendThread.get());
 
     return sendThread;
 }
@@ -887,6 +912,9 @@ void OctreeServer::removeSendThread() {
     // If the object has been deleted since the event was queued, sender() will return nullptr
     if (auto sendThread = qobject_cast<OctreeSendThread*>(sender())) {
         // This deletes the unique_ptr, so sendThread is destructed after that line
+        if (_sendPool) {
+            _sendPool->remove(sendThread);
+        }
         _sendThreads.erase(sendThread->getNodeUuid());
     }
 }
@@ -902,6 +930,7 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         if (it == _sendThreads.end()) {
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         } else if (it->second->isShuttingDown()) {
+            _sendPool->remove(it->second.get());
             _sendThreads.erase(it); // Remove right away and wait on thread to be
 
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
@@ -1048,6 +1077,12 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persisAbsoluteFilePath=" << _persistAbsoluteFilePath;
 
         _persistAsFileType = "json.gz";
+        QString persistFileFormat;
+        if (readOptionString("persistFileFormat", settingsSectionObject, persistFileFormat) &&
+            PERSIST_EXTENSIONS.contains(persistFileFormat)) {
+            _persistAsFileType = persistFileFormat;
+        }
+        qDebug() << "persistFileFormat=" << _persistAsFileType;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         int result { -1 };
@@ -1058,6 +1093,17 @@ void OctreeServer::readConfiguration() {
 
         qDebug() << "persistInterval=" << _persistInterval.count();
 
+        readOptionBool(QString("persistEditLog"), settingsSectionObject, _persistEditLog);
+        qDebug() << "persistEditLog=" << _persistEditLog;
+
+        _snapshotInterval = OctreePersistThread::DEFAULT_SNAPSHOT_INTERVAL;
+        result = -1;
+        readOptionInt(QString("snapshotInterval"), settingsSectionObject, result);
+        if (result != -1) {
+            _snapshotInterval = std::chrono::milliseconds(result);
+        }
+        qDebug() << "snapshotInterval=" << _snapshotInterval.count();
+
         readOptionBool(QString("persistFileDownload"), settingsSectionObject, _persistFileDownload);
         qDebug() << "persistFileDownload=" << _persistFileDownload;
 
@@ -1096,6 +1142,9 @@ void OctreeServer::readConfiguration() {
     qDebug("packetsPerSecondTotalMax=%d _packetsTotalPerInterval=%d",
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
+    readOptionInt(QString("sendThreads"), settingsSectionObject, _numSendThreads);
+    qDebug("sendThreads=%d", _numSendThreads);
+
 
     readAdditionalConfiguration(settingsSectionObject);
 }
@@ -1187,6 +1236,9 @@ void OctreeServer::domainSettingsRequestComplete() {
         // now set up PersistThread
         _persistManager = new OctreePersistThread(_tree, _persistAbsoluteFilePath, _persistInterval, _debugTimestampNow,
                                                  _persistAsFileType);
+        if (_persistEditLog) {
+            _persistManager->enableEditLog(_snapshotInterval);
+        }
         _persistManager->moveToThread(&_persistThread);
         connect(&_persistThread, &QThread::finished, _persistManager, &QObject::deleteLater);
         connect(&_persistThread, &QThread::started, _persistManager, &OctreePersistThread::start);
@@ -1295,8 +1347,9 @@ void OctreeServer::aboutToFinish() {
         sendThread.terminate();
     }
 
-    // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
-    // which waits on the thread to be done before returning
+    // Stopping the pool waits for the runs in progress to finish, after which
+    // clear will destruct all the unique_ptr to OctreeSendThreads
+    _sendPool.reset();
     _sendThreads.clear(); // Cleans up all the send threads.
 
     if (_persistManager) {
@@ -23,6 +23,7 @@
 #include <ThreadedAssignment.h>
 
 #include "OctreePersistThread.h"
+#include "OctreeSendPool.h"
 #include "OctreeSendThread.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
@@ -194,6 +195,8 @@ protected:
     QThread _persistThread;
 
     std::chrono::milliseconds _persistInterval;
+    bool _persistEditLog { false };
+    std::chrono::milliseconds _snapshotInterval;
     bool _persistFileDownload;
     int _maxBackupVersions;
 
@@ -202,6 +205,8 @@ protected:
     QString _safeServerName;
     
     SendThreads _sendThreads;
+    std::unique_ptr<OctreeSendPool> _sendPool;
+    int _numSendThreads { 0 }; // 0 for one per core
 
     static int _clientCount;
     static SimpleMovingAverage _averageLoopTime;
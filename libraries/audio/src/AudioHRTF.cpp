@@ -374,6 +374,77 @@ static void interpolate_SSE(const float* src0, const float* src1, float* dst, fl
     }
 }
 
+// apply gain crossfade with accumulation (interleaved)
+static void gainfade_1x2_SSE(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    gain0 *= (1/32768.0f);  // int16_t to float
+    gain1 *= (1/32768.0f);
+
+    __m128 g1 = _mm_set1_ps(gain1);
+    __m128 gd = _mm_set1_ps(gain0 - gain1);
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 f0 = _mm_loadu_ps(&win[i]);
+        __m128 g0 = _mm_add_ps(g1, _mm_mul_ps(f0, gd));
+
+        // sign-extend int16_t to int32_t
+        __m128i s0 = _mm_loadl_epi64((__m128i*)&src[i]);
+        s0 = _mm_srai_epi32(_mm_unpacklo_epi16(s0, s0), 16);
+
+        __m128 x0 = _mm_mul_ps(_mm_cvtepi32_ps(s0), g0);
+
+        __m128 y0 = _mm_loadu_ps(&dst[2*i+0]);
+        __m128 y1 = _mm_loadu_ps(&dst[2*i+4]);
+
+        // duplicate to stereo and accumulate
+        y0 = _mm_add_ps(y0, _mm_unpacklo_ps(x0, x0));
+        y1 = _mm_add_ps(y1, _mm_unpackhi_ps(x0, x0));
+
+        _mm_storeu_ps(&dst[2*i+0], y0);
+        _mm_storeu_ps(&dst[2*i+4], y1);
+    }
+}
+
+// apply gain crossfade with accumulation (interleaved)
+static void gainfade_2x2_SSE(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    gain0 *= (1/32768.0f);  // int16_t to float
+    gain1 *= (1/32768.0f);
+
+    __m128 g1 = _mm_set1_ps(gain1);
+    __m128 gd = _mm_set1_ps(gain0 - gain1);
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 f0 = _mm_loadu_ps(&win[i]);
+        __m128 g0 = _mm_add_ps(g1, _mm_mul_ps(f0, gd));
+
+        // sign-extend int16_t to int32_t
+        __m128i s0 = _mm_loadu_si128((__m128i*)&src[2*i]);
+        __m128i s1 = _mm_srai_epi32(_mm_unpackhi_epi16(s0, s0), 16);
+        s0 = _mm_srai_epi32(_mm_unpacklo_epi16(s0, s0), 16);
+
+        // same gain for both channels of a frame
+        __m128 x0 = _mm_mul_ps(_mm_cvtepi32_ps(s0), _mm_unpacklo_ps(g0, g0));
+        __m128 x1 = _mm_mul_ps(_mm_cvtepi32_ps(s1), _mm_unpackhi_ps(g0, g0));
+
+        __m128 y0 = _mm_loadu_ps(&dst[2*i+0]);
+        __m128 y1 = _mm_loadu_ps(&dst[2*i+4]);
+
+        // accumulate
+        y0 = _mm_add_ps(y0, x0);
+        y1 = _mm_add_ps(y1, x1);
+
+        _mm_storeu_ps(&dst[2*i+0], y0);
+        _mm_storeu_ps(&dst[2*i+4], y1);
+    }
+}
+
 //
 // Runtime CPU dispatch
 //
@@ -386,6 +457,8 @@ void interleave_4x4_AVX2(float* src0, float* src1, float* src2, float* src3, flo
 void biquad2_4x4_AVX2(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames);
 void crossfade_4x2_AVX2(float* src, float* dst, const float* win, int numFrames);
 void interpolate_AVX2(const float* src0, const float* src1, float* dst, float frac, float gain);
+void gainfade_1x2_AVX2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+void gainfade_2x2_AVX2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
 
 static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
     static auto f = cpuSupportsAVX512() ? FIR_1x4_AVX512 : (cpuSupportsAVX2() ? FIR_1x4_AVX2 : FIR_1x4_SSE);
@@ -412,6 +485,16 @@ static void interpolate(const float* src0, const float* src1, float* dst, float
     (*f)(src0, src1, dst, frac, gain); // dispatch
 }
 
+static void gainfade_1x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? gainfade_1x2_AVX2 : gainfade_1x2_SSE;
+    (*f)(src, dst, win, gain0, gain1, numFrames); // dispatch
+}
+
+static void gainfade_2x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? gainfade_2x2_AVX2 : gainfade_2x2_SSE;
+    (*f)(src, dst, win, gain0, gain1, numFrames); // dispatch
+}
+
 #else   // portable reference code
 
 // 1 channel input, 4 channel output
@@ -684,8 +767,6 @@ static void interpolate(const float* src0, const float* src1, float* dst, float
     }
 }
 
-#endif
-
 // apply gain crossfade with accumulation (interleaved)
 static void gainfade_1x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
 
@@ -723,6 +804,8 @@ static void gainfade_2x2(int16_t* src, float* dst, const float* win, float gain0
     }
 }
 
+#endif
+
 // design a 2nd order Thiran allpass
 static void ThiranBiquad(float f, float& b0, float& b1, float& b2, float& a1, float& a2) {
 
@@ -107,6 +107,20 @@ public:
         }
     }
 
+    // continue from the internal state of another instance, but retain settings
+    void copyState(const AudioHRTF& other) {
+        memcpy(_firState, other._firState, sizeof(_firState));
+        memcpy(_delayState, other._delayState, sizeof(_delayState));
+        memcpy(_bqState, other._bqState, sizeof(_bqState));
+
+        _azimuthState = other._azimuthState;
+        _distanceState = other._distanceState;
+        _gainState = other._gainState;
+        _lpfState = other._lpfState;
+
+        _resetState = other._resetState;
+    }
+
 private:
     AudioHRTF(const AudioHRTF&) = delete;
     AudioHRTF& operator=(const AudioHRTF&) = delete;
@@ -0,0 +1,111 @@
+//
+//  AudioSpatialGrid.h
+//  libraries/audio/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSpatialGrid_h
+#define hifi_AudioSpatialGrid_h
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+static const float AUDIO_GRID_MIN_CELL_SIZE = 0.1f;
+static const int32_t AUDIO_GRID_CELL_BITS = 21;    // per axis, packed into a 64 bit key
+static const int32_t AUDIO_GRID_CELL_LIMIT = (1 << (AUDIO_GRID_CELL_BITS - 1)) - 1;
+
+//
+// Uniform spatial hash of audio sources, rebuilt every frame and queried per listener,
+// so that the candidate sources for a listener scale with local density instead of total population.
+// Not thread-safe for insertion; concurrent queries are safe once the grid is built.
+//
+template <typename T>
+class AudioSpatialGrid {
+public:
+    struct Entry {
+        glm::vec3 position;
+        T value;
+    };
+
+    void setCellSize(float cellSize) { _cellSize = std::max(cellSize, AUDIO_GRID_MIN_CELL_SIZE); }
+    float getCellSize() const { return _cellSize; }
+
+    // empties the cells but keeps their storage for the next frame; cells that were already empty, because nothing
+    // was in them this frame, are dropped, so that the map only holds about the cells sources are moving through
+    void clear() {
+        for (auto it = _cells.begin(); it != _cells.end();) {
+            if (it->second.empty()) {
+                it = _cells.erase(it);
+            } else {
+                it->second.clear();
+                ++it;
+            }
+        }
+        _size = 0;
+    }
+
+    size_t getNumCells() const { return _cells.size(); }
+
+    void insert(const glm::vec3& position, const T& value) {
+        _cells[keyFor(cellFor(position.x), cellFor(position.y), cellFor(position.z))].push_back({ position, value });
+        ++_size;
+    }
+
+    size_t size() const { return _size; }
+
+    // calls f(entry) for every entry within radius of center
+    template <typename F>
+    void query(const glm::vec3& center, float radius, F&& f) const {
+        const float radiusSquared = radius * radius;
+
+        int32_t minX = cellFor(center.x - radius), maxX = cellFor(center.x + radius);
+        int32_t minY = cellFor(center.y - radius), maxY = cellFor(center.y + radius);
+        int32_t minZ = cellFor(center.z - radius), maxZ = cellFor(center.z + radius);
+
+        for (int32_t x = minX; x <= maxX; ++x) {
+            for (int32_t y = minY; y <= maxY; ++y) {
+                for (int32_t z = minZ; z <= maxZ; ++z) {
+                    auto it = _cells.find(keyFor(x, y, z));
+                    if (it == _cells.end()) {
+                        continue;
+                    }
+
+                    for (const auto& entry : it->second) {
+                        glm::vec3 delta = entry.position - center;
+                        if (glm::dot(delta, delta) <= radiusSquared) {
+                            f(entry);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    int32_t cellFor(float coordinate) const {
+        float cell = std::floor(coordinate / _cellSize);
+        return (int32_t)glm::clamp(cell, (float)-AUDIO_GRID_CELL_LIMIT, (float)AUDIO_GRID_CELL_LIMIT);
+    }
+
+    static uint64_t keyFor(int32_t x, int32_t y, int32_t z) {
+        const uint64_t MASK = (1ULL << AUDIO_GRID_CELL_BITS) - 1;
+        return ((uint64_t)(x & MASK) << (2 * AUDIO_GRID_CELL_BITS)) | ((uint64_t)(y & MASK) << AUDIO_GRID_CELL_BITS) |
+            (uint64_t)(z & MASK);
+    }
+
+    float _cellSize { 1.0f };
+    size_t _size { 0 };
+    std::unordered_map<uint64_t, std::vector<Entry>> _cells;
+};
+
+#endif // hifi_AudioSpatialGrid_h
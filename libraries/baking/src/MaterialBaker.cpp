@@ -23,7 +23,7 @@
 
 #include <graphics-scripting/GraphicsScriptingInterface.h>
 
-std::function<QThread*()> MaterialBaker::_getNextOvenWorkerThreadOperator;
+std::function<void(Baker*, Baker*)> MaterialBaker::_startOvenBakerOperator;
 
 static int materialNum = 0;
 
@@ -144,13 +144,15 @@ void MaterialBaker::processMaterial() {
                             textureBaker->setMapChannel(mapChannel);
                             connect(textureBaker.data(), &TextureBaker::finished, this, &MaterialBaker::handleFinishedTextureBaker);
                             _textureBakers.insert(textureKey, textureBaker);
-                            textureBaker->moveToThread(_getNextOvenWorkerThreadOperator ? _getNextOvenWorkerThreadOperator() : thread());
-                            // By default, Qt will invoke this bake immediately if the TextureBaker is on the same worker thread as this MaterialBaker.
-                            // We don't want that, because threads may be waiting for work while this thread is stuck processing a TextureBaker.
-                            // On top of that, _textureBakers isn't fully populated.
-                            // So, use Qt::QueuedConnection.
-                            // TODO: Better thread utilization at the top level, not just the MaterialBaker level
-                            QMetaObject::invokeMethod(textureBaker.data(), "bake", Qt::QueuedConnection);
+                            if (_startOvenBakerOperator) {
+                                // the Oven starts it on the next free worker thread, ahead of the bakers that aren't waited on
+                                _startOvenBakerOperator(textureBaker.data(), _parentBaker ? _parentBaker : this);
+                            } else {
+                                // By default, Qt will invoke this bake immediately if the TextureBaker is on the same thread as this MaterialBaker.
+                                // We don't want that, because _textureBakers isn't fully populated yet.
+                                // So, use Qt::QueuedConnection.
+                                QMetaObject::invokeMethod(textureBaker.data(), "bake", Qt::QueuedConnection);
+                            }
                         }
                         _materialsNeedingRewrite.insert(textureKey, networkMaterial.second);
                     } else {
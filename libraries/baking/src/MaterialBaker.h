@@ -37,7 +37,11 @@ public:
 
     NetworkMaterialResourcePointer getNetworkMaterialResource() const { return _materialResource; }
 
-    static void setNextOvenWorkerThreadOperator(std::function<QThread*()> getNextOvenWorkerThreadOperator) { _getNextOvenWorkerThreadOperator = getNextOvenWorkerThreadOperator; }
+    // the baker these are the materials of, which is what waits on their textures
+    void setParentBaker(Baker* parentBaker) { _parentBaker = parentBaker; }
+
+    // hands a texture baker to the Oven's queue, as a dependency of the baker that started it
+    static void setStartOvenBakerOperator(std::function<void(Baker*, Baker*)> startOvenBakerOperator) { _startOvenBakerOperator = startOvenBakerOperator; }
 
 public slots:
     virtual void bake() override;
@@ -57,6 +61,7 @@ private:
     QString _materialData;
     bool _isURL;
     QUrl _destinationPath;
+    Baker* _parentBaker { nullptr };
 
     NetworkMaterialResourcePointer _materialResource;
 
@@ -68,7 +73,7 @@ private:
     QString _bakedMaterialData;
 
     QScriptEngine _scriptEngine;
-    static std::function<QThread*()> _getNextOvenWorkerThreadOperator;
+    static std::function<void(Baker*, Baker*)> _startOvenBakerOperator;
     TextureFileNamer _textureFileNamer;
 
     void addTexture(const QString& materialName, image::TextureUsage::Type textureUsage, const hfm::Texture& texture);
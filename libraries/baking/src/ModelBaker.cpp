@@ -258,24 +258,34 @@ void ModelBaker::bakeSourceCopy() {
         dracoMaterialLists = baker.getDracoMaterialLists();
     }
 
-    // Do format-specific baking
-    bakeProcessedSource(_hfmModel, dracoMeshes, dracoMaterialLists);
-
-    if (shouldStop()) {
-        return;
-    }
-
+    // Start on the materials first, so that their textures bake on other worker threads while the meshes are written
     if (!_hfmModel->materials.empty()) {
         _materialBaker = QSharedPointer<MaterialBaker>(
             new MaterialBaker(_modelURL.fileName(), true, _bakedOutputDir),
             &MaterialBaker::deleteLater
         );
+        _materialBaker->setParentBaker(this);
         _materialBaker->setMaterials(_hfmModel->materials, _modelURL.toString());
         connect(_materialBaker.data(), &MaterialBaker::finished, this, &ModelBaker::handleFinishedMaterialBaker);
         _materialBaker->bake();
     } else {
-        bakeMaterialMap();
+        _areMaterialsBaked = true;
+    }
+
+    // Do format-specific baking
+    bakeProcessedSource(_hfmModel, dracoMeshes, dracoMaterialLists);
+
+    _isSourceBaked = true;
+    checkIfSourceAndMaterialsBaked();
+}
+
+void ModelBaker::checkIfSourceAndMaterialsBaked() {
+    // the material map is baked on this thread once both are done, whichever finishes last
+    if (!_isSourceBaked || !_areMaterialsBaked || shouldStop()) {
+        return;
     }
+
+    bakeMaterialMap();
 }
 
 void ModelBaker::handleFinishedMaterialBaker() {
@@ -307,7 +317,8 @@ void ModelBaker::handleFinishedMaterialBaker() {
         handleWarning("Failed to bake the materials for model with URL " + _modelURL.toString());
     }
 
-    bakeMaterialMap();
+    _areMaterialsBaked = true;
+    checkIfSourceAndMaterialsBaked();
 }
 
 void ModelBaker::bakeMaterialMap() {
@@ -318,6 +329,7 @@ void ModelBaker::bakeMaterialMap() {
             new MaterialBaker("materialMap" + QString::number(_materialMapIndex++), true, _bakedOutputDir),
             &MaterialBaker::deleteLater
         );
+        _materialBaker->setParentBaker(this);
         _materialBaker->setMaterials(_materialMapping.front().second);
         connect(_materialBaker.data(), &MaterialBaker::finished, this, &ModelBaker::handleFinishedMaterialMapBaker);
         _materialBaker->bake();
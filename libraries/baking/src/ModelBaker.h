@@ -88,9 +88,12 @@ protected slots:
 private:
     void outputUnbakedFST();
     void outputBakedFST();
+    void checkIfSourceAndMaterialsBaked();
     void bakeMaterialMap();
 
     bool _hasBeenBaked { false };
+    bool _isSourceBaked { false };
+    bool _areMaterialsBaked { false };
 
     hfm::Model::Pointer _hfmModel;
     MaterialMapping _materialMapping;
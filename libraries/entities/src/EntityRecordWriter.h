@@ -0,0 +1,47 @@
+//
+//  EntityRecordWriter.h
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityRecordWriter_h
+#define hifi_EntityRecordWriter_h
+
+#include <memory>
+
+#include <QDataStream>
+
+#include <Octree.h>
+#include <OctreePacketData.h>
+
+#include "EntityTreeElement.h"
+
+class QScriptEngine;
+
+// writes the entity records of snapshots and the edit log, reusing its encoding buffers from one entity to the next
+class EntityRecordWriter {
+public:
+    EntityRecordWriter();
+    ~EntityRecordWriter();
+
+    void write(QDataStream& stream, const EntityItemPointer& entity);
+
+    // drops a buffer grown for a large entity, for writers that are kept around between writes
+    void shrink();
+
+    int getNumJSONRecords() const { return _numJSONRecords; }
+
+private:
+    OctreePacketData _packetData { false, (int)MAX_OCTREE_PACKET_DATA_SIZE };
+    EncodeBitstreamParams _params;
+    EntityTreeElementExtraEncodeDataPointer _extraEncodeData { std::make_shared<EntityTreeElementExtraEncodeData>() };
+    std::unique_ptr<QScriptEngine> _scriptEngine;
+    int _numJSONRecords { 0 };
+};
+
+#endif // hifi_EntityRecordWriter_h
@@ -10,8 +10,11 @@
 //
 
 #include "EntityTree.h"
+#include <limits>
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
+#include <QtCore/QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
 #include <openssl/err.h>
 #include <openssl/pem.h>
 #include <openssl/x509.h>
@@ -27,6 +30,8 @@
 #include <PerfStat.h>
 #include <Profile.h>
 #include <AddressManager.h>
+#include <OctreeDataUtils.h>
+#include <OctreeEditLog.h>
 
 #include "EntitySimulation.h"
 #include "VariantMapToScriptValue.h"
@@ -40,6 +45,9 @@
 #include "LogHandler.h"
 #include "EntityEditFilters.h"
 #include "EntityDynamicFactoryInterface.h"
+#include "MaterialEntityItem.h"
+#include "TextEntityItem.h"
+#include "EntityRecordWriter.h"
 
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
@@ -751,6 +759,16 @@ void EntityTree::deleteEntitiesByPointer(const std::vector<EntityItemPointer>& e
         recurseTreeWithOperator(&theOperator);
         processRemovedEntities(theOperator);
         _isDirty = true;
+
+        // log what was actually deleted, rather than what was asked for, since filters can spare some children
+        if (_editLog && getIsServer()) {
+            std::vector<EntityItemID> ids;
+            ids.reserve(theOperator.getEntities().size());
+            for (const auto& details : theOperator.getEntities()) {
+                ids.push_back(details.entity->getEntityItemID());
+            }
+            logEntityErase(ids);
+        }
     }
 }
 
@@ -1990,10 +2008,14 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                     if (!isPhysics) {
                         properties.setLastEditedBy(senderNode->getUUID());
                     }
-                    updateEntity(existingEntity, properties, senderNode);
+                    bool updated = updateEntity(existingEntity, properties, senderNode);
                     existingEntity->markAsChangedOnServer();
                     endUpdate = usecTimestampNow();
                     _totalUpdates++;
+
+                    if (updated && _editLog) {
+                        logEntityEdit(existingEntity);
+                    }
                 } else if (isAdd) {
                     bool failedAdd = !allowed;
                     bool isCertified = !properties.getCertificateID().isEmpty();
@@ -2050,6 +2072,11 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                         if (newEntity) {
                             newEntity->markAsChangedOnServer();
                             notifyNewlyCreatedEntity(*newEntity, senderNode);
+
+                            // certified entities that failed verification have already been deleted again
+                            if (_editLog && newEntity->getElement()) {
+                                logEntityEdit(newEntity);
+                            }
                             
                             startLogging = usecTimestampNow();
                             if (wantEditLogging()) {
@@ -2903,6 +2930,9 @@ void convertGrabUserDataToProperties(EntityItemProperties& properties) {
 }
 
 
+// entities are converted in batches, so that only a couple of batches of properties are held at once
+static const int ENTITIES_PER_LOAD_BATCH = 4096;
+
 bool EntityTree::readFromMap(QVariantMap& map) {
     // These are needed to deal with older content (before adding inheritance modes)
     int contentVersion = map["Version"].toInt();
@@ -2929,148 +2959,432 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     // and iterated over.  Each member of this list is converted to a QVariantMap, then
     // to a QScriptValue, and then to EntityItemProperties.  These properties are used
     // to add the new entity to the EntityTree.
-    QVariantList entitiesQList = map["Entities"].toList();
-    QScriptEngine scriptEngine;
+    const QVariantList entitiesQList = map["Entities"].toList();
 
     if (entitiesQList.length() == 0) {
         // Empty map or invalidly formed file.
         return false;
     }
 
+    // wearables name the avatar joint they're attached to; look the joints up here, since the avatar isn't safe to
+    // touch from the thread pool
+    QHash<QString, int> avatarJointIndices;
+    if (_myAvatar) {
+        for (const auto& entityVariant : entitiesQList) {
+            QVariantMap entityMap = entityVariant.toMap();
+            if (entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
+                QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+                QString jointName = entityMap["parentJointName"].toString();
+                if (!avatarJointIndices.contains(jointName)) {
+                    avatarJointIndices[jointName] = _myAvatar->getJointIndex(jointName);
+                }
+            }
+        }
+    }
+
+    // The conversions don't touch the tree, so a batch of them runs on the thread pool while the entities of the
+    // batch before are added here; only adding to the tree is serialized.
+    struct EntityLoadBatch {
+        std::vector<EntityItemID> ids;
+        std::vector<EntityItemProperties> properties;
+        std::vector<std::pair<int, int>> chunks;
+    };
+    auto convertBatch = [this, &entitiesQList, &avatarJointIndices, contentVersion](EntityLoadBatch* batch, int begin, int end) {
+        batch->ids.clear();
+        batch->ids.resize(end - begin);
+        batch->properties.clear();
+        batch->properties.resize(end - begin);
+
+        // one chunk, and so one script engine, per pool thread
+        int numChunks = std::max(1, std::min(QThreadPool::globalInstance()->maxThreadCount(), end - begin));
+        batch->chunks.clear();
+        for (int i = 0; i < numChunks; ++i) {
+            batch->chunks.emplace_back(begin + (end - begin) * i / numChunks, begin + (end - begin) * (i + 1) / numChunks);
+        }
+
+        auto convertChunk = [this, &entitiesQList, &avatarJointIndices, contentVersion, batch, begin](const std::pair<int, int>& chunk) {
+            QScriptEngine scriptEngine;
+            for (int i = chunk.first; i < chunk.second; ++i) {
+                readEntityPropertiesFromMap(entitiesQList.at(i).toMap(), contentVersion, avatarJointIndices, scriptEngine,
+                                            batch->ids[i - begin], batch->properties[i - begin]);
+            }
+        };
+        return QtConcurrent::map(batch->chunks, convertChunk);
+    };
+
     QMap<QUuid, QVector<QUuid>> cloneIDs;
 
     bool success = true;
-    foreach (QVariant entityVariant, entitiesQList) {
-        // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
-        QVariantMap entityMap = entityVariant.toMap();
+    const int numEntities = entitiesQList.size();
+    EntityLoadBatch batches[2];
+    QFuture<void> conversion = convertBatch(&batches[0], 0, std::min(ENTITIES_PER_LOAD_BATCH, numEntities));
+    for (int begin = 0, current = 0; begin < numEntities; begin += ENTITIES_PER_LOAD_BATCH, current ^= 1) {
+        conversion.waitForFinished();
+
+        int end = std::min(begin + ENTITIES_PER_LOAD_BATCH, numEntities);
+        if (end < numEntities) {
+            conversion = convertBatch(&batches[current ^ 1], end, std::min(end + ENTITIES_PER_LOAD_BATCH, numEntities));
+        }
 
-        // handle parentJointName for wearables
-        if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
-            QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+        EntityLoadBatch& batch = batches[current];
+        for (size_t i = 0; i < batch.ids.size(); ++i) {
+            const EntityItemID& entityItemID = batch.ids[i];
+            const EntityItemProperties& properties = batch.properties[i];
 
-            entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+            EntityItemPointer entity = addEntity(entityItemID, properties);
+            if (!entity) {
+                qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+                success = false;
+            }
 
-            qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
-                " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+            if (entity) {
+                const QUuid& cloneOriginID = entity->getCloneOriginID();
+                if (!cloneOriginID.isNull()) {
+                    cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+                }
+            }
         }
+    }
 
-        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
-        EntityItemProperties properties;
-        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
+        }
+    }
 
-        EntityItemID entityItemID;
-        if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
-        } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
+    return success;
+}
+
+void EntityTree::readEntityPropertiesFromMap(QVariantMap entityMap, int contentVersion,
+                                             const QHash<QString, int>& avatarJointIndices, QScriptEngine& scriptEngine,
+                                             EntityItemID& entityItemID, EntityItemProperties& properties) const {
+    // QVariantMap --> QScriptValue --> EntityItemProperties
+
+    // handle parentJointName for wearables
+    if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
+        QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+
+        entityMap["parentJointIndex"] = avatarJointIndices.value(entityMap["parentJointName"].toString(), -1);
+
+        qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
+            " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+    }
+
+    QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+    EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+    if (entityMap.contains("id")) {
+        entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        entityItemID = EntityItemID(QUuid::createUuid());
+    }
+
+    // Convert old clientOnly bool to new entityHostType enum
+    // (must happen before setOwningAvatarID below)
+    if (contentVersion < (int)EntityVersion::EntityHostTypes) {
+        if (entityMap.contains("clientOnly")) {
+            properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        }
+    }
+
+    if (properties.getEntityHostType() == entity::HostType::AVATAR) {
+        auto nodeList = DependencyManager::get<NodeList>();
+        const QUuid myNodeID = nodeList->getSessionUUID();
+        properties.setOwningAvatarID(myNodeID);
+    }
+
+    // Fix for older content not containing mode fields in the zones
+    if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
+        // The legacy version had no keylight mode - this is set to on
+        properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+
+        // The ambient URL has been moved from "keyLight" to "ambientLight"
+        if (entityMap.contains("keyLight")) {
+            QVariantMap keyLightObject = entityMap["keyLight"].toMap();
+            properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
         }
 
-        // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
-        if (contentVersion < (int)EntityVersion::EntityHostTypes) {
-            if (entityMap.contains("clientOnly")) {
-                properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
+        // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
+        properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
+        if (properties.getAmbientLight().getAmbientURL() == "") {
+            if (properties.getSkybox().getURL() != "") {
+                properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
+            } else {
+                properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
             }
         }
 
-        if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
+        // The background should be enabled if the mode is skybox
+        // Note that if the values are default then they are not stored in the JSON file
+        if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
+            properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
+        } else {
+            properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
         }
+    }
 
-        // Fix for older content not containing mode fields in the zones
-        if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
-            // The legacy version had no keylight mode - this is set to on
-            properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+    // Convert old materials so that they use materialData instead of userData
+    if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
+        if (properties.getMaterialURL().startsWith("userData")) {
+            QString materialURL = properties.getMaterialURL();
+            properties.setMaterialURL(materialURL.replace("userData", "materialData"));
 
-            // The ambient URL has been moved from "keyLight" to "ambientLight"
-            if (entityMap.contains("keyLight")) {
-                QVariantMap keyLightObject = entityMap["keyLight"].toMap();
-                properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
+            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+            QJsonObject materialData;
+            QJsonValue materialVersion = userData["materialVersion"];
+            if (!materialVersion.isNull()) {
+                materialData.insert("materialVersion", materialVersion);
+                userData.remove("materialVersion");
             }
-
-            // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
-            // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
-            properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
-            if (properties.getAmbientLight().getAmbientURL() == "") {
-                if (properties.getSkybox().getURL() != "") {
-                    properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
-                } else {
-                    properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
-                }
+            QJsonValue materials = userData["materials"];
+            if (!materials.isNull()) {
+                materialData.insert("materials", materials);
+                userData.remove("materials");
             }
 
-            // The background should be enabled if the mode is skybox
-            // Note that if the values are default then they are not stored in the JSON file
-            if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
-                properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
-            } else {
-                properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
-            }
+            properties.setMaterialData(QJsonDocument(materialData).toJson());
+            properties.setUserData(QJsonDocument(userData).toJson());
         }
+    }
 
-        // Convert old materials so that they use materialData instead of userData
-        if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
-            if (properties.getMaterialURL().startsWith("userData")) {
-                QString materialURL = properties.getMaterialURL();
-                properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+    // Convert old cloneable entities so they use cloneableData instead of userData
+    if (contentVersion < (int)EntityVersion::CloneableData) {
+        QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+        QJsonObject grabbableKey = userData["grabbableKey"].toObject();
+        QJsonValue cloneable = grabbableKey["cloneable"];
+        if (cloneable.isBool() && cloneable.toBool()) {
+            QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
+            QJsonValue cloneLimit = grabbableKey["cloneLimit"];
+            QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
+            QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
 
-                QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-                QJsonObject materialData;
-                QJsonValue materialVersion = userData["materialVersion"];
-                if (!materialVersion.isNull()) {
-                    materialData.insert("materialVersion", materialVersion);
-                    userData.remove("materialVersion");
-                }
-                QJsonValue materials = userData["materials"];
-                if (!materials.isNull()) {
-                    materialData.insert("materials", materials);
-                    userData.remove("materials");
-                }
+            // This is cloneable, we need to convert the properties
+            properties.setCloneable(true);
+            properties.setCloneLifetime(cloneLifetime.toInt());
+            properties.setCloneLimit(cloneLimit.toInt());
+            properties.setCloneDynamic(cloneDynamic.toBool());
+            properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+        }
+    }
 
-                properties.setMaterialData(QJsonDocument(materialData).toJson());
-                properties.setUserData(QJsonDocument(userData).toJson());
+    // convert old grab-related userData to new grab properties
+    if (contentVersion < (int)EntityVersion::GrabProperties) {
+        convertGrabUserDataToProperties(properties);
+    }
+
+    // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
+    if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
+        properties.setRadiusSpread(0.0f);
+        properties.setAlphaSpread(0.0f);
+        properties.setColorSpread({0, 0, 0});
+    }
+
+    if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
+        if (entityMap.contains("created")) {
+            quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
+            properties.setCreated(created);
+        }
+    }
+}
+
+bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
+    QScriptEngine scriptEngine;
+    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
+    for (const auto& entity : getEntitySnapshot()) {
+        // copy the properties under a short read lock, so that edits can't tear them and deleted entities are left out
+        EntityItemProperties properties;
+        bool isAlive = resultWithReadLock<bool>([&] {
+            if (entity->isDead()) {
+                return false;
             }
+            properties = entity->getProperties();
+            return true;
+        });
+
+        if (isAlive) {
+            theOperator.processEntityProperties(properties);
         }
+    }
 
-        // Convert old cloneable entities so they use cloneableData instead of userData
-        if (contentVersion < (int)EntityVersion::CloneableData) {
-            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-            QJsonObject grabbableKey = userData["grabbableKey"].toObject();
-            QJsonValue cloneable = grabbableKey["cloneable"];
-            if (cloneable.isBool() && cloneable.toBool()) {
-                QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
-                QJsonValue cloneLimit = grabbableKey["cloneLimit"];
-                QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
-                QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+    jsonString = theOperator.getJson();
+    return true;
+}
 
-                // This is cloneable, we need to convert the properties
-                properties.setCloneable(true);
-                properties.setCloneLifetime(cloneLifetime.toInt());
-                properties.setCloneLimit(cloneLimit.toInt());
-                properties.setCloneDynamic(cloneDynamic.toBool());
-                properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
-            }
+std::vector<EntityItemPointer> EntityTree::getEntitySnapshot() const {
+    std::vector<EntityItemPointer> entities;
+    QReadLocker locker(&_entityMapLock);
+    entities.reserve(_entityMap.size());
+    for (const auto& entity : _entityMap) {
+        entities.push_back(entity);
+    }
+    return entities;
+}
+
+namespace {
+
+// each record is written as its type, the entity's isVisibleInSecondaryCamera (which isn't part of the entity data)
+// and a length prefixed blob, so that readers can skip records they don't know. Snapshots end with an End record.
+enum class EntityRecordType : quint8 {
+    End = 0,
+    EntityData,     // the EntityItem::appendEntityData() encoding
+    EntityJSON,     // for entities with properties too large for the entity data encoding
+    EntityErase     // edit logs only, the RFC 4122 IDs of deleted entities
+};
+
+const int ENTITY_RECORD_DATA_MAX_SIZE = 16 * 1024 * 1024;
+
+// strings in the entity data encoding are prefixed with a 16 bit length
+bool fitsEntityDataString(const QString& string) {
+    const int MAX_STRING_BYTES = std::numeric_limits<uint16_t>::max();
+    return string.size() <= MAX_STRING_BYTES / 3 || string.toUtf8().size() <= MAX_STRING_BYTES;
+}
+
+bool fitsEntityData(const EntityItemPointer& entity) {
+    bool fits = fitsEntityDataString(entity->getUserData()) && fitsEntityDataString(entity->getPrivateUserData()) &&
+        fitsEntityDataString(entity->getScript()) && fitsEntityDataString(entity->getServerScripts()) &&
+        fitsEntityDataString(entity->getDescription());
+
+    if (fits && entity->getType() == EntityTypes::Material) {
+        fits = fitsEntityDataString(std::static_pointer_cast<MaterialEntityItem>(entity)->getMaterialData());
+    } else if (fits && entity->getType() == EntityTypes::Text) {
+        fits = fitsEntityDataString(std::static_pointer_cast<TextEntityItem>(entity)->getText());
+    }
+    return fits;
+}
+
+}
+
+EntityRecordWriter::EntityRecordWriter() {
+}
+
+EntityRecordWriter::~EntityRecordWriter() {
+}
+
+void EntityRecordWriter::write(QDataStream& stream, const EntityItemPointer& entity) {
+    OctreeElement::AppendState appendState = OctreeElement::NONE;
+    if (fitsEntityData(entity)) {
+        _packetData.reset();
+        _extraEncodeData->entities.clear();
+        appendState = entity->appendEntityData(&_packetData, _params, _extraEncodeData, true);
+
+        // grow the buffer for entities that don't fit, rather than splitting them across records
+        while (appendState != OctreeElement::COMPLETED && (int)_packetData.getTargetSize() < ENTITY_RECORD_DATA_MAX_SIZE) {
+            _packetData.changeSettings(false, 2 * _packetData.getTargetSize());
+            _extraEncodeData->entities.clear();
+            appendState = entity->appendEntityData(&_packetData, _params, _extraEncodeData, true);
         }
+    }
 
-        // convert old grab-related userData to new grab properties
-        if (contentVersion < (int)EntityVersion::GrabProperties) {
-            convertGrabUserDataToProperties(properties);
+    if (appendState == OctreeElement::COMPLETED) {
+        QByteArray entityData = QByteArray::fromRawData((const char*)_packetData.getUncompressedData(),
+                                                        _packetData.getUncompressedSize());
+        stream << (quint8)EntityRecordType::EntityData << entity->isVisibleInSecondaryCamera() << entityData;
+    } else {
+        if (!_scriptEngine) {
+            _scriptEngine.reset(new QScriptEngine());
         }
+        QScriptValue entityScriptValue = EntityItemNonDefaultPropertiesToScriptValue(_scriptEngine.get(), entity->getProperties());
+        QByteArray entityJSON = QJsonDocument::fromVariant(entityScriptValue.toVariant()).toJson(QJsonDocument::Compact);
+        stream << (quint8)EntityRecordType::EntityJSON << entity->isVisibleInSecondaryCamera() << entityJSON;
+        ++_numJSONRecords;
+    }
+}
 
-        // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
-        if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
-            properties.setRadiusSpread(0.0f);
-            properties.setAlphaSpread(0.0f);
-            properties.setColorSpread({0, 0, 0});
+void EntityRecordWriter::shrink() {
+    if (_packetData.getTargetSize() > MAX_OCTREE_PACKET_DATA_SIZE) {
+        _packetData.changeSettings(false, (int)MAX_OCTREE_PACKET_DATA_SIZE);
+    }
+}
+
+namespace {
+
+// reads the rest of an EntityData or EntityJSON record, returning false if the entity couldn't be decoded
+bool readEntityRecord(EntityRecordType type, bool isVisibleInSecondaryCamera, const QByteArray& blob,
+                      EntityItemID& entityItemID, EntityItemProperties& properties) {
+    if (type == EntityRecordType::EntityData) {
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(blob.constData());
+        EntityTypes::EntityType entityType = EntityTypes::Unknown;
+        QUuid id;
+        EntityTypes::extractEntityTypeAndID(data, blob.size(), entityType, id);
+        if (!properties.constructFromBuffer(data, blob.size())) {
+            qCDebug(entities) << "reading Entity record failed:" << id << entityType;
+            return false;
         }
+        entityItemID = EntityItemID(id);
+    } else if (type == EntityRecordType::EntityJSON) {
+        QScriptEngine scriptEngine;
+        QVariantMap entityMap = QJsonDocument::fromJson(blob).toVariant().toMap();
+        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+        entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        qCDebug(entities) << "Skipping unknown Entity record type" << (int)type;
+        return false;
+    }
+    properties.setIsVisibleInSecondaryCamera(isVisibleInSecondaryCamera);
+    return true;
+}
+
+}
 
-        if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
-            if (entityMap.contains("created")) {
-                quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
-                properties.setCreated(created);
+bool EntityTree::writeSnapshotData(QDataStream& outputStream) {
+    std::vector<EntityItemPointer> entities = getEntitySnapshot();
+
+    EntityRecordWriter writer;
+    QByteArray record;
+    for (const auto& entity : entities) {
+        // encode the record under a short read lock, so that edits can't tear it and deleted entities are left out
+        record.clear();
+        withReadLock([&] {
+            if (entity->isDead() || !entity->isParentIDValid()) {
+                return;  // we weren't able to resolve a parent from _parentID, so don't save this entity.
             }
+            QDataStream recordStream(&record, QIODevice::WriteOnly);
+            recordStream.setVersion(OctreeUtils::SNAPSHOT_STREAM_VERSION);
+            writer.write(recordStream, entity);
+        });
+
+        outputStream.writeRawData(record.constData(), record.size());
+    }
+    outputStream << (quint8)EntityRecordType::End;
+
+    if (writer.getNumJSONRecords() > 0) {
+        qCDebug(entities) << "Wrote" << writer.getNumJSONRecords() << "of" << entities.size() << "entities to the snapshot as JSON";
+    }
+    return outputStream.status() == QDataStream::Ok;
+}
+
+bool EntityTree::readSnapshotData(QDataStream& inputStream) {
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    bool success = true;
+
+    while (true) {
+        quint8 recordType;
+        inputStream >> recordType;
+        if (inputStream.status() != QDataStream::Ok) {
+            qCritical() << "Snapshot ended before its last entity";
+            return false;
+        }
+
+        if ((EntityRecordType)recordType == EntityRecordType::End) {
+            break;
+        }
+
+        bool isVisibleInSecondaryCamera;
+        QByteArray blob;
+        inputStream >> isVisibleInSecondaryCamera >> blob;
+        if (inputStream.status() != QDataStream::Ok) {
+            qCritical() << "Snapshot ended before its last entity";
+            return false;
+        }
+
+        EntityItemID entityItemID;
+        EntityItemProperties properties;
+        if (!readEntityRecord((EntityRecordType)recordType, isVisibleInSecondaryCamera, blob, entityItemID, properties)) {
+            success = false;
+            continue;
         }
 
         EntityItemPointer entity = addEntity(entityItemID, properties);
@@ -3097,15 +3411,79 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     return success;
 }
 
-bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
-    QScriptEngine scriptEngine;
-    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
-    withReadLock([&] {
-        recurseTreeWithOperator(&theOperator);
-    });
+void EntityTree::logEntityEdit(const EntityItemPointer& entity) {
+    QByteArray record;
+    QDataStream recordStream(&record, QIODevice::WriteOnly);
+    recordStream.setVersion(OctreeUtils::SNAPSHOT_STREAM_VERSION);
 
-    jsonString = theOperator.getJson();
-    return true;
+    // only called with the tree locked for writing, so the writer is never shared
+    if (!_editLogWriter) {
+        _editLogWriter.reset(new EntityRecordWriter());
+    }
+    _editLogWriter->write(recordStream, entity);
+    _editLogWriter->shrink();
+    _editLog->append(record);
+}
+
+void EntityTree::logEntityErase(const std::vector<EntityItemID>& ids) {
+    QByteArray encodedIDs;
+    encodedIDs.reserve((int)ids.size() * NUM_BYTES_RFC4122_UUID);
+    for (const auto& id : ids) {
+        encodedIDs.append(id.toRfc4122());
+    }
+
+    QByteArray record;
+    QDataStream recordStream(&record, QIODevice::WriteOnly);
+    recordStream.setVersion(OctreeUtils::SNAPSHOT_STREAM_VERSION);
+    recordStream << (quint8)EntityRecordType::EntityErase << false << encodedIDs;
+    _editLog->append(record);
+}
+
+bool EntityTree::replayEditLogRecord(const QByteArray& record) {
+    QDataStream recordStream(record);
+    recordStream.setVersion(OctreeUtils::SNAPSHOT_STREAM_VERSION);
+
+    quint8 recordType;
+    bool isVisibleInSecondaryCamera;
+    QByteArray blob;
+    recordStream >> recordType >> isVisibleInSecondaryCamera >> blob;
+    if (recordStream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    if ((EntityRecordType)recordType == EntityRecordType::EntityErase) {
+        std::vector<EntityItemID> ids;
+        for (int i = 0; i + NUM_BYTES_RFC4122_UUID <= blob.size(); i += NUM_BYTES_RFC4122_UUID) {
+            ids.push_back(EntityItemID(QUuid::fromRfc4122(blob.mid(i, NUM_BYTES_RFC4122_UUID))));
+        }
+        deleteEntitiesByID(ids, true, true);
+        return true;
+    }
+
+    EntityItemID entityItemID;
+    EntityItemProperties properties;
+    if (!readEntityRecord((EntityRecordType)recordType, isVisibleInSecondaryCamera, blob, entityItemID, properties)) {
+        return false;
+    }
+
+    EntityItemPointer entity = findEntityByEntityItemID(entityItemID);
+    if (!entity) {
+        entity = addEntity(entityItemID, properties);
+        if (entity && !entity->getCloneOriginID().isNull()) {
+            EntityItemPointer cloneOrigin = findEntityByID(entity->getCloneOriginID());
+            if (cloneOrigin) {
+                cloneOrigin->addCloneID(entityItemID);
+            }
+        }
+        return (bool)entity;
+    }
+
+    // the record is the entity's whole state, so properties it leaves out are back at their defaults. The simulation
+    // owner it was logged with is long gone, and would otherwise have updateEntity() refuse the physical properties.
+    properties.markAllChanged();
+    properties.setSimulationOwnerChanged(false);
+    entity->clearSimulationOwnership();
+    return updateEntity(entity, properties);
 }
 
 void EntityTree::resetClientEditStats() {
@@ -26,7 +26,9 @@
 class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
 
+class EntityRecordWriter;
 class EntitySimulation;
+class QScriptEngine;
 
 namespace EntityQueryFilterSymbol {
     static const QString NonDefault = "+";
@@ -170,6 +172,9 @@ public:
     EntityTreeElementPointer getContainingElement(const EntityItemID& entityItemID)  /*const*/;
     void addEntityMapEntry(EntityItemPointer entity);
     void clearEntityMapEntry(const EntityItemID& id);
+    // copies the entity pointers under a brief lock, so that they can be serialized without holding up edits; each entity
+    // is then read under a short read lock of its own, and skipped if it has been deleted meanwhile
+    std::vector<EntityItemPointer> getEntitySnapshot() const;
     void debugDumpMap();
     virtual void dumpTree() override;
     virtual void pruneTree() override;
@@ -197,6 +202,9 @@ public:
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
+    virtual bool writeSnapshotData(QDataStream& outputStream) override;
+    virtual bool readSnapshotData(QDataStream& inputStream) override;
+    virtual bool replayEditLogRecord(const QByteArray& record) override;
 
 
     glm::vec3 getContentsDimensions();
@@ -383,6 +391,17 @@ private:
     void sendChallengeOwnershipRequestPacket(const QByteArray& id, const QByteArray& text, const QByteArray& nodeToChallenge, const SharedNodePointer& senderNode);
     void validatePop(const QString& certID, const EntityItemID& entityItemID, const SharedNodePointer& senderNode);
 
+    // append the entity's state, or the IDs of deleted entities, to the edit log; only call these when _editLog is set
+    void logEntityEdit(const EntityItemPointer& entity);
+    void logEntityErase(const std::vector<EntityItemID>& ids);
+
+    // converts one entity of a loaded "Entities" list, fixing up content from older versions; safe to call from
+    // several threads at once, each with their own script engine. avatarJointIndices maps the joint names of wearables
+    // to the avatar's joints, looked up beforehand.
+    void readEntityPropertiesFromMap(QVariantMap entityMap, int contentVersion,
+                                     const QHash<QString, int>& avatarJointIndices, QScriptEngine& scriptEngine,
+                                     EntityItemID& entityItemID, EntityItemProperties& properties) const;
+
     std::shared_ptr<AvatarData> _myAvatar{ nullptr };
 
     static std::function<QObject*(const QUuid&)> _getEntityObjectOperator;
@@ -396,6 +415,8 @@ private:
 
     std::map<QString, QString> _namedPaths;
 
+    std::unique_ptr<EntityRecordWriter> _editLogWriter; // made on the first logged edit
+
     void updateEntityQueryAACubeWorker(SpatiallyNestablePointer object, EntityEditPacketSender* packetSender,
                                        MovingEntitiesOperator& moveOperator, bool force, bool tellServer);
 };
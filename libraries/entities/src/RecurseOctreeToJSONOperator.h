@@ -20,9 +20,10 @@ public:
 
     QString getJson() const { return _json; }
 
-private:
     void processEntity(const EntityItemPointer& entity);
+    void processEntityProperties(const EntityItemProperties& properties);
 
+private:
     QScriptEngine* _engine;
     QScriptValue _toStringMethod;
 
@@ -0,0 +1,90 @@
+//
+//  AssetChunking.cpp
+//  libraries/networking/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunking.h"
+
+#include <algorithm>
+#include <array>
+
+#include "AssetUtils.h"
+
+namespace AssetUtils {
+
+// a bit of the gear hash depends on as many of the last bytes as it is places from the bottom, so the boundaries are
+// tested on the top bits; more of them have to be clear before the average size, fewer after, which keeps the chunk
+// sizes close to the average
+static const int STRICT_MASK_BITS = 18;
+static const int LOOSE_MASK_BITS = 14;
+static const quint64 STRICT_MASK = ~0ULL << (64 - STRICT_MASK_BITS);
+static const quint64 LOOSE_MASK = ~0ULL << (64 - LOOSE_MASK_BITS);
+
+using GearTable = std::array<quint64, 256>;
+
+// random values for each byte, generated from a fixed seed so that they are the same everywhere
+static GearTable makeGearTable() {
+    GearTable table;
+    quint64 state = 0x48696669436875ULL;
+    for (auto& value : table) {
+        // splitmix64
+        state += 0x9E3779B97F4A7C15ULL;
+        quint64 mixed = state;
+        mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+        value = mixed ^ (mixed >> 31);
+    }
+    return table;
+}
+
+qint64 findChunkBoundary(const char* data, qint64 size) {
+    static const GearTable GEAR = makeGearTable();
+
+    if (size <= MIN_CHUNK_SIZE) {
+        return size;
+    }
+
+    const uchar* bytes = reinterpret_cast<const uchar*>(data);
+    qint64 end = std::min(size, (qint64)MAX_CHUNK_SIZE);
+    qint64 average = std::min(end, (qint64)AVERAGE_CHUNK_SIZE);
+    quint64 hash = 0;
+
+    qint64 i = MIN_CHUNK_SIZE;
+    for (; i < average; ++i) {
+        hash = (hash << 1) + GEAR[bytes[i]];
+        if (!(hash & STRICT_MASK)) {
+            return i + 1;
+        }
+    }
+    for (; i < end; ++i) {
+        hash = (hash << 1) + GEAR[bytes[i]];
+        if (!(hash & LOOSE_MASK)) {
+            return i + 1;
+        }
+    }
+    return end;
+}
+
+AssetChunks splitIntoChunks(const QByteArray& data) {
+    AssetChunks chunks;
+    chunks.reserve(data.size() / AVERAGE_CHUNK_SIZE + 1);
+
+    qint64 offset = 0;
+    while (offset < data.size()) {
+        AssetChunk chunk;
+        chunk.offset = offset;
+        chunk.size = findChunkBoundary(data.constData() + offset, data.size() - offset);
+        chunk.hash = hashData(QByteArray::fromRawData(data.constData() + offset, (int)chunk.size));
+        chunks.push_back(chunk);
+        offset += chunk.size;
+    }
+    return chunks;
+}
+
+} // namespace AssetUtils
@@ -0,0 +1,46 @@
+//
+//  AssetChunking.h
+//  libraries/networking/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunking_h
+#define hifi_AssetChunking_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+namespace AssetUtils {
+
+// Large assets are uploaded as chunks cut at boundaries picked by their content, with a gear hash in the manner of
+// FastCDC, so that an edit to an asset only changes the chunks around it and uploading the edited asset only has to
+// send those. The client and the asset server have to agree on the boundaries only as far as deduplication goes:
+// the server checks every chunk it is sent against its hash, and the whole asset against the asset hash.
+const int MIN_CHUNK_SIZE = 16 * 1024;
+const int AVERAGE_CHUNK_SIZE = 64 * 1024;
+const int MAX_CHUNK_SIZE = 256 * 1024;
+
+// smaller assets are uploaded whole
+const qint64 MIN_CHUNKED_UPLOAD_SIZE = 1024 * 1024;
+
+struct AssetChunk {
+    QByteArray hash;    // SHA256 of the chunk's data
+    qint64 offset { 0 };
+    qint64 size { 0 };
+};
+using AssetChunks = std::vector<AssetChunk>;
+
+// the size of the first chunk of data
+qint64 findChunkBoundary(const char* data, qint64 size);
+
+AssetChunks splitIntoChunks(const QByteArray& data);
+
+} // namespace AssetUtils
+
+#endif // hifi_AssetChunking_h
@@ -47,6 +47,7 @@ AssetClient::AssetClient() {
     packetReceiver.registerListener(PacketType::AssetGetInfoReply, this, "handleAssetGetInfoReply");
     packetReceiver.registerListener(PacketType::AssetGetReply, this, "handleAssetGetReply", true);
     packetReceiver.registerListener(PacketType::AssetUploadReply, this, "handleAssetUploadReply");
+    packetReceiver.registerListener(PacketType::AssetChunkQueryReply, this, "handleAssetChunkQueryReply");
 
     connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &AssetClient::handleNodeKilled);
     connect(nodeList.data(), &LimitedNodeList::clientConnectionToNodeReset,
@@ -921,6 +922,119 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
     return INVALID_MESSAGE_ID;
 }
 
+MessageID AssetClient::queryChunks(const AssetUtils::AssetChunks& chunks, ChunkQueryCallback callback) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+
+    if (assetServer) {
+        auto packetList = NLPacketList::create(PacketType::AssetChunkQuery, QByteArray(), true, true);
+
+        auto messageID = ++_currentID;
+        packetList->writePrimitive(messageID);
+
+        uint32_t numChunks = (uint32_t)chunks.size();
+        packetList->writePrimitive(numChunks);
+        for (const auto& chunk : chunks) {
+            packetList->write(chunk.hash);
+        }
+
+        if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+            _pendingChunkQueries[assetServer][messageID] = callback;
+
+            return messageID;
+        }
+    }
+
+    callback(false, AssetUtils::AssetServerError::NoError, std::vector<bool>());
+    return INVALID_MESSAGE_ID;
+}
+
+void AssetClient::handleAssetChunkQueryReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    AssetUtils::AssetServerError error;
+    message->readPrimitive(&error);
+
+    std::vector<bool> chunksPresent;
+    if (!error) {
+        uint32_t numChunks;
+        message->readPrimitive(&numChunks);
+
+        QByteArray present = message->read(numChunks);
+        chunksPresent.reserve(present.size());
+        for (char isPresent : present) {
+            chunksPresent.push_back(isPresent != 0);
+        }
+    }
+
+    // Check if we have any pending requests for this node
+    auto messageMapIt = _pendingChunkQueries.find(senderNode);
+    if (messageMapIt != _pendingChunkQueries.end()) {
+        auto& messageCallbackMap = messageMapIt->second;
+
+        auto requestIt = messageCallbackMap.find(messageID);
+        if (requestIt != messageCallbackMap.end()) {
+            auto callback = requestIt->second;
+            callback(true, error, chunksPresent);
+            messageCallbackMap.erase(requestIt);
+        }
+    }
+}
+
+MessageID AssetClient::uploadChunkedAsset(const QByteArray& data, const AssetUtils::AssetChunks& chunks,
+                                          const std::vector<bool>& chunksPresent, UploadResultCallback callback) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+
+    if (assetServer) {
+        auto packetList = NLPacketList::create(PacketType::AssetChunkedUpload, QByteArray(), true, true);
+
+        auto messageID = ++_currentID;
+        packetList->writePrimitive(messageID);
+
+        uint64_t size = data.length();
+        packetList->writePrimitive(size);
+
+        uint32_t numChunks = (uint32_t)chunks.size();
+        packetList->writePrimitive(numChunks);
+
+        uint64_t sentSize = 0;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            const auto& chunk = chunks[i];
+            packetList->write(chunk.hash);
+
+            uint32_t chunkSize = (uint32_t)chunk.size;
+            packetList->writePrimitive(chunkSize);
+
+            // the chunks the asset server has are sent as their hash alone
+            uint8_t hasData = i < chunksPresent.size() && chunksPresent[i] ? 0 : 1;
+            packetList->writePrimitive(hasData);
+            if (hasData) {
+                packetList->write(data.constData() + chunk.offset, chunk.size);
+                sentSize += chunk.size;
+            }
+        }
+
+        qCDebug(asset_client) << "Uploading" << sentSize << "of" << size << "bytes of a chunked asset to asset-server";
+
+        if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+            _pendingUploads[assetServer][messageID] = callback;
+
+            return messageID;
+        }
+    }
+
+    callback(false, AssetUtils::AssetServerError::NoError, QString());
+    return INVALID_MESSAGE_ID;
+}
+
 void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -1032,4 +1146,14 @@ void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
             messageMapIt->second.clear();
         }
     }
+
+    {
+        auto messageMapIt = _pendingChunkQueries.find(node);
+        if (messageMapIt != _pendingChunkQueries.end()) {
+            for (const auto& value : messageMapIt->second) {
+                value.second(false, AssetUtils::AssetServerError::NoError, std::vector<bool>());
+            }
+            messageMapIt->second.clear();
+        }
+    }
 }
@@ -21,6 +21,7 @@
 #include <DependencyManager.h>
 #include <shared/MiniPromises.h>
 
+#include "AssetChunking.h"
 #include "AssetUtils.h"
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
@@ -47,6 +48,7 @@ using ReceivedAssetCallback = std::function<void(bool responseReceived, AssetUti
 using GetInfoCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info)>;
 using UploadResultCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, const QString& hash)>;
 using ProgressCallback = std::function<void(qint64 totalReceived, qint64 total)>;
+using ChunkQueryCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, const std::vector<bool>& chunksPresent)>;
 
 class AssetClient : public QObject, public Dependency {
     Q_OBJECT
@@ -78,6 +80,7 @@ private slots:
     void handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetGetReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetChunkQueryReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void handleNodeKilled(SharedNodePointer node);
     void handleNodeClientConnectionReset(SharedNodePointer node);
@@ -95,6 +98,13 @@ private:
                   ReceivedAssetCallback callback, ProgressCallback progressCallback);
     MessageID uploadAsset(const QByteArray& data, UploadResultCallback callback);
 
+    // asks which of the chunks the asset server already has
+    MessageID queryChunks(const AssetUtils::AssetChunks& chunks, ChunkQueryCallback callback);
+
+    // uploads an asset as its chunks, sending the data of only those the asset server doesn't have
+    MessageID uploadChunkedAsset(const QByteArray& data, const AssetUtils::AssetChunks& chunks,
+                                 const std::vector<bool>& chunksPresent, UploadResultCallback callback);
+
     bool cancelMappingRequest(MessageID id);
     bool cancelGetAssetInfoRequest(MessageID id);
     bool cancelGetAssetRequest(MessageID id);
@@ -116,6 +126,7 @@ private:
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetAssetRequestData>> _pendingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadResultCallback>> _pendingUploads;
+    std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, ChunkQueryCallback>> _pendingChunkQueries;
 
     QString _cacheDir;
 
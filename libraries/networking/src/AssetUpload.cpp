@@ -14,6 +14,7 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QThread>
 
+#include "AssetChunking.h"
 #include "AssetClient.h"
 #include "NetworkLogging.h"
 
@@ -74,40 +75,77 @@ void AssetUpload::start() {
         }
     }
     
-    // ask the AssetClient to upload the asset and emit the proper signals from the passed callback
-    auto assetClient = DependencyManager::get<AssetClient>();
-   
     if (!_filename.isEmpty()) {
         qCDebug(asset_client) << "Attempting to upload" << _filename << "to asset-server.";
     }
-    
-    assetClient->uploadAsset(_data, [this](bool responseReceived, AssetUtils::AssetServerError error, const QString& hash){
-        if (!responseReceived) {
-            _error = NetworkError;
-        } else {
-            switch (error) {
-                case AssetUtils::AssetServerError::NoError:
-                    _error = NoError;
-                    break;
-                case AssetUtils::AssetServerError::AssetTooLarge:
-                    _error = TooLarge;
-                    break;
-                case AssetUtils::AssetServerError::PermissionDenied:
-                    _error = PermissionDenied;
-                    break;
-                case AssetUtils::AssetServerError::FileOperationFailed:
-                    _error = ServerFileError;
-                    break;
-                default:
-                    _error = FileOpenError;
-                    break;
-            }
-        }
-        
-        if (_error == NoError && hash == AssetUtils::hashData(_data).toHex()) {
-            AssetUtils::saveToCache(AssetUtils::getATPUrl(hash), _data);
+
+    if (_data.size() >= AssetUtils::MIN_CHUNKED_UPLOAD_SIZE) {
+        uploadChunked();
+    } else {
+        uploadWhole();
+    }
+}
+
+void AssetUpload::uploadChunked() {
+    // ask the asset server which chunks it already has, and send it the rest
+    auto chunks = AssetUtils::splitIntoChunks(_data);
+    auto assetClient = DependencyManager::get<AssetClient>();
+    assetClient->queryChunks(chunks, [this, chunks](bool responseReceived, AssetUtils::AssetServerError error,
+                                                   const std::vector<bool>& chunksPresent) {
+        if (!responseReceived || error != AssetUtils::AssetServerError::NoError) {
+            handleResult(responseReceived, error, QString());
+            return;
         }
-        
-        emit finished(this, hash);
+
+        auto assetClient = DependencyManager::get<AssetClient>();
+        assetClient->uploadChunkedAsset(_data, chunks, chunksPresent, [this](bool responseReceived,
+                                                                            AssetUtils::AssetServerError error,
+                                                                            const QString& hash) {
+            if (responseReceived && error == AssetUtils::AssetServerError::ChunksMissing) {
+                // chunks it had when we asked were removed before the upload arrived
+                qCDebug(asset_client) << "Asset-server is missing chunks of" << _filename << "- uploading it whole.";
+                uploadWhole();
+                return;
+            }
+            handleResult(responseReceived, error, hash);
+        });
+    });
+}
+
+void AssetUpload::uploadWhole() {
+    // ask the AssetClient to upload the asset and emit the proper signals from the passed callback
+    auto assetClient = DependencyManager::get<AssetClient>();
+    assetClient->uploadAsset(_data, [this](bool responseReceived, AssetUtils::AssetServerError error, const QString& hash) {
+        handleResult(responseReceived, error, hash);
     });
 }
+
+void AssetUpload::handleResult(bool responseReceived, AssetUtils::AssetServerError error, const QString& hash) {
+    if (!responseReceived) {
+        _error = NetworkError;
+    } else {
+        switch (error) {
+            case AssetUtils::AssetServerError::NoError:
+                _error = NoError;
+                break;
+            case AssetUtils::AssetServerError::AssetTooLarge:
+                _error = TooLarge;
+                break;
+            case AssetUtils::AssetServerError::PermissionDenied:
+                _error = PermissionDenied;
+                break;
+            case AssetUtils::AssetServerError::FileOperationFailed:
+                _error = ServerFileError;
+                break;
+            default:
+                _error = FileOpenError;
+                break;
+        }
+    }
+
+    if (_error == NoError && hash == AssetUtils::hashData(_data).toHex()) {
+        AssetUtils::saveToCache(AssetUtils::getATPUrl(hash), _data);
+    }
+
+    emit finished(this, hash);
+}
@@ -79,6 +79,22 @@ bool HMACAuth::setKey(const QUuid& uidKey) {
     return setKey(rfcBytes.constData(), rfcBytes.length());
 }
 
+bool HMACAuth::copyKeyTo(HMACAuth& other) {
+    if (&other == this) {
+        return true;
+    }
+
+    QMutexLocker lock(&_lock);
+    QMutexLocker otherLock(&other._lock);
+    other._authMethod = _authMethod;
+#if OPENSSL_VERSION_NUMBER < 0x10100000
+    // the copy doesn't free what the destination already holds
+    HMAC_CTX_cleanup(other._hmacContext);
+    HMAC_CTX_init(other._hmacContext);
+#endif
+    return (bool) HMAC_CTX_copy(other._hmacContext, _hmacContext);
+}
+
 bool HMACAuth::addData(const char* data, int dataLen) {
     QMutexLocker lock(&_lock);
     return (bool) HMAC_Update(_hmacContext, reinterpret_cast<const unsigned char*>(data), dataLen);
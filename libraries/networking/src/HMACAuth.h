@@ -28,6 +28,8 @@ public:
 
     bool setKey(const char* keyValue, int keyLen);
     bool setKey(const QUuid& uidKey);
+    // Copy the keyed state into another instance, which can then hash without waiting on this one's lock.
+    bool copyKeyTo(HMACAuth& other);
     // Calculate complete hash in one.
     bool calculateHash(HMACHash& hashResult, const char* data, int dataLen);
 
@@ -14,10 +14,13 @@
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
+#include <condition_variable>
+#include <mutex>
 
 #include <QtCore/QDataStream>
 #include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QRunnable>
 #include <QtCore/QThread>
 #include <QtCore/QUrl>
 #include <QtNetwork/QTcpSocket>
@@ -49,6 +52,10 @@ static Setting::Handle<quint16> LIMITED_NODELIST_LOCAL_PORT("LimitedNodeList.Loc
 using namespace std::chrono_literals;
 static const std::chrono::milliseconds CONNECTION_RATE_INTERVAL_MS = 1s;
 
+// below this many hashes in one received batch it is quicker to do them inline than to wake the pool
+static const int MIN_PARALLEL_PACKET_HASHES = 16;
+static const int MAX_PACKET_HASH_THREADS = 3;
+
 LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     _nodeSocket(this),
     _packetReceiver(new PacketReceiver(this))
@@ -112,6 +119,12 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     using std::placeholders::_1;
     _nodeSocket.setPacketFilterOperator(std::bind(&LimitedNodeList::isPacketVerified, this, _1));
 
+    // hash the packets of a received batch in parallel before they are verified one by one, whichever filter is used
+    _packetHashPool.setMaxThreadCount(std::min(QThread::idealThreadCount() - 1, MAX_PACKET_HASH_THREADS));
+    if (_packetHashPool.maxThreadCount() > 0) {
+        _nodeSocket.setPacketBatchPrefilterOperator(std::bind(&LimitedNodeList::prefilterPacketBatch, this, _1));
+    }
+
     // set our socketBelongsToNode method as the connection creation filter operator for the udt::Socket
     _nodeSocket.setConnectionCreationFilterOperator(std::bind(&LimitedNodeList::sockAddrBelongsToNode, this, _1));
 
@@ -351,7 +364,12 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
                 QByteArray expectedHash;
                 auto sourceNodeHMACAuth = sourceNode->getAuthenticateHash();
                 if (sourceNode->getAuthenticateHash()) {
-                    expectedHash = NLPacket::hashForPacketAndHMAC(packet, *sourceNodeHMACAuth);
+                    auto prefilteredHash = _prefilteredPacketHashes.find(&packet);
+                    if (prefilteredHash != _prefilteredPacketHashes.end()) {
+                        expectedHash = prefilteredHash->second;
+                    } else {
+                        expectedHash = hashForReceivedPacket(packet, *sourceNodeHMACAuth);
+                    }
                 }
 
                 // check if the HMAC-md5 hash in the header matches the hash we would expect
@@ -385,6 +403,122 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
     return false;
 }
 
+QByteArray LimitedNodeList::hashForReceivedPacket(const udt::Packet& packet, HMACAuth& hmacAuth) {
+    auto start = usecTimestampNow();
+    auto hash = NLPacket::hashForPacketAndHMAC(packet, hmacAuth);
+    _verifyUsecs += usecTimestampNow() - start;
+    ++_verifiedPackets;
+    return hash;
+}
+
+namespace {
+
+// hands out the jobs of one prefiltered batch, shared with pool threads that may only start once it is done
+struct PacketHashJobs {
+    std::vector<std::pair<const udt::Packet*, SharedNodePointer>> packets;
+    std::vector<QByteArray> hashes;
+    std::atomic<size_t> next { 0 };
+    LimitedNodeList* nodeList { nullptr };
+
+    // threads that may still be hashing, the socket thread waits for these before using the hashes
+    std::mutex activeThreadsMutex;
+    std::condition_variable activeThreadsDone;
+    int activeThreads { 0 };
+};
+
+}
+
+class PacketHashRunnable : public QRunnable {
+public:
+    PacketHashRunnable(std::shared_ptr<PacketHashJobs> jobs, std::function<void(PacketHashJobs&)> work) :
+        _jobs(jobs), _work(work) {}
+
+    void run() override { _work(*_jobs); }
+
+private:
+    std::shared_ptr<PacketHashJobs> _jobs;
+    std::function<void(PacketHashJobs&)> _work;
+};
+
+void LimitedNodeList::prefilterPacketBatch(const std::vector<const udt::Packet*>& packets) {
+    _prefilteredPacketHashes.clear();
+    if (packets.empty() || !_useAuthentication) {
+        // an empty batch is the socket telling us the last batch has been processed
+        return;
+    }
+
+    // collect the packets that will need a hash, skipping anything the filter will reject before hashing
+    auto jobs = std::make_shared<PacketHashJobs>();
+    for (auto packet : packets) {
+        PacketType headerType = NLPacket::typeInHeader(*packet);
+        if (NLPacket::versionInHeader(*packet) != versionForPacketType(headerType) ||
+            PacketTypeEnum::getNonSourcedPackets().contains(headerType) ||
+            PacketTypeEnum::getNonVerifiedPackets().contains(headerType) ||
+            (isDomainServer() && PacketTypeEnum::getDomainIgnoredVerificationPackets().contains(headerType))) {
+            continue;
+        }
+
+        auto sourceNode = nodeWithLocalID(NLPacket::sourceIDInHeader(*packet));
+        if (sourceNode && sourceNode->getAuthenticateHash()) {
+            jobs->packets.emplace_back(packet, sourceNode);
+        }
+    }
+
+    if ((int)jobs->packets.size() < MIN_PARALLEL_PACKET_HASHES) {
+        return;
+    }
+
+    jobs->hashes.resize(jobs->packets.size());
+    jobs->nodeList = this;
+
+    auto work = [](PacketHashJobs& jobs) {
+        {
+            std::lock_guard<std::mutex> lock(jobs.activeThreadsMutex);
+            ++jobs.activeThreads;
+        }
+
+        // hash with this thread's own copy of each node's HMAC context, rather than taking turns on the node's lock
+        // with the other threads hashing packets from the same node, and with any thread signing packets for it
+        HMACAuth threadHMACAuth;
+        const Node* keyedNode = nullptr;
+        bool hasKey = false;
+
+        size_t index;
+        while ((index = jobs.next++) < jobs.packets.size()) {
+            auto& job = jobs.packets[index];
+            HMACAuth& nodeHMACAuth = *job.second->getAuthenticateHash();
+            if (job.second.data() != keyedNode) {
+                keyedNode = job.second.data();
+                hasKey = nodeHMACAuth.copyKeyTo(threadHMACAuth);
+            }
+            jobs.hashes[index] = jobs.nodeList->hashForReceivedPacket(*job.first, hasKey ? threadHMACAuth : nodeHMACAuth);
+        }
+
+        std::lock_guard<std::mutex> lock(jobs.activeThreadsMutex);
+        if (--jobs.activeThreads == 0) {
+            jobs.activeThreadsDone.notify_all();
+        }
+    };
+
+    int numHelpers = std::min(_packetHashPool.maxThreadCount(), (int)jobs->packets.size() - 1);
+    for (int i = 0; i < numHelpers; ++i) {
+        _packetHashPool.start(new PacketHashRunnable(jobs, work));
+    }
+
+    // hash alongside the pool, then wait out any hash still in flight on another thread
+    // (helpers that only start after this has nothing left to do and never touch the packets)
+    work(*jobs);
+    {
+        std::unique_lock<std::mutex> lock(jobs->activeThreadsMutex);
+        jobs->activeThreadsDone.wait(lock, [&jobs] { return jobs->activeThreads == 0; });
+    }
+
+    for (size_t i = 0; i < jobs->packets.size(); ++i) {
+        _prefilteredPacketHashes.emplace(jobs->packets[i].first, std::move(jobs->hashes[i]));
+    }
+    _parallelVerifiedPackets += jobs->packets.size();
+}
+
 void LimitedNodeList::fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAuth) {
     if (!PacketTypeEnum::getNonSourcedPackets().contains(packet.getType())) {
         packet.writeSourceID(getSessionLocalID());
@@ -393,7 +527,10 @@ void LimitedNodeList::fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAut
     if (_useAuthentication && hmacAuth
         && !PacketTypeEnum::getNonSourcedPackets().contains(packet.getType())
         && !PacketTypeEnum::getNonVerifiedPackets().contains(packet.getType())) {
+        auto start = usecTimestampNow();
         packet.writeVerificationHash(*hmacAuth);
+        _signUsecs += usecTimestampNow() - start;
+        ++_signedPackets;
     }
 }
 
@@ -590,6 +727,17 @@ SharedNodePointer LimitedNodeList::nodeWithLocalID(Node::LocalID localID) const
     return idIter == _localIDMap.cend() ? nullptr : idIter->second;
 }
 
+void LimitedNodeList::updateNodeSnapshot() {
+    auto snapshot = std::make_shared<NodeSnapshot>();
+    snapshot->reserve(_nodeHash.size());
+    for (const auto& pair : _nodeHash) {
+        snapshot->push_back(pair.second);
+    }
+
+    // readers holding the previous snapshot keep it (and its nodes) alive until they are done with it
+    std::atomic_store(&_nodeSnapshot, std::shared_ptr<const NodeSnapshot>(std::move(snapshot)));
+}
+
 void LimitedNodeList::eraseAllNodes(QString reason) {
     std::vector<SharedNodePointer> killedNodes;
 
@@ -608,6 +756,7 @@ void LimitedNodeList::eraseAllNodes(QString reason) {
         }
         _localIDMap.clear();
         _nodeHash.clear();
+        updateNodeSnapshot();
     }
 
     foreach(const SharedNodePointer& killedNode, killedNodes) {
@@ -633,6 +782,7 @@ bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID, ConnectionID newCo
             QWriteLocker writeLocker(&_nodeMutex);
             _localIDMap.unsafe_erase(matchingNode->getLocalID());
             _nodeHash.unsafe_erase(matchingNode->getUUID());
+            updateNodeSnapshot();
         }
 
         handleNodeKill(matchingNode, newConnectionID);
@@ -693,6 +843,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
                 QWriteLocker writeLocker(&_nodeMutex);
                 _localIDMap.unsafe_erase(node->getLocalID());
                 _nodeHash.unsafe_erase(node->getUUID());
+                updateNodeSnapshot();
             }
             handleNodeKill(node);
         }
@@ -733,10 +884,11 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
 
 
     {
-        QReadLocker readLocker(&_nodeMutex);
-        // insert the new node and release our read lock
+        // a write lock, so that snapshots are published in the order the hash changed
+        QWriteLocker writeLocker(&_nodeMutex);
         _nodeHash.insert({ newNode->getUUID(), newNodePointer });
         _localIDMap.insert({ localID, newNodePointer });
+        updateNodeSnapshot();
     }
 
     qCDebug(networking) << "Added" << *newNode;
@@ -955,6 +1107,15 @@ void LimitedNodeList::sampleConnectionStats() {
         elapsedCount++;
     }
 
+    // the sample timer fires every second, so these are per-second system call and datagram counts
+    _socketIOStats = _nodeSocket.sampleIOStats();
+
+    _packetVerificationStats.verifiedPackets = _verifiedPackets.exchange(0);
+    _packetVerificationStats.verifyUsecs = _verifyUsecs.exchange(0);
+    _packetVerificationStats.parallelVerifiedPackets = _parallelVerifiedPackets.exchange(0);
+    _packetVerificationStats.signedPackets = _signedPackets.exchange(0);
+    _packetVerificationStats.signUsecs = _signUsecs.exchange(0);
+
     if (elapsedCount > 0) {
         float elapsedAvg = (float)elapsedSum / elapsedCount;
         float factor = USECS_PER_SECOND / elapsedAvg;
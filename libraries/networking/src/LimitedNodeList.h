@@ -18,6 +18,7 @@
 #include <memory>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #ifndef _WIN32
 #include <unistd.h> // not on windows, not needed for mac or windows
@@ -28,6 +29,7 @@
 #include <QtCore/QReadWriteLock>
 #include <QtCore/QSet>
 #include <QtCore/QSharedMemory>
+#include <QtCore/QThreadPool>
 #include <QtNetwork/QUdpSocket>
 #include <QtNetwork/QHostAddress>
 
@@ -73,6 +75,9 @@ const ConnectionID INITIAL_CONNECTION_ID { 0 };
 typedef std::pair<QUuid, SharedNodePointer> UUIDNodePair;
 typedef tbb::concurrent_unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
 
+// An immutable copy of the nodes in a NodeHash, replaced (never modified) whenever a node is added or removed
+typedef std::vector<SharedNodePointer> NodeSnapshot;
+
 typedef quint8 PingType_t;
 namespace PingType {
     const PingType_t Agnostic = 0;
@@ -205,73 +210,52 @@ public:
     using value_type = SharedNodePointer;
     using const_iterator = std::vector<value_type>::const_iterator;
 
-    // Cede control of iteration under a single read lock (e.g. for use by thread pools)
-    // Use this for nested loops instead of taking nested read locks!
-    //   This allows multiple threads (i.e. a thread pool) to share a lock
-    //   without deadlocking when a dying node attempts to acquire a write lock
-    template<typename NestedNodeLambda>
-    void nestedEach(NestedNodeLambda functor,
-                    int* lockWaitOut = nullptr,
-                    int* nodeTransformOut = nullptr,
-                    int* functorOut = nullptr) {
-        quint64 start, endTransform, endFunctor;
-
-        start = usecTimestampNow();
-        std::vector<SharedNodePointer> nodes;
-        {
-            QReadLocker readLock(&_nodeMutex);
-            auto endLock = usecTimestampNow();
-            if (lockWaitOut) {
-                *lockWaitOut = (endLock - start);
-            }
+    // The nodes as of the last time one was added or removed.
+    // Iterating it needs no lock, and the nodes in it stay alive for as long as the snapshot is held. Getting it isn't
+    // lock free: std::atomic_load of a shared_ptr takes a lock internal to the standard library for the moment it takes
+    // to bump the reference count. It never waits on _nodeMutex though, so readers aren't held up by a thread adding or
+    // removing nodes, and nothing is copied per call.
+    std::shared_ptr<const NodeSnapshot> getNodeSnapshot() const { return std::atomic_load(&_nodeSnapshot); }
 
-            // Size of _nodeHash could change at any time,
-            // so reserve enough memory for the current size
-            // and then back insert all the nodes found
-            nodes.reserve(_nodeHash.size());
-            std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(nodes), [&](const NodeHash::value_type& it) {
-                return it.second;
-            });
-
-            endTransform = usecTimestampNow();
-            if (nodeTransformOut) {
-                *nodeTransformOut = (endTransform - endLock);
-            }
-        }
+    // Cede control of iteration over the current node snapshot (e.g. for use by thread pools)
+    // Use this for nested loops, the iterators stay valid for the duration of the functor
+    template<typename NestedNodeLambda>
+    void nestedEach(NestedNodeLambda functor, int* functorOut = nullptr) {
+        auto nodes = getNodeSnapshot();
 
-        functor(nodes.cbegin(), nodes.cend());
-        endFunctor = usecTimestampNow();
+        quint64 start = usecTimestampNow();
+        functor(nodes->cbegin(), nodes->cend());
         if (functorOut) {
-            *functorOut = (endFunctor - endTransform);
+            *functorOut = (usecTimestampNow() - start);
         }
     }
 
     template<typename NodeLambda>
     void eachNode(NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto nodes = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        for (const auto& node : *nodes) {
+            functor(node);
         }
     }
 
     template<typename PredLambda, typename NodeLambda>
     void eachMatchingNode(PredLambda predicate, NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto nodes = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                functor(it->second);
+        for (const auto& node : *nodes) {
+            if (predicate(node)) {
+                functor(node);
             }
         }
     }
 
     template<typename BreakableNodeLambda>
     void eachNodeBreakable(BreakableNodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto nodes = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (!functor(it->second)) {
+        for (const auto& node : *nodes) {
+            if (!functor(node)) {
                 break;
             }
         }
@@ -279,11 +263,11 @@ public:
 
     template<typename PredLambda>
     SharedNodePointer nodeMatchingPredicate(const PredLambda predicate) {
-        QReadLocker readLock(&_nodeMutex);
+        auto nodes = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                return it->second;
+        for (const auto& node : *nodes) {
+            if (predicate(node)) {
+                return node;
             }
         }
 
@@ -335,6 +319,19 @@ public:
     int getOutboundPPS() const { return _outboundPPS; }
     float getInboundKbps() const { return _inboundKbps; }
     float getOutboundKbps() const { return _outboundKbps; }
+    const udt::Socket::IOStats& getSocketIOStats() const { return _socketIOStats; }
+
+    // HMAC work over the last stats interval, times are summed over every thread that did the hashing. Packets hashed
+    // in parallel use a private copy of the node's HMAC context; the rest share the node's, so their time can include
+    // waiting on a thread signing packets for the same node.
+    struct PacketVerificationStats {
+        uint64_t verifiedPackets { 0 };
+        uint64_t verifyUsecs { 0 };
+        uint64_t parallelVerifiedPackets { 0 }; // verified ahead of filtering by the verification pool
+        uint64_t signedPackets { 0 };
+        uint64_t signUsecs { 0 };
+    };
+    const PacketVerificationStats& getPacketVerificationStats() const { return _packetVerificationStats; }
 
     void setDropOutgoingNodeTraffic(bool squelchOutgoingNodeTraffic) { _dropOutgoingNodeTraffic = squelchOutgoingNodeTraffic; }
 
@@ -420,6 +417,8 @@ protected:
     void setLocalSocket(const HifiSockAddr& sockAddr);
 
     bool packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet, Node* sourceNode = nullptr);
+    void prefilterPacketBatch(const std::vector<const udt::Packet*>& packets);
+    QByteArray hashForReceivedPacket(const udt::Packet& packet, HMACAuth& hmacAuth);
     void processSTUNResponse(std::unique_ptr<udt::BasePacket> packet);
 
     void handleNodeKill(const SharedNodePointer& node, ConnectionID newConnectionID = NULL_CONNECTION_ID);
@@ -436,8 +435,12 @@ protected:
     void removeDelayedAdd(QUuid nodeUUID);
     bool isDelayedNode(QUuid nodeUUID);
 
+    // must be called with _nodeMutex locked for writing, after every change to _nodeHash
+    void updateNodeSnapshot();
+
     NodeHash _nodeHash;
     mutable QReadWriteLock _nodeMutex { QReadWriteLock::Recursive };
+    std::shared_ptr<const NodeSnapshot> _nodeSnapshot { std::make_shared<const NodeSnapshot>() };
     udt::Socket _nodeSocket;
     QUdpSocket* _dtlsSocket { nullptr };
     HifiSockAddr _localSockAddr;
@@ -464,11 +467,16 @@ protected:
     template<typename IteratorLambda>
     void eachNodeHashIterator(IteratorLambda functor) {
         QWriteLocker writeLock(&_nodeMutex);
+        auto sizeBefore = _nodeHash.size();
         NodeHash::iterator it = _nodeHash.begin();
 
         while (it != _nodeHash.end()) {
             functor(it);
         }
+
+        if (_nodeHash.size() != sizeBefore) {
+            updateNodeSnapshot();
+        }
     }
 
     std::unordered_map<QUuid, ConnectionID> _connectionIDs;
@@ -497,6 +505,19 @@ private:
     int _outboundPPS { 0 };
     float _inboundKbps { 0.0f };
     float _outboundKbps { 0.0f };
+    udt::Socket::IOStats _socketIOStats;
+
+    // hashes for the packets of the batch being filtered, computed ahead of time on _packetHashPool
+    // (only touched on the socket thread)
+    QThreadPool _packetHashPool;
+    std::unordered_map<const udt::Packet*, QByteArray> _prefilteredPacketHashes;
+
+    std::atomic<uint64_t> _verifiedPackets { 0 };
+    std::atomic<uint64_t> _verifyUsecs { 0 };
+    std::atomic<uint64_t> _parallelVerifiedPackets { 0 };
+    std::atomic<uint64_t> _signedPackets { 0 };
+    std::atomic<uint64_t> _signUsecs { 0 };
+    PacketVerificationStats _packetVerificationStats;
 
     bool _dropOutgoingNodeTraffic { false };
 
@@ -13,6 +13,7 @@
 #include "PacketReceiver.h"
 
 #include <QMutexLocker>
+#include <QThread>
 
 #include "DependencyManager.h"
 #include "NetworkLogging.h"
@@ -23,6 +24,10 @@ PacketReceiver::PacketReceiver(QObject* parent) : QObject(parent) {
     qRegisterMetaType<QSharedPointer<NLPacket>>();
     qRegisterMetaType<QSharedPointer<NLPacketList>>();
     qRegisterMetaType<QSharedPointer<ReceivedMessage>>();
+
+    for (auto& typedListener : _typedListeners) {
+        typedListener.store(nullptr, std::memory_order_relaxed);
+    }
 }
 
 bool PacketReceiver::registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot) {
@@ -169,15 +174,55 @@ void PacketReceiver::registerVerifiedListener(PacketType type, QObject* object,
     Q_ASSERT_X(object, "PacketReceiver::registerVerifiedListener", "No object to register");
     QMutexLocker locker(&_packetListenerLock);
 
-    if (_messageListenerMap.contains(type)) {
+    if (_messageListenerMap.contains(type) || _typedListeners[(size_t)type].load()) {
         qCWarning(networking) << "Registering a packet listener for packet type" << type
             << "that will remove a previously registered listener";
     }
-    
+
+    // a slot replaces any typed handler for the type
+    if (_typedListeners[(size_t)type].exchange(nullptr)) {
+        _hasStaleTypedListeners = true;
+        pruneTypedListeners();
+    }
+
     // add the mapping
     _messageListenerMap[type] = { QPointer<QObject>(object), slot, deliverPending };
 }
 
+bool PacketReceiver::registerMessageHandler(PacketType type, QObject* listener, MessageHandler handler,
+                                            Delivery delivery, bool deliverPending) {
+    Q_ASSERT_X(listener, "PacketReceiver::registerMessageHandler", "No object to register");
+    Q_ASSERT_X(handler, "PacketReceiver::registerMessageHandler", "No handler to register");
+
+    if (!listener || !handler || (size_t)type >= NUM_PACKET_TYPES) {
+        qCWarning(networking) << "FAILED to Register a packet handler for packet type" << type;
+        return false;
+    }
+
+    QMutexLocker locker(&_packetListenerLock);
+
+    auto it = _messageListenerMap.find(type);
+    if ((it != _messageListenerMap.end() && it->object) || _typedListeners[(size_t)type].load()) {
+        qCWarning(networking) << "Registering a packet handler for packet type" << type
+            << "that will remove a previously registered listener";
+    }
+
+    // a typed handler replaces any slot for the type, including the dummy for previously unhandled types
+    if (it != _messageListenerMap.end()) {
+        _messageListenerMap.erase(it);
+    }
+
+    _typedListenerStorage.emplace_back(new TypedListener { QPointer<QObject>(listener), std::move(handler),
+                                                           delivery, deliverPending });
+    if (_typedListeners[(size_t)type].exchange(_typedListenerStorage.back().get())) {
+        _hasStaleTypedListeners = true;
+    }
+    pruneTypedListeners();
+
+    qCDebug(networking) << "Registering a packet handler for packet type" << type;
+    return true;
+}
+
 void PacketReceiver::unregisterListener(QObject* listener) {
     Q_ASSERT_X(listener, "PacketReceiver::unregisterListener", "No listener to unregister");
     
@@ -194,12 +239,49 @@ void PacketReceiver::unregisterListener(QObject* listener) {
                 ++it;
             }
         }
+
+        // and any typed handlers it registered
+        for (auto& typedListener : _typedListeners) {
+            auto current = typedListener.load();
+            if (current && current->object == listener) {
+                typedListener.store(nullptr);
+                _hasStaleTypedListeners = true;
+            }
+        }
+        pruneTypedListeners();
     }
     
     QMutexLocker directConnectSetLocker(&_directConnectSetMutex);
     _directlyConnectedObjects.remove(listener);
 }
 
+void PacketReceiver::pruneTypedListeners() {
+    // listeners destroyed without unregistering are noticed here, or flagged when a packet comes in for them
+    for (auto& typedListener : _typedListeners) {
+        auto current = typedListener.load();
+        if (current && !current->object) {
+            typedListener.store(nullptr);
+            _hasStaleTypedListeners = true;
+        }
+    }
+
+    // a dispatch that started before an entry was replaced may still be using it; one that starts after this
+    // check can only find the entries still in _typedListeners, which only change with the lock held
+    if (!_hasStaleTypedListeners || _numTypedDispatches > 0) {
+        return;
+    }
+    _hasStaleTypedListeners = false;
+
+    auto isStale = [this](const std::unique_ptr<TypedListener>& stored) {
+        return std::none_of(_typedListeners.begin(), _typedListeners.end(),
+                            [&stored](const std::atomic<TypedListener*>& typedListener) {
+            return typedListener.load() == stored.get();
+        });
+    };
+    _typedListenerStorage.erase(std::remove_if(_typedListenerStorage.begin(), _typedListenerStorage.end(), isStale),
+                                _typedListenerStorage.end());
+}
+
 void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
     // if we're supposed to drop this packet then break out here
     if (_shouldDropPackets) {
@@ -223,15 +305,15 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
     QSharedPointer<ReceivedMessage> message;
 
     if (it == _pendingMessages.end()) {
-        // Create message
-        message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+        // Create message, which keeps the packets it is made of rather than copying them into one buffer
+        message = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
         if (!message->isComplete()) {
             _pendingMessages[key] = message;
         }
         handleVerifiedMessage(message, true);
     } else {
         message = it->second;
-        message->appendPacket(*nlPacket);
+        message->appendPacket(std::move(nlPacket));
 
         if (message->isComplete()) {
             _pendingMessages.erase(it);
@@ -258,6 +340,11 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
     if (receivedMessage->getSourceID() != Node::NULL_LOCAL_ID) {
         matchingNode = nodeList->nodeWithLocalID(receivedMessage->getSourceID());
     }
+
+    if (handleTypedMessage(receivedMessage, justReceived, matchingNode)) {
+        return;
+    }
+
     QMutexLocker packetListenerLocker(&_packetListenerLock);
     
     auto it = _messageListenerMap.find(receivedMessage->getType());
@@ -326,3 +413,43 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
         _messageListenerMap.insert(receivedMessage->getType(), { nullptr, QMetaMethod(), false });
     }
 }
+
+bool PacketReceiver::handleTypedMessage(const QSharedPointer<ReceivedMessage>& message, bool justReceived,
+                                        const SharedNodePointer& matchingNode) {
+    // the listener can't be freed until this dispatch is done with it, see pruneTypedListeners
+    ++_numTypedDispatches;
+    TypedListener* listener = _typedListeners[(size_t)message->getType()].load();
+    bool handled = listener != nullptr;
+
+    if (listener && ((listener->deliverPending && justReceived) || (!listener->deliverPending && message->isComplete()))) {
+        QObject* object = listener->object.data();
+        if (!object) {
+            qCDebug(networking).nospace() << "Handler for packet " << message->getType()
+                << " has been destroyed. Removing from handler map.";
+
+            // removed by the prune below, which is the only place entries are freed
+            _hasStaleTypedListeners = true;
+        } else if (listener->delivery == Delivery::Inline || object->thread() == QThread::currentThread() ||
+                   isDirectlyConnected(object)) {
+            listener->handler(message, matchingNode);
+        } else {
+            // the call is dropped if object is destroyed first
+            QMetaObject::invokeMethod(object, [handler = listener->handler, message, matchingNode] {
+                handler(message, matchingNode);
+            }, Qt::QueuedConnection);
+        }
+    }
+
+    // free what was replaced while no dispatch was running, when registration couldn't
+    if (--_numTypedDispatches == 0 && _hasStaleTypedListeners) {
+        QMutexLocker locker(&_packetListenerLock);
+        pruneTypedListeners();
+    }
+
+    return handled;
+}
+
+bool PacketReceiver::isDirectlyConnected(QObject* object) {
+    QMutexLocker directConnectLocker(&_directConnectSetMutex);
+    return _directlyConnectedObjects.contains(object);
+}
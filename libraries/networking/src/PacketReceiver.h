@@ -13,6 +13,10 @@
 #ifndef hifi_PacketReceiver_h
 #define hifi_PacketReceiver_h
 
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
@@ -58,6 +62,49 @@ public:
     bool registerListener(PacketType type, QObject* listener, const char* slot, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
     void unregisterListener(QObject* listener);
+
+    // How a typed handler is called:
+    //   Inline runs it on the thread that received the packet, so the handler must be thread-safe.
+    //   OnListenerThread runs it on the listener's thread - directly if the packet was received there,
+    //   through the listener's event queue otherwise (the behaviour of registerListener slots).
+    enum class Delivery { Inline, OnListenerThread };
+
+    using MessageHandler = std::function<void(QSharedPointer<ReceivedMessage>, SharedNodePointer)>;
+
+    // Typed registration: handlers are looked up without locking and called without QMetaMethod::invoke.
+    // A typed handler replaces any slot registered for the same type (and vice versa), and is dropped
+    // when the listener is destroyed or passed to unregisterListener.
+    template <typename T>
+    bool registerHandler(PacketType type, T* listener,
+                         void (T::*handler)(QSharedPointer<ReceivedMessage>, SharedNodePointer),
+                         Delivery delivery = Delivery::OnListenerThread, bool deliverPending = false) {
+        return registerMessageHandler(type, listener,
+            [listener, handler](QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+                (listener->*handler)(message, node);
+            }, delivery, deliverPending);
+    }
+
+    template <typename T>
+    bool registerHandler(PacketType type, T* listener, void (T::*handler)(QSharedPointer<ReceivedMessage>),
+                         Delivery delivery = Delivery::OnListenerThread, bool deliverPending = false) {
+        return registerMessageHandler(type, listener,
+            [listener, handler](QSharedPointer<ReceivedMessage> message, SharedNodePointer) {
+                (listener->*handler)(message);
+            }, delivery, deliverPending);
+    }
+
+    template <typename T, typename Handler>
+    bool registerHandlerForTypes(PacketTypeList types, T* listener, Handler handler,
+                                 Delivery delivery = Delivery::OnListenerThread) {
+        bool success = true;
+        for (auto type : types) {
+            success &= registerHandler(type, listener, handler, delivery);
+        }
+        return success;
+    }
+
+    bool registerMessageHandler(PacketType type, QObject* listener, MessageHandler handler,
+                                Delivery delivery = Delivery::OnListenerThread, bool deliverPending = false);
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
     void handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> message);
@@ -70,8 +117,23 @@ private:
         bool deliverPending;
     };
 
+    struct TypedListener {
+        QPointer<QObject> object;
+        MessageHandler handler;
+        Delivery delivery;
+        bool deliverPending;
+    };
+
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
 
+    // returns false if there is no typed handler for the message type
+    bool handleTypedMessage(const QSharedPointer<ReceivedMessage>& message, bool justReceived,
+                            const SharedNodePointer& matchingNode);
+
+    // whether the object was registered through registerDirectListener, to be called from whichever thread
+    // receives its packets
+    bool isDirectlyConnected(QObject* object);
+
     // these are brutal hacks for now - ideally GenericThread / ReceivedPacketProcessor
     // should be changed to have a true event loop and be able to handle our QMetaMethod::invoke
     void registerDirectListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
@@ -83,6 +145,18 @@ private:
     QMutex _packetListenerLock;
     QHash<PacketType, Listener> _messageListenerMap;
 
+    // frees the typed listeners no longer in _typedListeners, once no packet is being dispatched to one;
+    // called with _packetListenerLock held
+    void pruneTypedListeners();
+
+    // read without locking for every packet; a replaced or unregistered entry stays in the storage until
+    // no dispatch that could have read it is still running, so that a reader racing a change still calls a valid handler
+    static const size_t NUM_PACKET_TYPES = (size_t)PacketType::NUM_PACKET_TYPE;
+    std::array<std::atomic<TypedListener*>, NUM_PACKET_TYPES> _typedListeners;
+    std::vector<std::unique_ptr<TypedListener>> _typedListenerStorage; // guarded by _packetListenerLock
+    std::atomic<int> _numTypedDispatches { 0 };
+    std::atomic<bool> _hasStaleTypedListeners { false };
+
     bool _shouldDropPackets = false;
     QMutex _directConnectSetMutex;
     QSet<QObject*> _directlyConnectedObjects;
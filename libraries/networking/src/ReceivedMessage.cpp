@@ -26,6 +26,7 @@ using namespace std::chrono;
 ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
     : _data(packetList.getMessage()),
       _headData(_data.mid(0, HEAD_DATA_SIZE)),
+      _size(_data.size()),
       _numPackets(packetList.getNumPackets()),
       _sourceID(packetList.getSourceID()),
       _packetType(packetList.getType()),
@@ -38,6 +39,7 @@ ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
 ReceivedMessage::ReceivedMessage(NLPacket& packet)
     : _data(packet.readAll()),
       _headData(_data.mid(0, HEAD_DATA_SIZE)),
+      _size(_data.size()),
       _numPackets(1),
       _sourceID(packet.getSourceID()),
       _packetType(packet.getType()),
@@ -48,10 +50,33 @@ ReceivedMessage::ReceivedMessage(NLPacket& packet)
     _firstPacketReceiveTime = duration_cast<microseconds>(packet.getReceiveTime().time_since_epoch()).count();
 }
 
+ReceivedMessage::ReceivedMessage(std::unique_ptr<NLPacket> packet)
+    : _headData(packet->getPayload(), (int)std::min(packet->getPayloadSize(), (qint64)HEAD_DATA_SIZE)),
+      _size(packet->getPayloadSize()),
+      _numPackets(1),
+      _sourceID(packet->getSourceID()),
+      _packetType(packet->getType()),
+      _packetVersion(packet->getVersion()),
+      _senderSockAddr(packet->getSenderSockAddr()),
+      _isComplete(packet->getPacketPosition() == NLPacket::ONLY)
+{
+    _firstPacketReceiveTime = duration_cast<microseconds>(packet->getReceiveTime().time_since_epoch()).count();
+
+    if (_isComplete) {
+        // nothing to chain, a copy of a single payload is cheaper than holding on to a full size packet
+        _data = QByteArray(packet->getPayload(), packet->getPayloadSize());
+    } else {
+        _isChained = true;
+        _packetOffsets.push_back(0);
+        _packets.push_back(std::move(packet));
+    }
+}
+
 ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                 const HifiSockAddr& senderSockAddr, NLPacket::LocalID sourceID) :
     _data(byteArray),
     _headData(_data.mid(0, HEAD_DATA_SIZE)),
+    _size(_data.size()),
     _numPackets(1),
     _firstPacketReceiveTime(0),
     _sourceID(sourceID),
@@ -62,6 +87,26 @@ ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, Pa
 {
 }
 
+QByteArray ReceivedMessage::getMessage() const {
+    if (!_isChained) {
+        return _data;
+    }
+
+    std::lock_guard<std::mutex> lock(_chainMutex);
+    materialize();
+    return _data;
+}
+
+const char* ReceivedMessage::getRawMessage() const {
+    if (!_isChained) {
+        return _data.constData();
+    }
+
+    std::lock_guard<std::mutex> lock(_chainMutex);
+    materialize();
+    return _data.constData();
+}
+
 void ReceivedMessage::setFailed() {
     _failed = true;
     _isComplete = true;
@@ -69,16 +114,47 @@ void ReceivedMessage::setFailed() {
 }
 
 void ReceivedMessage::appendPacket(NLPacket& packet) {
+    if (_isChained) {
+        appendPacket(NLPacket::createCopy(packet));
+        return;
+    }
+
     Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
                "We should not be appending to a complete message");
 
+    _data.append(packet.getPayload(), packet.getPayloadSize());
+    _size += packet.getPayloadSize();
+
+    onPacketAppended(packet);
+}
+
+void ReceivedMessage::appendPacket(std::unique_ptr<NLPacket> packet) {
+    if (!_isChained) {
+        // already contiguous, keep it that way
+        appendPacket(*packet);
+        return;
+    }
+
+    Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
+               "We should not be appending to a complete message");
+
+    const NLPacket* appended = packet.get();
+    {
+        std::lock_guard<std::mutex> lock(_chainMutex);
+        _packetOffsets.push_back(_size);
+        _size += packet->getPayloadSize();
+        _packets.push_back(std::move(packet));
+    }
+
+    onPacketAppended(*appended);
+}
+
+void ReceivedMessage::onPacketAppended(const NLPacket& packet) {
     // Limit progress signal to every X packets
     const int EMIT_PROGRESS_EVERY_X_PACKETS = 50;
 
     ++_numPackets;
 
-    _data.append(packet.getPayload(), packet.getPayloadSize());
-
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
         emit progress(getSize());
     }
@@ -96,16 +172,18 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
 }
 
 qint64 ReceivedMessage::peek(char* data, qint64 size) {
-    size_t bytesLeft = _data.size() - _position;
-    size_t sizeRead = std::min((size_t)size, bytesLeft);
-    memcpy(data, _data.constData() + _position, sizeRead);
+    qint64 sizeRead = std::max(std::min(size, getBytesLeftToRead()), (qint64)0);
+    if (_isChained) {
+        std::lock_guard<std::mutex> lock(_chainMutex);
+        copyOut(_position, data, sizeRead);
+    } else {
+        copyOut(_position, data, sizeRead);
+    }
     return sizeRead;
 }
 
 qint64 ReceivedMessage::read(char* data, qint64 size) {
-    size_t bytesLeft = _data.size() - _position;
-    size_t sizeRead = std::min((size_t)size, bytesLeft);
-    memcpy(data, _data.constData() + _position, sizeRead);
+    qint64 sizeRead = peek(data, size);
     _position += sizeRead;
     return sizeRead;
 }
@@ -119,11 +197,17 @@ qint64 ReceivedMessage::readHead(char* data, qint64 size) {
 }
 
 QByteArray ReceivedMessage::peek(qint64 size) {
-    return _data.mid(_position, size);
+    if (!_isChained) {
+        return _data.mid(_position, size);
+    }
+
+    QByteArray data((int)std::max(std::min(size, getBytesLeftToRead()), (qint64)0), Qt::Uninitialized);
+    peek(data.data(), data.size());
+    return data;
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
+    auto data = peek(size);
     _position += size;
     return data;
 }
@@ -142,17 +226,59 @@ QString ReceivedMessage::readString() {
     uint32_t size;
     readPrimitive(&size);
     //Q_ASSERT(size <= _size - _position);
+    if (_isChained) {
+        return QString::fromUtf8(read(size));
+    }
     auto string = QString::fromUtf8(_data.constData() + _position, size);
     _position += size;
     return string;
 }
 
 QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
+    if (_isChained) {
+        // if the bytes are all in one packet we can point into it, since the packets live as long as the message
+        size = std::max(std::min(size, getBytesLeftToRead()), (qint64)0);
+        const char* start = nullptr;
+        int numSegments = 0;
+        {
+            std::lock_guard<std::mutex> lock(_chainMutex);
+            forEachSegment(_position, size, [&](const char* segment, qint64) {
+                start = segment;
+                ++numSegments;
+            });
+        }
+
+        if (numSegments > 1) {
+            return read(size);
+        }
+        _position += size;
+        return QByteArray::fromRawData(start, start ? size : 0);
+    }
+
     QByteArray data { QByteArray::fromRawData(_data.constData() + _position, size) };
     _position += size;
     return data;
 }
 
+void ReceivedMessage::copyOut(qint64 position, char* data, qint64 size) const {
+    forEachSegment(position, size, [&data](const char* segment, qint64 length) {
+        memcpy(data, segment, length);
+        data += length;
+    });
+}
+
+void ReceivedMessage::materialize() const {
+    // copy out whatever was appended since the last time; copies of _data handed out keep what they had
+    qint64 cachedSize = _data.size();
+    qint64 size = _size;
+    if (cachedSize == size) {
+        return;
+    }
+
+    _data.resize((int)size);
+    copyOut(cachedSize, _data.data() + cachedSize, size - cachedSize);
+}
+
 void ReceivedMessage::onComplete() {
     _isComplete = true;
     emit completed();
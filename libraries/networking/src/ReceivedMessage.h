@@ -15,7 +15,11 @@
 #include <QByteArray>
 #include <QObject>
 
+#include <algorithm>
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "NLPacketList.h"
 
@@ -24,11 +28,19 @@ class ReceivedMessage : public QObject {
 public:
     ReceivedMessage(const NLPacketList& packetList);
     ReceivedMessage(NLPacket& packet);
+    // Keeps the first packet of a multi-packet message rather than copying its payload, see appendPacket
+    ReceivedMessage(std::unique_ptr<NLPacket> packet);
     ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                     const HifiSockAddr& senderSockAddr, NLPacket::LocalID sourceID = NLPacket::NULL_LOCAL_ID);
 
-    QByteArray getMessage() const { return _data; }
-    const char* getRawMessage() const { return _data.constData(); }
+    // A multi-packet message holds on to the packets it was received in until it is destroyed, and only copies
+    // their payloads into one contiguous buffer when either of these is called. The raw pointer is valid until
+    // more packets are appended.
+    QByteArray getMessage() const;
+    const char* getRawMessage() const;
+
+    // True if the message is stored in one contiguous buffer
+    bool isContiguous() const { return !_isChained; }
 
     PacketType getType() const { return _packetType; }
     PacketVersion getVersion() const { return _packetVersion; }
@@ -36,6 +48,7 @@ public:
     void setFailed();
 
     void appendPacket(NLPacket& packet);
+    void appendPacket(std::unique_ptr<NLPacket> packet);
 
     bool failed() const { return _failed; }
     bool isComplete() const { return _isComplete; }
@@ -50,9 +63,9 @@ public:
 
     qint64 getFirstPacketReceiveTime() const { return _firstPacketReceiveTime; }
 
-    qint64 getSize() const { return _data.size(); }
+    qint64 getSize() const { return _size; }
 
-    qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
+    qint64 getBytesLeftToRead() const { return _size -  _position; }
 
     void seek(qint64 position) { _position = position; }
 
@@ -74,8 +87,15 @@ public:
     // This will return a QByteArray referencing the underlying data _without_ refcounting that data.
     // Be careful when using this method, only use it when the lifetime of the returned QByteArray will not
     // exceed that of the ReceivedMessage.
+    // Bytes that span more than one of the received packets are returned as a copy.
     QByteArray readWithoutCopy(qint64 size);
 
+    // Calls f(const char* data, qint64 size) for each contiguous run of the next size bytes, without copying them,
+    // and advances the position past them. The pointers are valid for the lifetime of the ReceivedMessage.
+    // f is called with the message locked, so it must not call back into the message.
+    // Returns the number of bytes visited.
+    template<typename F> qint64 readSegments(qint64 size, F&& f);
+
     template<typename T> qint64 peekPrimitive(T* data);
     template<typename T> qint64 readPrimitive(T* data);
 
@@ -89,9 +109,26 @@ private slots:
     void onComplete();
 
 private:
-    QByteArray _data;
+    void onPacketAppended(const NLPacket& packet);
+
+    // for chained messages these are called with _chainMutex held
+    template<typename F> void forEachSegment(qint64 position, qint64 size, F&& f) const;
+    void copyOut(qint64 position, char* data, qint64 size) const;
+    void materialize() const;
+
+    // the message, either in one buffer or as the chain of packets it arrived in along with the offset
+    // of each packet's payload in the message; a chained message's _data only caches the payloads copied
+    // out by materialize(), and its packets stay alive so that pointers into them remain valid
+    mutable QByteArray _data;
+    std::vector<std::unique_ptr<NLPacket>> _packets;
+    std::vector<qint64> _packetOffsets;
+    bool _isChained { false };
+    // guards the chain and _data of a chained message, since packets are appended on the network thread
+    mutable std::mutex _chainMutex;
     QByteArray _headData;
 
+    std::atomic<qint64> _size { 0 };
+
     std::atomic<qint64> _position { 0 };
     std::atomic<qint64> _numPackets { 0 };
     std::atomic<quint64> _firstPacketReceiveTime { 0 };
@@ -120,4 +157,40 @@ template<typename T> qint64 ReceivedMessage::readHeadPrimitive(T* data) {
     return readHead(reinterpret_cast<char*>(data), sizeof(T));
 }
 
+template<typename F> qint64 ReceivedMessage::readSegments(qint64 size, F&& f) {
+    size = std::max(std::min(size, getBytesLeftToRead()), (qint64)0);
+    if (_isChained) {
+        std::lock_guard<std::mutex> lock(_chainMutex);
+        forEachSegment(_position, size, f);
+    } else {
+        forEachSegment(_position, size, f);
+    }
+    _position += size;
+    return size;
+}
+
+template<typename F> void ReceivedMessage::forEachSegment(qint64 position, qint64 size, F&& f) const {
+    if (size <= 0) {
+        return;
+    }
+
+    if (!_isChained) {
+        f(_data.constData() + position, size);
+        return;
+    }
+
+    auto it = std::upper_bound(_packetOffsets.begin(), _packetOffsets.end(), position);
+    size_t index = std::distance(_packetOffsets.begin(), it) - 1;
+    while (size > 0 && index < _packets.size()) {
+        const auto& packet = _packets[index];
+        qint64 offset = position - _packetOffsets[index];
+        qint64 length = std::min(size, packet->getPayloadSize() - offset);
+        f(packet->getPayload() + offset, length);
+
+        position += length;
+        size -= length;
+        ++index;
+    }
+}
+
 #endif
@@ -22,6 +22,7 @@
 
 #include <platform/Platform.h>
 #include "NetworkLogging.h"
+#include "udt/PacketBufferPool.h"
 
 ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
     Assignment(message),
@@ -119,6 +120,29 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["outbound_kbps"] = nodeList->getOutboundKbps();
     ioStats["outbound_pps"] = nodeList->getOutboundPPS();
 
+    const auto& socketIOStats = nodeList->getSocketIOStats();
+    ioStats["inbound_syscalls_per_second"] = (double)socketIOStats.receiveCalls;
+    ioStats["inbound_datagrams_per_second"] = (double)socketIOStats.receivedDatagrams;
+    ioStats["outbound_syscalls_per_second"] = (double)socketIOStats.sendCalls;
+    ioStats["outbound_datagrams_per_second"] = (double)socketIOStats.sentDatagrams;
+
+    auto poolStats = udt::PacketBufferPool::sampleStats();
+    QJsonObject poolStatsObject;
+    poolStatsObject["hits"] = (double)poolStats.hits;
+    poolStatsObject["misses"] = (double)poolStats.misses;
+    poolStatsObject["outstanding"] = (double)poolStats.outstanding;
+    poolStatsObject["high_water_mark"] = (double)poolStats.highWaterMark;
+    ioStats["packet_buffer_pool"] = poolStatsObject;
+
+    const auto& verificationStats = nodeList->getPacketVerificationStats();
+    QJsonObject verificationStatsObject;
+    verificationStatsObject["verified_per_second"] = (double)verificationStats.verifiedPackets;
+    verificationStatsObject["verify_usecs_per_second"] = (double)verificationStats.verifyUsecs;
+    verificationStatsObject["parallel_verified_per_second"] = (double)verificationStats.parallelVerifiedPackets;
+    verificationStatsObject["signed_per_second"] = (double)verificationStats.signedPackets;
+    verificationStatsObject["sign_usecs_per_second"] = (double)verificationStats.signUsecs;
+    ioStats["packet_verification"] = verificationStatsObject;
+
     statsObject["io_stats"] = ioStats;
 
     QJsonObject assignmentStats;
@@ -0,0 +1,337 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include <SharedUtil.h>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const double HIGH_GAIN = 2.885; // 2 / ln(2), the smallest gain that doubles the delivery rate every round
+static const double DRAIN_GAIN = 1.0 / HIGH_GAIN;
+static const double PROBE_BANDWIDTH_WINDOW_GAIN = 2.0;
+
+// probe for more bandwidth for one min RTT, drain the queue that built for one, then cruise
+static const int PACING_GAIN_CYCLE_LENGTH = 8;
+static const double PACING_GAIN_CYCLE[PACING_GAIN_CYCLE_LENGTH] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+static const int DRAIN_CYCLE_INDEX = 1;
+
+static const double FULL_BANDWIDTH_GROWTH = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const int64_t MIN_RTT_EXPIRY_USECS = 10 * 1000 * 1000;
+static const int64_t PROBE_RTT_DURATION_USECS = 200 * 1000;
+static const int MAX_RTT_SAMPLE_USECS = 10 * 1000 * 1000;
+static const int ACK_INTERVAL_ALPHA = 8;
+
+static const int MIN_WINDOW_PACKETS = 4;
+static const int INITIAL_WINDOW_PACKETS = 16;
+
+BBRCC::BBRCC() {
+    _packetSendPeriod = 0.0;
+    _congestionWindowSize = INITIAL_WINDOW_PACKETS;
+
+    _pacingGain = HIGH_GAIN;
+    _windowGain = HIGH_GAIN;
+
+    _bandwidthSamples.fill(0.0);
+
+    // we can't do this as a member initializer until our VS has support for constexpr
+    _minRTT = std::numeric_limits<int>::max();
+
+    auto now = p_high_resolution_clock::now();
+    _deliveredTime = now;
+    _firstSendTime = now;
+    _minRTTTime = now;
+    _cycleStartTime = now;
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    bool wasDuplicateACK = (ack == _lastACK);
+
+    if (ack > _lastACK) {
+        updateACKInterval(receiveTime);
+        _delivered += seqoff(_lastACK, ack);
+        _deliveredTime = receiveTime;
+        _lastACK = ack;
+
+        // the newest packet this ACK covers gives the RTT and delivery rate samples
+        bool hasSample = false;
+        SentPacketData newest;
+        while (!_sentPacketDatas.empty() && _sentPacketDatas.front().sequenceNumber <= ack) {
+            newest = _sentPacketDatas.front();
+            hasSample = true;
+            _sentPacketDatas.pop_front();
+        }
+
+        if (hasSample) {
+            // an RTT is only unambiguous if the packet was not re-sent
+            if (!newest.wasResent) {
+                updateRTT((int)duration_cast<microseconds>(receiveTime - newest.sendTime).count(), receiveTime);
+            }
+            updateBandwidth(newest, receiveTime);
+        }
+
+        _duplicateACKCount = 0;
+        _isRecoveringFromTimeout = false;
+    }
+
+    updateMode(receiveTime);
+    updateControls();
+
+    return needsFastRetransmit(ack, wasDuplicateACK);
+}
+
+void BBRCC::onTimeout() {
+    // keep the model, but hold back to a minimal window until the connection makes progress again
+    _isRecoveringFromTimeout = true;
+    _congestionWindowSize = MIN_WINDOW_PACKETS;
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sentPacketDatas.empty()) {
+        // nothing was in flight, so the time we spent idle must not count against the next delivery rate sample
+        _firstSendTime = timePoint;
+        _deliveredTime = timePoint;
+    }
+
+    _sentPacketDatas.push_back({ seqNum, timePoint, _delivered, _deliveredTime, _firstSendTime, false });
+}
+
+void BBRCC::onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    auto it = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [seqNum](const SentPacketData& sentPacketData) {
+        return sentPacketData.sequenceNumber == seqNum;
+    });
+
+    // mark it as re-sent so we know it cannot be used for RTT calculations
+    if (it != _sentPacketDatas.end()) {
+        it->wasResent = true;
+    }
+}
+
+int BBRCC::estimatedTimeout() const {
+    return _ewmaRTT == -1 ? DEFAULT_SYN_INTERVAL : _ewmaRTT + _rttVariance * 4;
+}
+
+double BBRCC::getBottleneckBandwidth() const {
+    static const double USECS_PER_SECOND = 1000000.0;
+    return maxBandwidth() * USECS_PER_SECOND;
+}
+
+void BBRCC::updateRTT(int rtt, p_high_resolution_clock::time_point now) {
+    rtt = std::max(1, std::min(rtt, MAX_RTT_SAMPLE_USECS));
+
+    // Jacobson's estimator, as in TCPVegasCC, only feeds the re-transmit timeout
+    static const int RTT_ESTIMATION_ALPHA = 8;
+    static const int RTT_ESTIMATION_VARIANCE_ALPHA = 4;
+    if (_ewmaRTT == -1) {
+        _ewmaRTT = rtt;
+        _rttVariance = rtt / 2;
+    } else {
+        _ewmaRTT = (_ewmaRTT * (RTT_ESTIMATION_ALPHA - 1) + rtt) / RTT_ESTIMATION_ALPHA;
+        _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA - 1)
+                        + abs(rtt - _ewmaRTT)) / RTT_ESTIMATION_VARIANCE_ALPHA;
+    }
+
+    // the min RTT is the propagation delay estimate, it expires so that a route change is eventually noticed
+    _minRTTExpired = duration_cast<microseconds>(now - _minRTTTime).count() > MIN_RTT_EXPIRY_USECS;
+    if (rtt <= _minRTT || _minRTTExpired) {
+        _minRTT = rtt;
+        _minRTTTime = now;
+    }
+}
+
+void BBRCC::updateACKInterval(p_high_resolution_clock::time_point now) {
+    // time with nothing in flight isn't waiting on an ACK, and the next ACK can't be more than a round trip away
+    int64_t maxInterval = std::min(_minRTT, MAX_RTT_SAMPLE_USECS);
+    int64_t interval = duration_cast<microseconds>(now - _deliveredTime).count();
+    interval = std::max((int64_t)0, std::min(interval, maxInterval));
+
+    _ewmaACKInterval = (int)((_ewmaACKInterval * (ACK_INTERVAL_ALPHA - 1) + interval) / ACK_INTERVAL_ALPHA);
+}
+
+void BBRCC::updateBandwidth(const SentPacketData& packet, p_high_resolution_clock::time_point now) {
+    // a round ends once a packet sent after the start of the round is ACKed
+    _isRoundStart = false;
+    if (packet.delivered >= _nextRoundDelivered) {
+        _nextRoundDelivered = _delivered;
+        ++_roundCount;
+        _isRoundStart = true;
+
+        // the oldest round leaves the max filter
+        _bandwidthSamples[_roundCount % BANDWIDTH_FILTER_ROUNDS] = 0.0;
+    }
+
+    // the delivery rate over the longer of the send and ACK intervals, so that neither
+    // a burst of sends nor ACKs bunched up on their way back inflate it
+    auto sendElapsed = duration_cast<microseconds>(packet.sendTime - packet.firstSendTime).count();
+    auto ackElapsed = duration_cast<microseconds>(now - packet.deliveredTime).count();
+    auto interval = std::max(sendElapsed, ackElapsed);
+    auto delivered = _delivered - packet.delivered;
+
+    if (interval > 0 && delivered > 0) {
+        auto& sample = _bandwidthSamples[_roundCount % BANDWIDTH_FILTER_ROUNDS];
+        sample = std::max(sample, (double)delivered / interval);
+    }
+
+    _firstSendTime = packet.sendTime;
+}
+
+void BBRCC::updateMode(p_high_resolution_clock::time_point now) {
+    double bandwidth = maxBandwidth();
+
+    if (_mode == Mode::Startup && _isRoundStart && !_hasFullBandwidth) {
+        // startup is done once three rounds in a row failed to grow the bandwidth by a quarter
+        if (bandwidth >= _fullBandwidth * FULL_BANDWIDTH_GROWTH) {
+            _fullBandwidth = bandwidth;
+            _fullBandwidthRounds = 0;
+        } else if (++_fullBandwidthRounds >= FULL_BANDWIDTH_ROUNDS) {
+            _hasFullBandwidth = true;
+        }
+    }
+
+    if (_mode == Mode::Startup && _hasFullBandwidth) {
+        // drain the queue startup built at the bottleneck
+        _mode = Mode::Drain;
+        _pacingGain = DRAIN_GAIN;
+        _windowGain = HIGH_GAIN;
+    }
+
+    if (_mode == Mode::Drain && packetsInFlight() <= bandwidthDelayProduct(1.0)) {
+        enterProbeBandwidth(now);
+    }
+
+    if (_mode == Mode::ProbeBandwidth) {
+        double gain = PACING_GAIN_CYCLE[_cycleIndex];
+        bool isPhaseOver = duration_cast<microseconds>(now - _cycleStartTime).count() > _minRTT;
+
+        if (gain > 1.0) {
+            // keep probing until the extra packets actually made it into flight
+            isPhaseOver = isPhaseOver && packetsInFlight() >= bandwidthDelayProduct(gain);
+        } else if (gain < 1.0) {
+            // stop draining early if the queue is already gone
+            isPhaseOver = isPhaseOver || packetsInFlight() <= bandwidthDelayProduct(1.0);
+        }
+
+        if (isPhaseOver) {
+            _cycleIndex = (_cycleIndex + 1) % PACING_GAIN_CYCLE_LENGTH;
+            _cycleStartTime = now;
+            _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+        }
+    }
+
+    if (_mode != Mode::ProbeRTT && _minRTTExpired) {
+        // drain everything in flight for a moment to measure the propagation delay without our own queue
+        _modeBeforeProbeRTT = _hasFullBandwidth ? Mode::ProbeBandwidth : Mode::Startup;
+        _mode = Mode::ProbeRTT;
+        _pacingGain = 1.0;
+        _windowGain = 1.0;
+        _probeRTTDoneTime = p_high_resolution_clock::time_point();
+    }
+    _minRTTExpired = false;
+
+    if (_mode == Mode::ProbeRTT) {
+        if (_probeRTTDoneTime == p_high_resolution_clock::time_point()) {
+            if (packetsInFlight() <= MIN_WINDOW_PACKETS) {
+                _probeRTTDoneTime = now + microseconds(PROBE_RTT_DURATION_USECS);
+                _probeRTTRoundDone = false;
+                _nextRoundDelivered = _delivered;
+            }
+        } else {
+            _probeRTTRoundDone = _probeRTTRoundDone || _isRoundStart;
+
+            if (_probeRTTRoundDone && now > _probeRTTDoneTime) {
+                _minRTTTime = now;
+
+                if (_modeBeforeProbeRTT == Mode::ProbeBandwidth) {
+                    enterProbeBandwidth(now);
+                } else {
+                    _mode = Mode::Startup;
+                    _pacingGain = HIGH_GAIN;
+                    _windowGain = HIGH_GAIN;
+                }
+            }
+        }
+    }
+}
+
+void BBRCC::enterProbeBandwidth(p_high_resolution_clock::time_point now) {
+    _mode = Mode::ProbeBandwidth;
+    _windowGain = PROBE_BANDWIDTH_WINDOW_GAIN;
+
+    // start at a random phase other than the drain phase, so that connections sharing a bottleneck don't probe in step
+    _cycleIndex = randIntInRange(DRAIN_CYCLE_INDEX, PACING_GAIN_CYCLE_LENGTH - 1);
+    if (_cycleIndex == DRAIN_CYCLE_INDEX) {
+        _cycleIndex = 0;
+    }
+    _cycleStartTime = now;
+    _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+}
+
+void BBRCC::updateControls() {
+    double bandwidth = maxBandwidth();
+
+    // until the first delivery rate sample we are only limited by the window, like TCPVegasCC
+    if (bandwidth > 0.0) {
+        setPacketSendPeriod(1.0 / (_pacingGain * bandwidth));
+    }
+
+    int windowSize;
+    if (_mode == Mode::ProbeRTT || _isRecoveringFromTimeout) {
+        windowSize = MIN_WINDOW_PACKETS;
+    } else {
+        // leave room for the packets sent while waiting on the next ACK, about one when every packet is ACKed
+        int ackAggregation = (int)std::ceil(bandwidth * _ewmaACKInterval);
+        windowSize = bandwidthDelayProduct(_windowGain) + ackAggregation;
+    }
+
+    _congestionWindowSize = std::max(MIN_WINDOW_PACKETS, std::min(windowSize, udt::MAX_PACKETS_IN_FLIGHT));
+}
+
+double BBRCC::maxBandwidth() const {
+    return *std::max_element(_bandwidthSamples.begin(), _bandwidthSamples.end());
+}
+
+int BBRCC::bandwidthDelayProduct(double gain) const {
+    double bandwidth = maxBandwidth();
+    if (bandwidth <= 0.0 || _minRTT == std::numeric_limits<int>::max()) {
+        return INITIAL_WINDOW_PACKETS;
+    }
+
+    return (int)std::ceil(gain * bandwidth * _minRTT);
+}
+
+bool BBRCC::needsFastRetransmit(SequenceNumber ack, bool wasDuplicateACK) {
+    // re-send ack + 1 if it has been outstanding for longer than our estimated timeout
+    if (!_sentPacketDatas.empty()) {
+        auto& next = _sentPacketDatas.front();
+        auto sinceSend = duration_cast<microseconds>(p_high_resolution_clock::now() - next.sendTime).count();
+
+        if (next.sequenceNumber == ack + 1 && !next.wasResent && sinceSend >= estimatedTimeout()) {
+            _duplicateACKCount = 0;
+            return true;
+        }
+    }
+
+    // otherwise fallback to Reno's fast re-transmit on the 3rd duplicate ACK
+    static const int RENO_FAST_RETRANSMIT_DUPLICATE_COUNT = 3;
+    if (wasDuplicateACK && ++_duplicateACKCount == RENO_FAST_RETRANSMIT_DUPLICATE_COUNT) {
+        _duplicateACKCount = 0;
+        return true;
+    }
+
+    return false;
+}
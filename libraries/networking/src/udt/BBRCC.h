@@ -0,0 +1,129 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <algorithm>
+#include <array>
+#include <deque>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+// Model based congestion control after BBR (https://queue.acm.org/detail.cfm?id=3022184).
+// Rather than treating loss or RTT growth as congestion, it estimates the bottleneck bandwidth (the max delivery rate
+// over the last few round trips) and the propagation delay (the min RTT over the last few seconds), paces packets
+// at that bandwidth and keeps about one bandwidth-delay product in flight, periodically probing for more of either.
+// This keeps the send rate up on links with random loss and jitter, where TCPVegasCC backs off.
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onTimeout() override;
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+    virtual void onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+    virtual int estimatedTimeout() const override;
+
+    enum class Mode { Startup, Drain, ProbeBandwidth, ProbeRTT };
+    Mode getMode() const { return _mode; }
+
+    double getBottleneckBandwidth() const; // packets per second
+    int getMinRTT() const { return _minRTT; } // microseconds
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    struct SentPacketData {
+        SequenceNumber sequenceNumber;
+        p_high_resolution_clock::time_point sendTime;
+
+        // the state of delivery when the packet was sent, to measure the delivery rate once it is ACKed
+        int64_t delivered;
+        p_high_resolution_clock::time_point deliveredTime;
+        p_high_resolution_clock::time_point firstSendTime;
+
+        bool wasResent;
+    };
+
+    void updateRTT(int rtt, p_high_resolution_clock::time_point now);
+    void updateACKInterval(p_high_resolution_clock::time_point now);
+    void updateBandwidth(const SentPacketData& packet, p_high_resolution_clock::time_point now);
+    void updateMode(p_high_resolution_clock::time_point now);
+    void enterProbeBandwidth(p_high_resolution_clock::time_point now);
+    void updateControls();
+
+    double maxBandwidth() const; // packets per microsecond
+    int bandwidthDelayProduct(double gain) const; // packets
+    int packetsInFlight() const { return std::max(seqoff(_lastACK, _sendCurrSeqNum), 0); }
+    bool needsFastRetransmit(SequenceNumber ack, bool wasDuplicateACK);
+
+    std::deque<SentPacketData> _sentPacketDatas; // in send order, for delivery rate and RTT samples
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _windowGain;
+
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+    int _duplicateACKCount { 0 };
+
+    // delivery state
+    int64_t _delivered { 0 }; // packets ACKed over the connection
+    p_high_resolution_clock::time_point _deliveredTime; // when _delivered last grew
+
+    // moving average of the time between ACKs that deliver packets, for the packets sent while waiting on the next one
+    int _ewmaACKInterval { 0 }; // microseconds
+    p_high_resolution_clock::time_point _firstSendTime; // send time of the packet that started the current sample
+
+    // round trips, counted by packets: a round ends when a packet sent after the previous round ended is ACKed
+    int64_t _roundCount { 0 };
+    int64_t _nextRoundDelivered { 0 };
+    bool _isRoundStart { false };
+
+    // max filter on delivery rate over the last few rounds, one slot per round
+    static const int BANDWIDTH_FILTER_ROUNDS = 10;
+    std::array<double, BANDWIDTH_FILTER_ROUNDS> _bandwidthSamples; // packets per microsecond
+
+    // startup ends once the bandwidth stops growing
+    double _fullBandwidth { 0.0 };
+    int _fullBandwidthRounds { 0 };
+    bool _hasFullBandwidth { false };
+
+    // min filter on RTT, refreshed by ProbeRTT when it expires
+    int _minRTT; // microseconds
+    p_high_resolution_clock::time_point _minRTTTime;
+    bool _minRTTExpired { false };
+    p_high_resolution_clock::time_point _probeRTTDoneTime;
+    bool _probeRTTRoundDone { false };
+    Mode _modeBeforeProbeRTT { Mode::ProbeBandwidth };
+
+    // ProbeBandwidth gain cycle
+    int _cycleIndex { 0 };
+    p_high_resolution_clock::time_point _cycleStartTime;
+
+    // for estimatedTimeout, the same estimator TCPVegasCC uses
+    int _ewmaRTT { -1 };
+    int _rttVariance { 0 };
+
+    bool _isRecoveringFromTimeout { false };
+};
+
+}
+
+#endif // hifi_BBRCC_h
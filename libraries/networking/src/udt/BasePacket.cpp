@@ -12,6 +12,7 @@
 #include "BasePacket.h"
 
 #include "../NetworkLogging.h"
+#include "PacketBufferPool.h"
 
 using namespace udt;
 
@@ -60,7 +61,8 @@ BasePacket::BasePacket(qint64 size) {
     Q_ASSERT(size >= 0 || size < maxPayload);
     
     _packetSize = size;
-    _packet.reset(new char[_packetSize]());
+    allocateBuffer(_packetSize);
+    memset(_packet.get(), 0, _packetSize);
     _payloadCapacity = _packetSize;
     _payloadSize = 0;
     _payloadStart = _packet.get();
@@ -77,9 +79,33 @@ BasePacket::BasePacket(std::unique_ptr<char[]> data, qint64 size, const HifiSock
     
 }
 
+BasePacket::~BasePacket() {
+    releaseBuffer();
+}
+
+void BasePacket::allocateBuffer(qint64 size) {
+    releaseBuffer();
+
+    if (size <= PacketBufferPool::BUFFER_SIZE) {
+        _packet = PacketBufferPool::acquire();
+        _isBufferPooled = true;
+    } else {
+        _packet.reset(new char[size]);
+        _isBufferPooled = false;
+    }
+}
+
+void BasePacket::releaseBuffer() {
+    if (_isBufferPooled) {
+        PacketBufferPool::release(std::move(_packet));
+        _isBufferPooled = false;
+    }
+    _packet.reset();
+}
+
 BasePacket& BasePacket::operator=(const BasePacket& other) {
     _packetSize = other._packetSize;
-    _packet = std::unique_ptr<char[]>(new char[_packetSize]);
+    allocateBuffer(_packetSize);
     memcpy(_packet.get(), other._packet.get(), _packetSize);
     
     _payloadStart = _packet.get() + (other._payloadStart - other._packet.get());
@@ -104,7 +130,10 @@ BasePacket::BasePacket(BasePacket&& other) {
 
 BasePacket& BasePacket::operator=(BasePacket&& other) {
     _packetSize = other._packetSize;
+    releaseBuffer();
     _packet = std::move(other._packet);
+    _isBufferPooled = other._isBufferPooled;
+    other._isBufferPooled = false;
     
     _payloadStart = other._payloadStart;
     _payloadCapacity = other._payloadCapacity;
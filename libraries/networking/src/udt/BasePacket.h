@@ -82,6 +82,10 @@ public:
     qint64 writeString(const QString& string);
     QString readString();
 
+    // Marks the buffer handed to fromReceivedPacket as one drawn from PacketBufferPool, so it is recycled on destruction
+    void setBufferIsPooled(bool isPooled) { _isBufferPooled = isPooled; }
+    bool isBufferPooled() const { return _isBufferPooled; }
+
     void setReceiveTime(p_high_resolution_clock::time_point receiveTime) { _receiveTime = receiveTime; }
     p_high_resolution_clock::time_point getReceiveTime() const { return _receiveTime; }
     
@@ -92,15 +96,20 @@ protected:
     BasePacket& operator=(const BasePacket& other);
     BasePacket(BasePacket&& other);
     BasePacket& operator=(BasePacket&& other);
+    virtual ~BasePacket();
     
     // QIODevice virtual functions
     virtual qint64 writeData(const char* data, qint64 maxSize) override;
     virtual qint64 readData(char* data, qint64 maxSize) override;
     
     void adjustPayloadStartAndCapacity(qint64 headerSize, bool shouldDecreasePayloadSize = false);
+
+    void allocateBuffer(qint64 size);
+    void releaseBuffer();
     
     qint64 _packetSize = 0;        // Total size of the allocated memory
     std::unique_ptr<char[]> _packet; // Allocated memory
+    bool _isBufferPooled { false };  // _packet came from (and goes back to) PacketBufferPool
     
     char* _payloadStart = nullptr; // Start of the payload
     qint64 _payloadCapacity = 0;          // Total capacity of the payload
@@ -16,6 +16,8 @@
 #include <memory>
 #include <vector>
 
+#include <QtCore/QString>
+
 #include <PortableHighResolutionClock.h>
 
 #include "LossList.h"
@@ -81,6 +83,9 @@ public:
     virtual ~CongestionControlFactory() {}
     virtual std::unique_ptr<CongestionControl> create() override { return std::unique_ptr<T>(new T()); }
 };
+
+// the factory for a congestion control by name ("vegas" or "bbr"), nullptr if the name is unknown
+std::unique_ptr<CongestionControlVirtualFactory> createCongestionControlFactory(const QString& name);
     
 }
 
@@ -11,50 +11,336 @@
 
 #include "LossList.h"
 
+#include <algorithm>
+#include <bitset>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 #include "ControlPacket.h"
 
 using namespace udt;
 using namespace std;
 
+static const uint32_t WORD_BITS = 64;
+static const uint32_t MIN_NUM_BITS = 1024;
+
+static inline int countBits(uint64_t word) {
+    return (int)bitset<WORD_BITS>(word).count();
+}
+
+// index of the lowest set bit of a non-zero word
+static inline int lowestBit(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+// mask of count bits starting at bit
+static inline uint64_t bitMask(uint32_t bit, uint32_t count) {
+    return ((count == WORD_BITS) ? ~0ULL : ((1ULL << count) - 1)) << bit;
+}
+
+void LossList::clear() {
+    releaseBits();
+    _ranges.clear();
+    _usesRanges = false;
+    _length = 0;
+}
+
 void LossList::append(SequenceNumber seq) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
+    Q_ASSERT_X(isEmpty() || (_last < seq), "LossList::append(SequenceNumber)",
                "SequenceNumber appended is not greater than the last SequenceNumber in the list");
     
-    if (getLength() > 0 && _lossList.back().second + 1 == seq) {
-        ++_lossList.back().second;
-    } else {
-        _lossList.push_back(make_pair(seq, seq));
-    }
-    _length += 1;
+    insert(seq, seq);
 }
 
 void LossList::append(SequenceNumber start, SequenceNumber end) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < start),
+    Q_ASSERT_X(isEmpty() || (_last < start),
                "LossList::append(SequenceNumber, SequenceNumber)",
                "SequenceNumber range appended is not greater than the last SequenceNumber in the list");
     Q_ASSERT_X(start <= end,
                "LossList::append(SequenceNumber, SequenceNumber)", "Range start greater than range end");
 
-    if (getLength() > 0 && _lossList.back().second + 1 == start) {
-        _lossList.back().second = end;
-    } else {
-        _lossList.push_back(make_pair(start, end));
-    }
-    _length += seqlen(start, end);
+    insert(start, end);
 }
 
 void LossList::insert(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::insert(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     
-    auto it = find_if_not(_lossList.begin(), _lossList.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
+    if (_usesRanges) {
+        insertRange(start, end);
+        return;
+    }
+    
+    SequenceNumber first = isEmpty() ? start : min(_first, start);
+    SequenceNumber last = isEmpty() ? end : max(_last, end);
+    int span = seqlen(first, last);
+    
+    if ((uint32_t)span >= MAX_NUM_BITS) {
+        // too wide for the ring, a bit per sequence number would cost more than it saves
+        switchToRanges();
+        insertRange(start, end);
+        return;
+    }
+    
+    // grow around the current contents before widening the range they are read from
+    reserve(span);
+    _first = first;
+    _last = last;
+    
+    _length += setRange(start, end);
+}
+
+bool LossList::remove(SequenceNumber seq) {
+    if (_usesRanges) {
+        return removeFromRanges(seq);
+    }
+    
+    if (isEmpty() || seq < _first || seq > _last || !test(seq)) {
+        // this sequence number was not found in the loss list, return false
+        return false;
+    }
+    
+    uint32_t index = bitIndex(seq);
+    _bits[index / WORD_BITS] &= ~(1ULL << (index % WORD_BITS));
+    _length -= 1;
+    
+    if (!isEmpty() && seq == _first) {
+        _first = nextSet(seq);
+    }
+    
+    // this sequence number was found in the loss list, return true
+    return true;
+}
+
+void LossList::remove(SequenceNumber start, SequenceNumber end) {
+    Q_ASSERT_X(start <= end,
+               "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
+    
+    if (_usesRanges) {
+        removeFromRanges(start, end);
+        return;
+    }
+    
+    if (isEmpty() || end < _first || start > _last) {
+        return;
+    }
+    
+    start = max(start, _first);
+    end = min(end, _last);
+    _length -= clearRange(start, end);
+    
+    if (!isEmpty() && start == _first) {
+        _first = nextSet(end + 1);
+    }
+}
+
+SequenceNumber LossList::getFirstSequenceNumber() const {
+    Q_ASSERT_X(getLength() > 0, "LossList::getFirstSequenceNumber()", "Trying to get first element of an empty list");
+    return _usesRanges ? _ranges.front().first : _first;
+}
+
+SequenceNumber LossList::popFirstSequenceNumber() {
+    auto front = getFirstSequenceNumber();
+    remove(front);
+    return front;
+}
+
+void LossList::write(ControlPacket& packet, int maxPairs) {
+    int writtenPairs = 0;
+    
+    if (_usesRanges) {
+        for (const auto& pair : _ranges) {
+            packet.writePrimitive(pair.first);
+            packet.writePrimitive(pair.second);
+            
+            ++writtenPairs;
+            
+            // check if we've written the maximum number we were told to write
+            if (maxPairs != -1 && writtenPairs >= maxPairs) {
+                break;
+            }
+        }
+        return;
+    }
+    
+    int remaining = _length;
+    SequenceNumber seq = _first;
+    
+    while (remaining > 0) {
+        SequenceNumber start = nextSet(seq);
+        SequenceNumber end = nextClear(start) - 1;
+        
+        packet.writePrimitive(start);
+        packet.writePrimitive(end);
+        
+        ++writtenPairs;
+        remaining -= seqlen(start, end);
+        seq = end + 1;
+        
+        // check if we've written the maximum number we were told to write
+        if (maxPairs != -1 && writtenPairs >= maxPairs) {
+            break;
+        }
+    }
+}
+
+bool LossList::test(SequenceNumber seq) const {
+    uint32_t index = bitIndex(seq);
+    return (_bits[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+}
+
+int LossList::setRange(SequenceNumber start, SequenceNumber end) {
+    int changed = 0;
+    uint32_t index = bitIndex(start);
+    uint32_t remaining = seqlen(start, end);
+    
+    while (remaining > 0) {
+        uint32_t bit = index % WORD_BITS;
+        uint32_t count = min(WORD_BITS - bit, remaining);
+        uint64_t mask = bitMask(bit, count);
+        uint64_t& word = _bits[index / WORD_BITS];
+        
+        changed += countBits(mask & ~word);
+        word |= mask;
+        
+        index = (index + count) & (_numBits - 1);
+        remaining -= count;
+    }
+    return changed;
+}
+
+int LossList::clearRange(SequenceNumber start, SequenceNumber end) {
+    int changed = 0;
+    uint32_t index = bitIndex(start);
+    uint32_t remaining = seqlen(start, end);
+    
+    while (remaining > 0) {
+        uint32_t bit = index % WORD_BITS;
+        uint32_t count = min(WORD_BITS - bit, remaining);
+        uint64_t mask = bitMask(bit, count);
+        uint64_t& word = _bits[index / WORD_BITS];
+        
+        changed += countBits(mask & word);
+        word &= ~mask;
+        
+        index = (index + count) & (_numBits - 1);
+        remaining -= count;
+    }
+    return changed;
+}
+
+SequenceNumber LossList::nextSet(SequenceNumber seq) const {
+    // callers only look for a set bit when one lies between seq and _last,
+    // and the bits outside of [_first, _last] are always clear, so the scan ends
+    uint32_t index = bitIndex(seq);
+    int offset = 0;
+    
+    while (true) {
+        uint32_t bit = index % WORD_BITS;
+        uint64_t word = _bits[index / WORD_BITS] >> bit;
+        if (word) {
+            return seq + (offset + lowestBit(word));
+        }
+        offset += WORD_BITS - bit;
+        index = (index + WORD_BITS - bit) & (_numBits - 1);
+    }
+}
+
+SequenceNumber LossList::nextClear(SequenceNumber seq) const {
+    // the ring is always larger than [_first, _last], so a clear bit follows every run
+    uint32_t index = bitIndex(seq);
+    int offset = 0;
+    
+    while (true) {
+        uint32_t bit = index % WORD_BITS;
+        uint64_t word = ~_bits[index / WORD_BITS] >> bit;
+        if (word) {
+            return seq + (offset + lowestBit(word));
+        }
+        offset += WORD_BITS - bit;
+        index = (index + WORD_BITS - bit) & (_numBits - 1);
+    }
+}
+
+void LossList::reserve(int span) {
+    // keep at least one clear bit past the lost range
+    if ((uint32_t)span < _numBits) {
+        return;
+    }
+    
+    uint32_t numBits = max(_numBits, MIN_NUM_BITS);
+    while (numBits <= (uint32_t)span) {
+        numBits <<= 1;
+    }
+    
+    vector<uint64_t> bits(numBits / WORD_BITS, 0);
+    
+    // re-home the current losses under the new mask
+    if (!isEmpty()) {
+        SequenceNumber seq = _first;
+        for (int remaining = _length; remaining > 0; ++seq) {
+            if (test(seq)) {
+                uint32_t index = (SequenceNumber::UType)seq & (numBits - 1);
+                bits[index / WORD_BITS] |= 1ULL << (index % WORD_BITS);
+                --remaining;
+            }
+        }
+    }
+    
+    _bits.swap(bits);
+    _numBits = numBits;
+}
+
+void LossList::switchToRanges() {
+    int remaining = _length;
+    SequenceNumber seq = _first;
+    
+    while (remaining > 0) {
+        SequenceNumber start = nextSet(seq);
+        SequenceNumber end = nextClear(start) - 1;
+        
+        _ranges.push_back(make_pair(start, end));
+        remaining -= seqlen(start, end);
+        seq = end + 1;
+    }
+    
+    releaseBits();
+    _usesRanges = true;
+}
+
+void LossList::releaseBits() {
+    vector<uint64_t>().swap(_bits);
+    _numBits = 0;
+}
+
+void LossList::insertRange(SequenceNumber start, SequenceNumber end) {
+    if (_ranges.empty() || _ranges.back().second < start) {
+        // appending, the common case
+        if (!_ranges.empty() && _ranges.back().second + 1 == start) {
+            _ranges.back().second = end;
+        } else {
+            _ranges.push_back(make_pair(start, end));
+        }
+        _length += seqlen(start, end);
+        return;
+    }
+    
+    auto it = find_if_not(_ranges.begin(), _ranges.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
         return pair.second < start;
     });
     
-    if (it == _lossList.end() || end < it->first) {
+    if (end < it->first) {
         // No overlap, simply insert
         _length += seqlen(start, end);
-        _lossList.insert(it, make_pair(start, end));
+        _ranges.insert(it, make_pair(start, end));
     } else {
         // If it starts before segment, extend segment
         if (start < it->first) {
@@ -71,7 +357,7 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
         auto it2 = it;
         ++it2;
         // For all ranges touching the current range
-        while (it2 != _lossList.end() && it->second >= it2->first - 1) {
+        while (it2 != _ranges.end() && it->second >= it2->first - 1) {
             // extend current range if necessary
             if (it->second < it2->second) {
                 _length += seqlen(it->second + 1, it2->second);
@@ -80,105 +366,79 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
             
             // Remove overlapping range
             _length -= seqlen(it2->first, it2->second);
-            it2 = _lossList.erase(it2);
+            it2 = _ranges.erase(it2);
         }
     }
 }
 
-bool LossList::remove(SequenceNumber seq) {
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
+bool LossList::removeFromRanges(SequenceNumber seq) {
+    auto it = find_if(_ranges.begin(), _ranges.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
         return pair.first <= seq && seq <= pair.second;
     });
     
-    if (it != end(_lossList)) {
-        if (it->first == it->second) {
-            _lossList.erase(it);
-        } else if (seq == it->first) {
-            ++it->first;
-        } else if (seq == it->second) {
-            --it->second;
-        } else {
-            auto temp = it->second;
-            it->second = seq - 1;
-            _lossList.insert(++it, make_pair(seq + 1, temp));
-        }
-        _length -= 1;
-        
-        // this sequence number was found in the loss list, return true
-        return true;
-    } else {
-        // this sequence number was not found in the loss list, return false
+    if (it == _ranges.end()) {
         return false;
     }
+    
+    if (it->first == it->second) {
+        _ranges.erase(it);
+    } else if (seq == it->first) {
+        ++it->first;
+    } else if (seq == it->second) {
+        --it->second;
+    } else {
+        auto temp = it->second;
+        it->second = seq - 1;
+        _ranges.insert(++it, make_pair(seq + 1, temp));
+    }
+    _length -= 1;
+    
+    if (_ranges.empty()) {
+        // back to the ring for whatever is lost next
+        _usesRanges = false;
+    }
+    return true;
 }
 
-void LossList::remove(SequenceNumber start, SequenceNumber end) {
-    Q_ASSERT_X(start <= end,
-               "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
+void LossList::removeFromRanges(SequenceNumber start, SequenceNumber end) {
     // Find the first segment sharing sequence numbers
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
+    auto it = find_if(_ranges.begin(), _ranges.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
         return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
     });
     
-    // If we found one
-    if (it != _lossList.end()) {
-        
-        // While the end of the current segment is contained, either shorten it (first one only - sometimes)
-        // or remove it altogether since it is fully contained it the range
-        while (it != _lossList.end() && end >= it->second) {
-            if (start <= it->first) {
-                // Segment is contained, update new length and erase it.
-                _length -= seqlen(it->first, it->second);
-                it = _lossList.erase(it);
-            } else {
-                // Beginning of segment not contained, modify end of segment.
-                // Will only occur sometimes one the first loop
-                _length -= seqlen(start, it->second);
-                it->second = start - 1;
-                ++it;
-            }
-        }
-        
-        // There might be more to remove
-        if (it != _lossList.end() && it->first <= end) {
-            if (start <= it->first) {
-                // Truncate beginning of segment
-                _length -= seqlen(it->first, end);
-                it->first = end + 1;
-            } else {
-                // Cut it in half if the range we are removing is contained within one segment
-                _length -= seqlen(start, end);
-                auto temp = it->second;
-                it->second = start - 1;
-                _lossList.insert(++it, make_pair(end + 1, temp));
-            }
+    // While the end of the current segment is contained, either shorten it (first one only - sometimes)
+    // or remove it altogether since it is fully contained it the range
+    while (it != _ranges.end() && end >= it->second) {
+        if (start <= it->first) {
+            // Segment is contained, update new length and erase it.
+            _length -= seqlen(it->first, it->second);
+            it = _ranges.erase(it);
+        } else {
+            // Beginning of segment not contained, modify end of segment.
+            // Will only occur sometimes one the first loop
+            _length -= seqlen(start, it->second);
+            it->second = start - 1;
+            ++it;
         }
     }
-}
-
-SequenceNumber LossList::getFirstSequenceNumber() const {
-    Q_ASSERT_X(getLength() > 0, "LossList::getFirstSequenceNumber()", "Trying to get first element of an empty list");
-    return _lossList.front().first;
-}
-
-SequenceNumber LossList::popFirstSequenceNumber() {
-    auto front = getFirstSequenceNumber();
-    remove(front);
-    return front;
-}
-
-void LossList::write(ControlPacket& packet, int maxPairs) {
-    int writtenPairs = 0;
     
-    for (const auto& pair : _lossList) {
-        packet.writePrimitive(pair.first);
-        packet.writePrimitive(pair.second);
-        
-        ++writtenPairs;
-        
-        // check if we've written the maximum number we were told to write
-        if (maxPairs != -1 && writtenPairs >= maxPairs) {
-            break;
+    // There might be more to remove
+    if (it != _ranges.end() && it->first <= end) {
+        if (start <= it->first) {
+            // Truncate beginning of segment
+            _length -= seqlen(it->first, end);
+            it->first = end + 1;
+        } else {
+            // Cut it in half if the range we are removing is contained within one segment
+            _length -= seqlen(start, end);
+            auto temp = it->second;
+            it->second = start - 1;
+            _ranges.insert(++it, make_pair(end + 1, temp));
         }
     }
+    
+    if (_ranges.empty()) {
+        // back to the ring for whatever is lost next
+        _usesRanges = false;
+    }
 }
@@ -12,25 +12,32 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
+#include <cstdint>
 #include <list>
+#include <vector>
 
 #include "SequenceNumber.h"
 
 namespace udt {
 
 class ControlPacket;
-    
+
+// Lost sequence numbers, kept as one bit per sequence number in a ring indexed by the sequence number itself.
+// Adding or removing a loss is a bit operation wherever it falls, and runs of losses are recovered for NAKs
+// by scanning whole words. The ring doubles whenever the lost range outgrows it, up to MAX_NUM_BITS; a lost range
+// wider than that, such as the gap before a sequence number far ahead of the others, is kept as a list of ranges
+// instead until the list empties.
 class LossList {
 public:
     LossList() {}
     
-    void clear() { _length = 0; _lossList.clear(); }
+    void clear();
     
-    // must always add at the end - faster than insert
+    // must always add at the end
     void append(SequenceNumber seq);
     void append(SequenceNumber start, SequenceNumber end);
     
-    // inserts anywhere - MUCH slower
+    // inserts anywhere
     void insert(SequenceNumber start, SequenceNumber end);
     
     bool remove(SequenceNumber seq);
@@ -43,8 +50,42 @@ public:
     
     void write(ControlPacket& packet, int maxPairs = -1);
     
+    static const uint32_t MAX_NUM_BITS = 1 << 16;
+    
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    uint32_t bitIndex(SequenceNumber seq) const { return (SequenceNumber::UType)seq & (_numBits - 1); }
+    bool test(SequenceNumber seq) const;
+
+    // set or clear the bits of [start, end], returning how many of them changed
+    int setRange(SequenceNumber start, SequenceNumber end);
+    int clearRange(SequenceNumber start, SequenceNumber end);
+
+    // first sequence number at or after seq whose bit is set (or clear)
+    SequenceNumber nextSet(SequenceNumber seq) const;
+    SequenceNumber nextClear(SequenceNumber seq) const;
+
+    // makes room for span sequence numbers starting at _first
+    void reserve(int span);
+    
+    // moves the losses from the ring to _ranges and releases the ring
+    void switchToRanges();
+    void releaseBits();
+    
+    // used instead of the ring while _usesRanges is set
+    void insertRange(SequenceNumber start, SequenceNumber end);
+    bool removeFromRanges(SequenceNumber seq);
+    void removeFromRanges(SequenceNumber start, SequenceNumber end);
+
+    std::vector<uint64_t> _bits;
+    uint32_t _numBits { 0 }; // power of two, so that bit indices survive sequence number wrap around
+
+    // every lost sequence number lies in [_first, _last] and _first is lost; only valid when _length > 0
+    SequenceNumber _first;
+    SequenceNumber _last;
+    
+    std::list<std::pair<SequenceNumber, SequenceNumber>> _ranges;
+    bool _usesRanges { false };
+    
     int _length { 0 };
 };
     
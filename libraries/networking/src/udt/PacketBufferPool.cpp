@@ -0,0 +1,133 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <atomic>
+#include <vector>
+
+#include <TBBHelpers.h>
+
+using namespace udt;
+
+// free buffers each thread holds on to before spilling to the shared queue
+static const size_t MAX_THREAD_CACHED_BUFFERS = 64;
+// free buffers the shared queue holds on to before we give memory back to the allocator (~6MB)
+static const int MAX_SHARED_BUFFERS = 4096;
+
+namespace {
+    tbb::concurrent_queue<char*> sharedBuffers;
+    std::atomic<int> numSharedBuffers { 0 };
+
+    std::atomic<uint64_t> hits { 0 };
+    std::atomic<uint64_t> misses { 0 };
+    std::atomic<int64_t> outstanding { 0 };
+    std::atomic<int64_t> highWaterMark { 0 };
+
+    bool pushShared(char* buffer) {
+        if (numSharedBuffers.fetch_add(1) < MAX_SHARED_BUFFERS) {
+            sharedBuffers.push(buffer);
+            return true;
+        }
+        --numSharedBuffers;
+        return false;
+    }
+
+    char* popShared() {
+        char* buffer = nullptr;
+        if (sharedBuffers.try_pop(buffer)) {
+            --numSharedBuffers;
+        }
+        return buffer;
+    }
+
+    // set once the thread's cache has been destroyed: packets can still be released later in the thread's teardown
+    // (by other thread_local destructors), and being trivially destructible the flag outlives the cache
+    thread_local bool threadCacheDestroyed { false };
+
+    struct ThreadCache {
+        std::vector<char*> buffers;
+
+        ThreadCache() { buffers.reserve(MAX_THREAD_CACHED_BUFFERS); }
+
+        ~ThreadCache() {
+            threadCacheDestroyed = true;
+
+            // the thread is going away, hand what it held to the other threads
+            for (auto buffer : buffers) {
+                if (!pushShared(buffer)) {
+                    delete[] buffer;
+                }
+            }
+        }
+    };
+
+    // returns nullptr once the thread's cache has been destroyed
+    ThreadCache* threadCache() {
+        if (threadCacheDestroyed) {
+            return nullptr;
+        }
+        static thread_local ThreadCache cache;
+        return &cache;
+    }
+}
+
+std::unique_ptr<char[]> PacketBufferPool::acquire() {
+    auto cache = threadCache();
+
+    char* buffer = nullptr;
+    if (cache && !cache->buffers.empty()) {
+        buffer = cache->buffers.back();
+        cache->buffers.pop_back();
+    } else {
+        buffer = popShared();
+    }
+
+    if (buffer) {
+        ++hits;
+    } else {
+        ++misses;
+        buffer = new char[BUFFER_SIZE];
+    }
+
+    auto inUse = ++outstanding;
+    auto previousMark = highWaterMark.load();
+    while (inUse > previousMark && !highWaterMark.compare_exchange_weak(previousMark, inUse)) {}
+
+    return std::unique_ptr<char[]>(buffer);
+}
+
+void PacketBufferPool::release(std::unique_ptr<char[]> buffer) {
+    if (!buffer) {
+        return;
+    }
+
+    --outstanding;
+
+    auto cache = threadCache();
+    if (cache && cache->buffers.size() < MAX_THREAD_CACHED_BUFFERS) {
+        cache->buffers.push_back(buffer.release());
+    } else if (pushShared(buffer.get())) {
+        buffer.release();
+    }
+    // otherwise both caches are full and the buffer is freed as it goes out of scope
+}
+
+PacketBufferPool::Stats PacketBufferPool::sampleStats() {
+    Stats stats;
+    stats.hits = hits.exchange(0);
+    stats.misses = misses.exchange(0);
+
+    auto inUse = std::max(outstanding.load(), (int64_t)0);
+    stats.outstanding = inUse;
+    stats.highWaterMark = std::max(highWaterMark.exchange(inUse), inUse);
+    return stats;
+}
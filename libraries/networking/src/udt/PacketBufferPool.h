@@ -0,0 +1,49 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <memory>
+
+#include "Constants.h"
+
+namespace udt {
+
+// Recycles the MAX_PACKET_SIZE buffers behind BasePacket so the send and receive paths don't hit the allocator per packet.
+// Each thread keeps a small lock-free cache of free buffers, spilling to and refilling from a shared concurrent queue
+// since packets are usually created on one thread and destroyed on another.
+class PacketBufferPool {
+public:
+    static const int BUFFER_SIZE = MAX_PACKET_SIZE;
+
+    struct Stats {
+        uint64_t hits { 0 };
+        uint64_t misses { 0 };
+        uint64_t outstanding { 0 };
+        uint64_t highWaterMark { 0 };
+    };
+
+    // returns a buffer of BUFFER_SIZE bytes, with unspecified contents
+    static std::unique_ptr<char[]> acquire();
+
+    // gives back a buffer that was returned by acquire
+    static void release(std::unique_ptr<char[]> buffer);
+
+    // returns the hit/miss counts since the last sample, and the peak number of buffers in use since the last sample
+    static Stats sampleStats();
+};
+
+} // namespace udt
+
+#endif // hifi_PacketBufferPool_h
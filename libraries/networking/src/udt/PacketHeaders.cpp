@@ -64,7 +64,9 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::AssetGetInfo:
         case PacketType::AssetGet:
         case PacketType::AssetUpload:
-            return static_cast<PacketVersion>(AssetServerPacketVersion::BakingTextureMeta);
+        case PacketType::AssetChunkQuery:
+        case PacketType::AssetChunkedUpload:
+            return static_cast<PacketVersion>(AssetServerPacketVersion::ChunkedUploads);
         case PacketType::NodeIgnoreRequest:
             return 18; // Introduction of node ignore request (which replaced an unused packet tpye)
 
@@ -136,6 +136,9 @@ public:
         BulkAvatarTraitsAck,
         StopInjector,
         AvatarZonePresence,
+        AssetChunkQuery,
+        AssetChunkQueryReply,
+        AssetChunkedUpload,
         NUM_PACKET_TYPE
     };
 
@@ -301,7 +304,8 @@ enum class AssetServerPacketVersion: PacketVersion {
     VegasCongestionControl = 19,
     RangeRequestSupport,
     RedirectedMappings,
-    BakingTextureMeta
+    BakingTextureMeta,
+    ChunkedUploads
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
@@ -0,0 +1,95 @@
+//
+//  SentPacketWindow.cpp
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketWindow.h"
+
+#include <algorithm>
+
+using namespace udt;
+
+static int nextPowerOfTwo(int value) {
+    int result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+SentPacketWindow::SentPacketWindow(int initialCapacity) :
+    _entries(nextPowerOfTwo(std::max(initialCapacity, 1)))
+{
+}
+
+void SentPacketWindow::insert(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet) {
+    if (_span == 0) {
+        _first = sequenceNumber;
+    }
+
+    int offset = seqoff(_first, sequenceNumber);
+    Q_ASSERT_X(offset >= _span, "SentPacketWindow::insert()", "SequenceNumber inserted is not after the window");
+
+    if (offset >= (int)_entries.size()) {
+        grow(offset + 1);
+    }
+
+    auto& entry = _entries[indexOf(sequenceNumber)];
+    entry.packet = std::move(packet);
+    entry.sequenceNumber = sequenceNumber;
+    entry.resends = 0;
+
+    _span = offset + 1;
+    ++_size;
+}
+
+SentPacketWindow::Entry* SentPacketWindow::find(SequenceNumber sequenceNumber) {
+    if (_span == 0) {
+        return nullptr;
+    }
+
+    int offset = seqoff(_first, sequenceNumber);
+    if (offset < 0 || offset >= _span) {
+        return nullptr;
+    }
+
+    auto& entry = _entries[indexOf(sequenceNumber)];
+    return entry.packet ? &entry : nullptr;
+}
+
+void SentPacketWindow::acknowledge(SequenceNumber sequenceNumber) {
+    while (_span > 0 && _first <= sequenceNumber) {
+        auto& entry = _entries[indexOf(_first)];
+        if (entry.packet) {
+            entry.packet.reset();
+            --_size;
+        }
+        ++_first;
+        --_span;
+    }
+}
+
+void SentPacketWindow::clear() {
+    acknowledge(_first + (_span - 1));
+}
+
+void SentPacketWindow::grow(int minimumCapacity) {
+    std::vector<Entry> entries(nextPowerOfTwo(std::max(minimumCapacity, 2 * (int)_entries.size())));
+
+    // re-home the packets in flight under the new mask
+    SequenceNumber sequenceNumber = _first;
+    for (int i = 0; i < _span; ++i, ++sequenceNumber) {
+        auto& entry = _entries[indexOf(sequenceNumber)];
+        if (entry.packet) {
+            entries[(SequenceNumber::UType)sequenceNumber & (entries.size() - 1)] = std::move(entry);
+        }
+    }
+
+    _entries.swap(entries);
+}
@@ -0,0 +1,68 @@
+//
+//  SentPacketWindow.h
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SentPacketWindow_h
+#define hifi_SentPacketWindow_h
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Packet.h"
+#include "SequenceNumber.h"
+
+namespace udt {
+
+// Packets waiting for ACK, stored in a circular buffer indexed by sequence number.
+// Packets are sent and acknowledged in sequence number order, so inserts and ACKs only touch the ends of the window
+// and a lookup is a mask instead of a hash. The buffer doubles when more packets are in flight than it can hold.
+class SentPacketWindow {
+public:
+    struct Entry {
+        std::unique_ptr<Packet> packet;
+        SequenceNumber sequenceNumber;
+        uint8_t resends { 0 };
+    };
+
+    SentPacketWindow(int initialCapacity = DEFAULT_CAPACITY);
+
+    // sequenceNumber must come after every sequence number already in the window
+    void insert(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet);
+
+    // returns nullptr if the packet was never sent or has been ACKed
+    Entry* find(SequenceNumber sequenceNumber);
+
+    // drops every packet up to and including sequenceNumber
+    void acknowledge(SequenceNumber sequenceNumber);
+
+    void clear();
+
+    int getSize() const { return _size; }
+    bool isEmpty() const { return _size == 0; }
+    int getCapacity() const { return (int)_entries.size(); }
+
+    static const int DEFAULT_CAPACITY = 1024;
+
+private:
+    size_t indexOf(SequenceNumber sequenceNumber) const {
+        return (SequenceNumber::UType)sequenceNumber & (_entries.size() - 1);
+    }
+    void grow(int minimumCapacity);
+
+    std::vector<Entry> _entries; // power of two sized, so that the index survives sequence number wrap around
+    SequenceNumber _first; // oldest sequence number in the window
+    int _span { 0 }; // sequence numbers from _first to the newest packet, including ACKed holes
+    int _size { 0 }; // packets held
+};
+
+}
+
+#endif // hifi_SentPacketWindow_h
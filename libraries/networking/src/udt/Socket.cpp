@@ -15,6 +15,9 @@
 #include <sys/socket.h>
 #endif
 
+#include <array>
+
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 
 #include <shared/QtHelpers.h>
@@ -27,6 +30,7 @@
 #include "../NLPacket.h"
 #include "../NLPacketList.h"
 #include "PacketList.h"
+#include "PacketBufferPool.h"
 #include <Trace.h>
 
 using namespace udt;
@@ -38,6 +42,57 @@ using namespace udt;
 #include <netinet/in.h>
 #endif
 
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+#include <sys/socket.h>
+#define UDT_BATCHED_DATAGRAMS
+#endif
+
+#ifdef UDT_BATCHED_DATAGRAMS
+
+// how many datagrams we move per recvmmsg/sendmmsg call
+static const int DATAGRAM_BATCH_SIZE = 64;
+
+struct Socket::DatagramBatch {
+    std::array<std::unique_ptr<char[]>, DATAGRAM_BATCH_SIZE> buffers;
+    std::array<mmsghdr, DATAGRAM_BATCH_SIZE> headers;
+    std::array<iovec, DATAGRAM_BATCH_SIZE> vectors;
+    std::array<sockaddr_storage, DATAGRAM_BATCH_SIZE> addresses;
+
+    // data packets built from the batch ahead of processing, when there is a batch prefilter
+    std::array<std::unique_ptr<Packet>, DATAGRAM_BATCH_SIZE> packets;
+    std::vector<const Packet*> prefilterPackets;
+
+    ~DatagramBatch() {
+        for (auto& buffer : buffers) {
+            PacketBufferPool::release(std::move(buffer));
+        }
+    }
+
+    // re-arm the headers for another recvmmsg, replacing the buffers that were handed off to packets
+    void prepareForReceive() {
+        for (int i = 0; i < DATAGRAM_BATCH_SIZE; ++i) {
+            if (!buffers[i]) {
+                buffers[i] = PacketBufferPool::acquire();
+            }
+
+            vectors[i].iov_base = buffers[i].get();
+            vectors[i].iov_len = MAX_PACKET_SIZE;
+
+            memset(&headers[i], 0, sizeof(mmsghdr));
+            headers[i].msg_hdr.msg_name = &addresses[i];
+            headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            headers[i].msg_hdr.msg_iov = &vectors[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+        }
+    }
+};
+
+#else
+
+struct Socket::DatagramBatch {};
+
+#endif
+
 
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
@@ -56,6 +111,28 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     const int READY_READ_BACKUP_CHECK_MSECS = 2 * 1000;
     connect(_readyReadBackupTimer, &QTimer::timeout, this, &Socket::checkForReadyReadBackup);
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
+
+#ifdef UDT_BATCHED_DATAGRAMS
+    _receiveBatch.reset(new DatagramBatch());
+#endif
+
+    // the congestion control can be picked per process for testing, e.g. HIFI_UDT_CONGESTION_CONTROL=bbr
+    static const QString CONGESTION_CONTROL_ENV = "HIFI_UDT_CONGESTION_CONTROL";
+    auto environment = QProcessEnvironment::systemEnvironment();
+    if (environment.contains(CONGESTION_CONTROL_ENV)) {
+        auto name = environment.value(CONGESTION_CONTROL_ENV);
+        auto ccFactory = createCongestionControlFactory(name);
+        if (ccFactory) {
+            qCDebug(networking) << "Using" << name << "congestion control";
+            setCongestionControlFactory(std::move(ccFactory));
+        } else {
+            qCWarning(networking) << "Unknown congestion control" << name << "- using the default";
+        }
+    }
+}
+
+Socket::~Socket() {
+    // out of line so that DatagramBatch is a complete type here
 }
 
 void Socket::bind(const QHostAddress& address, quint16 port) {
@@ -136,6 +213,12 @@ qint64 Socket::writeBasePacket(const udt::BasePacket& packet, const HifiSockAddr
 qint64 Socket::writePacket(const Packet& packet, const HifiSockAddr& sockAddr) {
     Q_ASSERT_X(!packet.isReliable(), "Socket::writePacket", "Cannot send a reliable packet unreliably");
 
+    stampUnreliablePacket(packet, sockAddr);
+
+    return writeDatagram(packet.getData(), packet.getDataSize(), sockAddr);
+}
+
+void Socket::stampUnreliablePacket(const Packet& packet, const HifiSockAddr& sockAddr) {
     SequenceNumber sequenceNumber;
     {
         Lock lock(_unreliableSequenceNumbersMutex);
@@ -150,8 +233,6 @@ qint64 Socket::writePacket(const Packet& packet, const HifiSockAddr& sockAddr) {
 
     // write the correct sequence number to the Packet here
     packet.writeSequenceNumber(sequenceNumber);
-
-    return writeDatagram(packet.getData(), packet.getDataSize(), sockAddr);
 }
 
 qint64 Socket::writePacket(std::unique_ptr<Packet> packet, const HifiSockAddr& sockAddr) {
@@ -197,12 +278,20 @@ qint64 Socket::writePacketList(std::unique_ptr<PacketList> packetList, const Hif
         return 0;
     }
 
-    // Unerliable and Unordered
-    qint64 totalBytesSent = 0;
+    // Unreliable and Unordered - stamp every packet and then hand them to the socket together
+    std::vector<std::unique_ptr<Packet>> packets;
+    std::vector<QByteArray> datagrams;
+    packets.reserve(packetList->getNumPackets());
+    datagrams.reserve(packetList->getNumPackets());
+
     while (!packetList->_packets.empty()) {
-        totalBytesSent += writePacket(packetList->takeFront<Packet>(), sockAddr);
+        auto packet = packetList->takeFront<Packet>();
+        stampUnreliablePacket(*packet, sockAddr);
+        datagrams.push_back(QByteArray::fromRawData(packet->getData(), packet->getDataSize()));
+        packets.push_back(std::move(packet));
     }
-    return totalBytesSent;
+
+    return writeDatagrams(datagrams, sockAddr);
 }
 
 void Socket::writeReliablePacket(Packet* packet, const HifiSockAddr& sockAddr) {
@@ -244,6 +333,11 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
         return -1;
     }
     qint64 bytesWritten = _udpSocket.writeDatagram(datagram, sockAddr.getAddress(), sockAddr.getPort());
+    ++_sendCalls;
+    if (bytesWritten > 0) {
+        ++_sentDatagrams;
+    }
+
     int pending = _udpSocket.bytesToWrite();
     if (bytesWritten < 0 || pending) {
         int wsaError = 0;
@@ -270,6 +364,65 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
     return bytesWritten;
 }
 
+qint64 Socket::writeDatagrams(const std::vector<QByteArray>& datagrams, const HifiSockAddr& sockAddr) {
+    qint64 totalBytesWritten = 0;
+    size_t offset = 0;
+
+#ifdef UDT_BATCHED_DATAGRAMS
+    if (_udpSocket.state() == QAbstractSocket::BoundState
+        && sockAddr.getAddress().protocol() == QAbstractSocket::IPv4Protocol) {
+
+        sockaddr_in destination;
+        memset(&destination, 0, sizeof(destination));
+        destination.sin_family = AF_INET;
+        destination.sin_addr.s_addr = htonl(sockAddr.getAddress().toIPv4Address());
+        destination.sin_port = htons(sockAddr.getPort());
+
+        std::array<mmsghdr, DATAGRAM_BATCH_SIZE> headers;
+        std::array<iovec, DATAGRAM_BATCH_SIZE> vectors;
+
+        while (offset < datagrams.size()) {
+            int count = (int)std::min(datagrams.size() - offset, (size_t)DATAGRAM_BATCH_SIZE);
+
+            for (int i = 0; i < count; ++i) {
+                const auto& datagram = datagrams[offset + i];
+                vectors[i].iov_base = const_cast<char*>(datagram.constData());
+                vectors[i].iov_len = datagram.size();
+
+                memset(&headers[i], 0, sizeof(mmsghdr));
+                headers[i].msg_hdr.msg_name = &destination;
+                headers[i].msg_hdr.msg_namelen = sizeof(destination);
+                headers[i].msg_hdr.msg_iov = &vectors[i];
+                headers[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            int numSent = sendmmsg((int)_udpSocket.socketDescriptor(), headers.data(), count, 0);
+            ++_sendCalls;
+
+            if (numSent <= 0) {
+                // fall back to writing one at a time below, which will report whatever went wrong
+                break;
+            }
+
+            _sentDatagrams += numSent;
+            for (int i = 0; i < numSent; ++i) {
+                totalBytesWritten += headers[i].msg_len;
+            }
+            offset += numSent;
+        }
+    }
+#endif
+
+    for (; offset < datagrams.size(); ++offset) {
+        auto bytesWritten = writeDatagram(datagrams[offset], sockAddr);
+        if (bytesWritten > 0) {
+            totalBytesWritten += bytesWritten;
+        }
+    }
+
+    return totalBytesWritten;
+}
+
 Connection* Socket::findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreate) {
     Lock connectionsLock(_connectionsHashMutex);
     auto it = _connectionsHash.find(sockAddr);
@@ -393,12 +546,15 @@ void Socket::readPendingDatagrams() {
         // setup a HifiSockAddr to read into
         HifiSockAddr senderSockAddr;
 
-        // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        // setup a buffer to read the packet into, recycled from the pool unless the datagram is oversized
+        bool isBufferPooled = packetSizeWithHeader <= PacketBufferPool::BUFFER_SIZE;
+        auto buffer = isBufferPooled ? PacketBufferPool::acquire()
+                                     : std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
 
         // pull the datagram
         auto sizeRead = _udpSocket.readDatagram(buffer.get(), packetSizeWithHeader,
                                                 senderSockAddr.getAddressPointer(), senderSockAddr.getPortPointer());
+        ++_receiveCalls;
 
         // save information for this packet, in case it is the one that sticks readyRead
         _lastPacketSizeRead = sizeRead;
@@ -407,77 +563,180 @@ void Socket::readPendingDatagrams() {
         if (sizeRead <= 0) {
             // we either didn't pull anything for this packet or there was an error reading (this seems to trigger
             // on windows even if there's not a packet available)
+            if (isBufferPooled) {
+                PacketBufferPool::release(std::move(buffer));
+            }
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        ++_receivedDatagrams;
+        processDatagram(std::move(buffer), isBufferPooled, packetSizeWithHeader, senderSockAddr, receiveTime);
+
+#ifdef UDT_BATCHED_DATAGRAMS
+        // reading through QUdpSocket above re-armed its read notifier,
+        // so drain whatever else is queued in the kernel with as few recvmmsg calls as we can
+        while (system_clock::now() < abortTime && readDatagramBatch() == DATAGRAM_BATCH_SIZE) {}
+#endif
+    }
+}
+
+int Socket::readDatagramBatch() {
+#ifdef UDT_BATCHED_DATAGRAMS
+    auto& batch = *_receiveBatch;
+    batch.prepareForReceive();
+
+    int numReceived = recvmmsg((int)_udpSocket.socketDescriptor(), batch.headers.data(), DATAGRAM_BATCH_SIZE,
+                               MSG_DONTWAIT, nullptr);
+    ++_receiveCalls;
+
+    if (numReceived <= 0) {
+        return 0;
+    }
+
+    _receivedDatagrams += numReceived;
+
+    auto receiveTime = p_high_resolution_clock::now();
+
+    if (_packetBatchPrefilterOperator) {
+        // build the data packets up front so that the prefilter sees all of them before any is filtered
+        batch.prefilterPackets.clear();
+        for (int i = 0; i < numReceived; ++i) {
+            const auto& header = batch.headers[i];
+            if (header.msg_len == 0 || (header.msg_hdr.msg_flags & MSG_TRUNC)) {
+                continue;
+            }
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
+            HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&batch.addresses[i]));
+            bool isControlPacket = *reinterpret_cast<uint32_t*>(batch.buffers[i].get()) & CONTROL_BIT_MASK;
+            if (isControlPacket || _unfilteredHandlers.find(senderSockAddr) != _unfilteredHandlers.end()) {
+                continue;
             }
 
+            auto packet = Packet::fromReceivedPacket(std::move(batch.buffers[i]), header.msg_len, senderSockAddr);
+            packet->setBufferIsPooled(true);
+            packet->setReceiveTime(receiveTime);
+            batch.prefilterPackets.push_back(packet.get());
+            batch.packets[i] = std::move(packet);
+        }
+
+        if (!batch.prefilterPackets.empty()) {
+            _packetBatchPrefilterOperator(batch.prefilterPackets);
+        }
+    }
+
+    for (int i = 0; i < numReceived; ++i) {
+        const auto& header = batch.headers[i];
+        HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&batch.addresses[i]));
+
+        _lastPacketSizeRead = header.msg_len;
+        _lastPacketSockAddr = senderSockAddr;
+
+        if (batch.packets[i]) {
+            _readyReadBackupTimer->start();
+            processDataPacket(std::move(batch.packets[i]));
             continue;
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        if (header.msg_len == 0 || (header.msg_hdr.msg_flags & MSG_TRUNC)) {
+            // nothing we send is larger than MAX_PACKET_SIZE, drop anything that was
+            continue;
+        }
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+        _readyReadBackupTimer->start();
+        processDatagram(std::move(batch.buffers[i]), true, header.msg_len, senderSockAddr, receiveTime);
+    }
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+    if (_packetBatchPrefilterOperator && !batch.prefilterPackets.empty()) {
+        batch.prefilterPackets.clear();
+        _packetBatchPrefilterOperator(batch.prefilterPackets);
+    }
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
-            }
+    return numReceived;
+#else
+    return 0;
+#endif
+}
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+void Socket::processDatagram(std::unique_ptr<char[]> buffer, bool isBufferPooled, qint64 packetSizeWithHeader,
+                             const HifiSockAddr& senderSockAddr, p_high_resolution_clock::time_point receiveTime) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setBufferIsPooled(isBufferPooled);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        } else if (isBufferPooled) {
+            PacketBufferPool::release(std::move(buffer));
+        }
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+        return;
+    }
+
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setBufferIsPooled(isBufferPooled);
+        controlPacket->setReceiveTime(receiveTime);
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setBufferIsPooled(isBufferPooled);
+        packet->setReceiveTime(receiveTime);
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+        processDataPacket(std::move(packet));
+    }
+}
+
+void Socket::processDataPacket(std::unique_ptr<Packet> packet) {
+    const auto& senderSockAddr = packet->getSenderSockAddr();
+
+    // save the sequence number in case this is the packet that sticks readyRead
+    _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+    // call our verification operator to see if this packet is verified
+    if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+        auto connection = findOrCreateConnection(senderSockAddr, true);
+
+        if (packet->isReliable()) {
+            // if this was a reliable packet then signal the matching connection with the sequence number
+
+            if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                          packet->getDataSize(),
+                                                                          packet->getPayloadSize())) {
+                // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+                qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                    << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
-                }
-
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
-                }
+                return;
             }
+        } else if (connection) {
+            connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                        packet->getPayloadSize());
+        }
+
+        if (packet->isPartOfMessage()) {
+            auto connection = findOrCreateConnection(senderSockAddr, true);
+            if (connection) {
+                connection->queueReceivedMessagePacket(std::move(packet));
+            }
+        } else if (_packetHandler) {
+            // call the verified packet callback to let it handle this packet
+            _packetHandler(std::move(packet));
         }
     }
 }
@@ -516,6 +775,15 @@ ConnectionStats::Stats Socket::sampleStatsForConnection(const HifiSockAddr& dest
     }
 }
 
+Socket::IOStats Socket::sampleIOStats() {
+    IOStats stats;
+    stats.receiveCalls = _receiveCalls.exchange(0);
+    stats.receivedDatagrams = _receivedDatagrams.exchange(0);
+    stats.sendCalls = _sendCalls.exchange(0);
+    stats.sentDatagrams = _sentDatagrams.exchange(0);
+    return stats;
+}
+
 Socket::StatsVector Socket::sampleStatsForAllConnections() {
     StatsVector result;
     Lock connectionsLock(_connectionsHashMutex);
@@ -14,10 +14,12 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <atomic>
 #include <functional>
 #include <unordered_map>
 #include <mutex>
 #include <list>
+#include <vector>
 
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
@@ -39,6 +41,9 @@ class PacketList;
 class SequenceNumber;
 
 using PacketFilterOperator = std::function<bool(const Packet&)>;
+// Called with the data packets of a received batch before any of them is filtered, so that expensive parts of
+// filtering can be done for the whole batch at once, then with an empty batch once they have all been processed.
+using PacketBatchPrefilterOperator = std::function<void(const std::vector<const Packet*>&)>;
 using ConnectionCreationFilterOperator = std::function<bool(const HifiSockAddr&)>;
 
 using BasePacketHandler = std::function<void(std::unique_ptr<BasePacket>)>;
@@ -54,8 +59,17 @@ class Socket : public QObject {
 
 public:
     using StatsVector = std::vector<std::pair<HifiSockAddr, ConnectionStats::Stats>>;
+
+    // counts of the system calls made and datagrams moved through them since the last sample
+    struct IOStats {
+        uint64_t receiveCalls { 0 };
+        uint64_t receivedDatagrams { 0 };
+        uint64_t sendCalls { 0 };
+        uint64_t sentDatagrams { 0 };
+    };
     
     Socket(QObject* object = 0, bool shouldChangeSocketOptions = true);
+    ~Socket();
     
     quint16 localPort() const { return _udpSocket.localPort(); }
     
@@ -66,12 +80,17 @@ public:
     qint64 writePacketList(std::unique_ptr<PacketList> packetList, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr);
+
+    // Writes several datagrams to the same destination, in a single system call where the platform allows it
+    qint64 writeDatagrams(const std::vector<QByteArray>& datagrams, const HifiSockAddr& sockAddr);
     
     void bind(const QHostAddress& address, quint16 port = 0);
     void rebind(quint16 port);
     void rebind();
 
     void setPacketFilterOperator(PacketFilterOperator filterOperator) { _packetFilterOperator = filterOperator; }
+    void setPacketBatchPrefilterOperator(PacketBatchPrefilterOperator prefilterOperator)
+        { _packetBatchPrefilterOperator = prefilterOperator; }
     void setPacketHandler(PacketHandler handler) { _packetHandler = handler; }
     void setMessageHandler(MessageHandler handler) { _messageHandler = handler; }
     void setMessageFailureHandler(MessageFailureHandler handler) { _messageFailureHandler = handler; }
@@ -81,6 +100,7 @@ public:
     void addUnfilteredHandler(const HifiSockAddr& senderSockAddr, BasePacketHandler handler)
         { _unfilteredHandlers[senderSockAddr] = handler; }
     
+    // applies to connections created from now on
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
@@ -88,6 +108,7 @@ public:
     void messageFailed(Connection* connection, Packet::MessageNumber messageNumber);
     
     StatsVector sampleStatsForAllConnections();
+    IOStats sampleIOStats();
 
 #if (PR_BUILD || DEV_BUILD)
     void sendFakedHandshakeRequest(const HifiSockAddr& sockAddr);
@@ -110,6 +131,12 @@ private slots:
 
 private:
     void setSystemBufferSizes();
+    void stampUnreliablePacket(const Packet& packet, const HifiSockAddr& sockAddr);
+    void processDatagram(std::unique_ptr<char[]> buffer, bool isBufferPooled, qint64 size,
+                         const HifiSockAddr& senderSockAddr, p_high_resolution_clock::time_point receiveTime);
+    void processDataPacket(std::unique_ptr<Packet> packet);
+    int readDatagramBatch();
+
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreation = false);
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
@@ -123,6 +150,7 @@ private:
     
     QUdpSocket _udpSocket { this };
     PacketFilterOperator _packetFilterOperator;
+    PacketBatchPrefilterOperator _packetBatchPrefilterOperator;
     PacketHandler _packetHandler;
     MessageHandler _messageHandler;
     MessageFailureHandler _messageFailureHandler;
@@ -137,6 +165,15 @@ private:
 
     QTimer* _readyReadBackupTimer { nullptr };
 
+    // preallocated recvmmsg/sendmmsg state, only used on platforms with batched datagram calls
+    struct DatagramBatch;
+    std::unique_ptr<DatagramBatch> _receiveBatch;
+
+    std::atomic<uint64_t> _receiveCalls { 0 };
+    std::atomic<uint64_t> _receivedDatagrams { 0 };
+    std::atomic<uint64_t> _sendCalls { 0 };
+    std::atomic<uint64_t> _sentDatagrams { 0 };
+
     int _maxBandwidth { -1 };
 
     std::unique_ptr<CongestionControlVirtualFactory> _ccFactory { new CongestionControlFactory<TCPVegasCC>() };
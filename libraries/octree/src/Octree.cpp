@@ -16,6 +16,7 @@
 #include <cmath>
 #include <fstream> // to load voxels from file
 
+#include <QBuffer>
 #include <QDataStream>
 #include <QDebug>
 #include <QEventLoop>
@@ -47,12 +48,13 @@
 #include <ViewFrustum.h>
 
 #include "OctreeConstants.h"
+#include "OctreeDataUtils.h"
 #include "OctreeLogging.h"
 #include "OctreeQueryNode.h"
 #include "OctreeUtils.h"
 #include "OctreeEntitiesFileParser.h"
 
-QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz", "snapshot"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -672,16 +674,19 @@ OctreeElementPointer Octree::getElementEnclosingPoint(const glm::vec3& point, Oc
 bool Octree::readFromFile(const char* fileName) {
     QString qFileName = findMostRecentFileExtension(fileName, PERSIST_EXTENSIONS);
 
-    if (qFileName.endsWith(".json.gz")) {
-        return readJSONFromGzippedFile(qFileName);
-    }
-
     QFile file(qFileName);
 
     if (!file.open(QIODevice::ReadOnly)) {
         return false;
     }
 
+    // the domain-server may have replaced the file with its gzipped JSON, whatever the extension
+    static const QByteArray GZIP_MAGIC { "\x1f\x8b" };
+    if (qFileName.endsWith(".json.gz") || file.peek(GZIP_MAGIC.size()) == GZIP_MAGIC) {
+        file.close();
+        return readJSONFromGzippedFile(qFileName);
+    }
+
     QDataStream fileInputStream(&file);
     QFileInfo fileInfo(qFileName);
     uint64_t fileLength = fileInfo.size();
@@ -699,10 +704,8 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
         qCritical() << "Cannot open gzipped json file for reading: " << qFileName;
         return false;
     }
-    QByteArray compressedJsonData = file.readAll();
     QByteArray jsonData;
-
-    if (!gunzip(compressedJsonData, jsonData)) {
+    if (!gunzip(file, jsonData)) {
         qCritical() << "json File not in gzip format: " << qFileName;
         return false;
     }
@@ -782,7 +785,10 @@ bool Octree::readFromStream(
     device->getChar(&firstChar);
     device->ungetChar(firstChar);
 
-    if (firstChar == (char) PacketType::EntityData) {
+    if (OctreeUtils::isSnapshot(device->peek(OctreeUtils::SNAPSHOT_MAGIC_SIZE))) {
+        qCDebug(octree) << "Reading from binary snapshot stream length:" << streamLength;
+        return readSnapshotFromStream(inputStream);
+    } else if (firstChar == (char) PacketType::EntityData) {
         qCWarning(octree) << "Reading from binary SVO no longer supported";
         return false;
     } else {
@@ -812,7 +818,6 @@ QVariantMap addMarketplaceIDToDocumentEntities(QVariantMap& doc, const QString&
 }
 
 }  // Unnamed namepsace
-const int READ_JSON_BUFFER_SIZE = 2048;
 
 bool Octree::readJSONFromStream(
     uint64_t streamLength,
@@ -823,18 +828,14 @@ bool Octree::readJSONFromStream(
     // we get an eof.  Leave streamLength parameter for consistency.
 
     QByteArray jsonBuffer;
-    char* rawData = new char[READ_JSON_BUFFER_SIZE];
-    while (!inputStream.atEnd()) {
-        int got = inputStream.readRawData(rawData, READ_JSON_BUFFER_SIZE - 1);
-        if (got < 0) {
-            qCritical() << "error while reading from json stream";
-            delete[] rawData;
-            return false;
-        }
-        if (got == 0) {
-            break;
-        }
-        jsonBuffer += QByteArray(rawData, got);
+    QIODevice* device = inputStream.device();
+    auto buffer = qobject_cast<QBuffer*>(device);
+    if (buffer && buffer->pos() == 0) {
+        // share the data we were handed rather than copying it
+        jsonBuffer = buffer->data();
+        buffer->seek(jsonBuffer.size());
+    } else if (device) {
+        jsonBuffer = device->readAll();
     }
 
     OctreeEntitiesFileParser octreeParser;
@@ -849,9 +850,28 @@ bool Octree::readJSONFromStream(
         addMarketplaceIDToDocumentEntities(asMap, marketplaceID);
     }
 
-    bool success = readFromMap(asMap);
-    delete[] rawData;
-    return success;
+    return readFromMap(asMap);
+}
+
+bool Octree::readSnapshotFromStream(QDataStream& inputStream) {
+    QUuid id;
+    OctreeUtils::Version dataVersion;
+    OctreeUtils::Version version;
+    if (!OctreeUtils::readSnapshotHeader(inputStream, id, dataVersion, version)) {
+        qCritical() << "Invalid binary snapshot header";
+        return false;
+    }
+
+    // the records are only readable by the data version that wrote them, older content is loaded from JSON
+    if (version != expectedVersion()) {
+        qCritical() << "Binary snapshot was written with data version" << version << "but this tree reads" << expectedVersion();
+        return false;
+    }
+
+    _persistID = id;
+    _persistDataVersion = (int)dataVersion;
+
+    return readSnapshotData(inputStream);
 }
 
 bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& element, QString persistAsFileType) {
@@ -865,6 +885,8 @@ bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& eleme
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == "snapshot") {
+        success = writeToSnapshotFile(cFileName);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -970,6 +992,31 @@ bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& e
     return success;
 }
 
+bool Octree::writeToSnapshotFile(const char* fileName) {
+    qCDebug(octree, "Saving binary snapshot to file %s...", fileName);
+
+    QSaveFile persistFile(fileName);
+    if (!persistFile.open(QIODevice::WriteOnly)) {
+        qCritical("Failed to open snapshot file for writing.");
+        return false;
+    }
+
+    QDataStream outputStream(&persistFile);
+    OctreeUtils::writeSnapshotHeader(outputStream, _persistID, _persistDataVersion, expectedVersion());
+
+    if (!writeSnapshotData(outputStream) || outputStream.status() != QDataStream::Ok) {
+        qCritical() << "Failed to write snapshot file:" << persistFile.errorString();
+        persistFile.cancelWriting();
+        return false;
+    }
+
+    bool success = persistFile.commit();
+    if (!success) {
+        qCritical() << "Failed to commit to snapshot file:" << persistFile.errorString();
+    }
+    return success;
+}
+
 uint64_t Octree::getOctreeElementsCount() {
     uint64_t nodeCount = 0;
     recurseTreeWithOperation(countOctreeElementsOperation, &nodeCount);
@@ -32,6 +32,7 @@
 
 class ReadBitstreamToTreeParams;
 class Octree;
+class OctreeEditLog;
 class OctreeElement;
 class OctreePacketData;
 class Shape;
@@ -210,10 +211,14 @@ public:
     bool toJSON(QByteArray* data, const OctreeElementPointer& element = nullptr, bool doGzip = false);
     bool writeToFile(const char* filename, const OctreeElementPointer& element = nullptr, QString persistAsFileType = "json.gz");
     bool writeToJSONFile(const char* filename, const OctreeElementPointer& element = nullptr, bool doGzip = false);
+    bool writeToSnapshotFile(const char* filename);
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
 
+    // Binary snapshots: the header is written by the Octree, the records by trees that support the format
+    virtual bool writeSnapshotData(QDataStream& outputStream) { return false; }
+
     // Octree importers
     bool readFromFile(const char* filename);
     bool readFromURL(const QString& url, const bool isObservable = true, const qint64 callerId = -1); // will support file urls as well...
@@ -221,7 +226,13 @@ public:
     bool readSVOFromStream(uint64_t streamLength, QDataStream& inputStream);
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="");
     bool readJSONFromGzippedFile(QString qFileName);
+    bool readSnapshotFromStream(QDataStream& inputStream);
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
+    virtual bool readSnapshotData(QDataStream& inputStream) { return false; }
+
+    // Edit log: trees that support it append the edits they accept to the log, and replay its records after loading
+    void setEditLog(std::shared_ptr<OctreeEditLog> editLog) { _editLog = editLog; }
+    virtual bool replayEditLogRecord(const QByteArray& record) { return false; }
 
     uint64_t getOctreeElementsCount();
 
@@ -250,6 +261,8 @@ public:
         _persistID = id;
         _persistDataVersion = dataVersion;
     }
+    QUuid getPersistID() const { return _persistID; }
+    int64_t getPersistDataVersion() const { return _persistDataVersion; }
 
     virtual void resetEditStats() { }
     virtual quint64 getAverageDecodeTime() const { return 0; }
@@ -277,6 +290,8 @@ protected:
     QUuid _persistID { QUuid::createUuid() };
     int _persistDataVersion { 0 };
 
+    std::shared_ptr<OctreeEditLog> _editLog;
+
     bool _isDirty;
     bool _shouldReaverage;
 
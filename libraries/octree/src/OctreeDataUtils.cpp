@@ -14,6 +14,8 @@
 #include <Gzip.h>
 #include <udt/PacketHeaders.h>
 
+#include <cstring>
+
 #include <QDebug>
 #include <QJsonObject>
 #include <QJsonDocument>
@@ -29,7 +31,44 @@ bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromMap(const QVariantMap& ma
     return true;
 }
 
+bool OctreeUtils::isSnapshot(const QByteArray& data) {
+    return data.startsWith(SNAPSHOT_MAGIC);
+}
+
+void OctreeUtils::writeSnapshotHeader(QDataStream& stream, const QUuid& id, Version dataVersion, Version version) {
+    stream.setVersion(SNAPSHOT_STREAM_VERSION);
+    stream.writeRawData(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+    stream << SNAPSHOT_FORMAT_VERSION << (qint64)version << id << (qint64)dataVersion;
+}
+
+bool OctreeUtils::readSnapshotHeader(QDataStream& stream, QUuid& id, Version& dataVersion, Version& version) {
+    stream.setVersion(SNAPSHOT_STREAM_VERSION);
+
+    char magic[SNAPSHOT_MAGIC_SIZE];
+    if (stream.readRawData(magic, SNAPSHOT_MAGIC_SIZE) != SNAPSHOT_MAGIC_SIZE ||
+        memcmp(magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0) {
+        return false;
+    }
+
+    quint32 formatVersion;
+    qint64 packetVersion;
+    qint64 snapshotDataVersion;
+    stream >> formatVersion >> packetVersion >> id >> snapshotDataVersion;
+    if (stream.status() != QDataStream::Ok || formatVersion != SNAPSHOT_FORMAT_VERSION) {
+        return false;
+    }
+
+    version = packetVersion;
+    dataVersion = snapshotDataVersion;
+    return true;
+}
+
 bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromData(QByteArray data) {
+    if (isSnapshot(data)) {
+        QDataStream snapshotStream(data);
+        return readSnapshotHeader(snapshotStream, id, dataVersion, version);
+    }
+
     QByteArray jsonData;
     if (gunzip(data, jsonData)) {
         data = jsonData;
@@ -37,6 +76,7 @@ bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromData(QByteArray data) {
 
     OctreeEntitiesFileParser jsonParser;
     jsonParser.setEntitiesString(data);
+    jsonParser.setSkipEntities(!readsElements());
     QVariantMap entitiesMap;
     if (!jsonParser.parseEntities(entitiesMap)) {
         qCritical() << "Can't parse Entities JSON: " << jsonParser.getErrorString().c_str();
@@ -13,6 +13,7 @@
 
 #include <udt/PacketHeaders.h>
 
+#include <QDataStream>
 #include <QJsonObject>
 #include <QUuid>
 #include <QJsonArray>
@@ -22,6 +23,17 @@ namespace OctreeUtils {
 using Version = int64_t;
 constexpr Version INITIAL_VERSION = 0;
 
+// Binary snapshots start with this magic, then the snapshot format version, the data packet version the records
+// were encoded with, the persist ID and the data version. The records that follow are defined by the tree type.
+constexpr char SNAPSHOT_MAGIC[] = "HFOS";
+constexpr int SNAPSHOT_MAGIC_SIZE = sizeof(SNAPSHOT_MAGIC) - 1;
+constexpr quint32 SNAPSHOT_FORMAT_VERSION = 1;
+constexpr QDataStream::Version SNAPSHOT_STREAM_VERSION = QDataStream::Qt_5_9;
+
+bool isSnapshot(const QByteArray& data);
+void writeSnapshotHeader(QDataStream& stream, const QUuid& id, Version dataVersion, Version version);
+bool readSnapshotHeader(QDataStream& stream, QUuid& id, Version& dataVersion, Version& version);
+
 //using PacketType = uint8_t;
 
 // RawOctreeData is an intermediate format between JSON and a fully deserialized Octree.
@@ -36,6 +48,9 @@ public:
     virtual void readSubclassData(const QVariantMap& root) { }
     virtual void writeSubclassData(QByteArray& root) const { }
 
+    // whether readSubclassData() needs the parsed elements, rather than just the header values
+    virtual bool readsElements() const { return false; }
+
     void resetIdAndVersion();
     QByteArray toByteArray();
     QByteArray toGzippedByteArray();
@@ -50,6 +65,7 @@ public:
     PacketType dataPacketType() const override;
     void readSubclassData(const QVariantMap& root) override;
     void writeSubclassData(QByteArray& root) const override;
+    bool readsElements() const override { return true; }
 
     QVariantList variantEntityData;
 };
@@ -0,0 +1,329 @@
+//
+//  OctreeEditLog.cpp
+//  libraries/octree/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEditLog.h"
+
+#include <QtCore/QSaveFile>
+#include <QtCore/QtEndian>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <SharedUtil.h>
+
+#include "OctreeLogging.h"
+
+// the log starts with this magic, the format version and the persist ID of the data it follows on from
+static const char EDIT_LOG_MAGIC[] = "HFEL";
+static const int EDIT_LOG_MAGIC_SIZE = sizeof(EDIT_LOG_MAGIC) - 1;
+static const quint32 EDIT_LOG_FORMAT_VERSION = 1;
+
+// then come the frames: their type, the payload size, the payload and a checksum of all three
+static const int FRAME_HEADER_SIZE = sizeof(quint8) + sizeof(quint32);
+static const int FRAME_CHECKSUM_SIZE = sizeof(quint16);
+
+static QByteArray makeHeader(const QUuid& persistID) {
+    char formatVersion[sizeof(quint32)];
+    qToBigEndian<quint32>(EDIT_LOG_FORMAT_VERSION, formatVersion);
+
+    QByteArray header(EDIT_LOG_MAGIC, EDIT_LOG_MAGIC_SIZE);
+    header.append(formatVersion, sizeof(formatVersion));
+    header.append(persistID.toRfc4122());
+    return header;
+}
+
+// reads the frame at offset and moves past it, returning false for a torn or corrupt frame
+static bool readFrame(const QByteArray& data, qint64& offset, quint8& type, QByteArray& payload) {
+    qint64 remaining = data.size() - offset;
+    if (remaining < FRAME_HEADER_SIZE + FRAME_CHECKSUM_SIZE) {
+        return false;
+    }
+
+    const char* frame = data.constData() + offset;
+    quint32 payloadSize = qFromBigEndian<quint32>(frame + sizeof(quint8));
+    if ((qint64)payloadSize > remaining - FRAME_HEADER_SIZE - FRAME_CHECKSUM_SIZE) {
+        return false;
+    }
+
+    uint checksummedSize = FRAME_HEADER_SIZE + payloadSize;
+    if (qFromBigEndian<quint16>(frame + checksummedSize) != qChecksum(frame, checksummedSize)) {
+        return false;
+    }
+
+    type = (quint8)frame[0];
+    payload = QByteArray::fromRawData(frame + FRAME_HEADER_SIZE, (int)payloadSize);
+    offset += checksummedSize + FRAME_CHECKSUM_SIZE;
+    return true;
+}
+
+static bool syncFile(QFile& file) {
+    if (!file.flush()) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
+
+OctreeEditLog::OctreeEditLog(const QString& filename) :
+    _filename(filename),
+    _file(filename)
+{
+}
+
+OctreeEditLog::~OctreeEditLog() {
+    stopFlushing();
+    flush();
+}
+
+int OctreeEditLog::open(const QUuid& persistID, int64_t dataVersion, const std::function<bool(const QByteArray&)>& apply) {
+    std::lock_guard<std::mutex> fileLock(_fileMutex);
+    _persistID = persistID;
+    _file.close();
+
+    QByteArray contents;
+    QFile file(_filename);
+    if (file.open(QIODevice::ReadOnly)) {
+        contents = file.readAll();
+        file.close();
+    }
+
+    QByteArray header = makeHeader(persistID);
+    if (!contents.startsWith(header)) {
+        if (!contents.isEmpty()) {
+            qCDebug(octree) << "Edit log" << _filename << "doesn't follow on from the loaded data, starting it over";
+        }
+        reset(dataVersion);
+        return 0;
+    }
+
+    int numApplied = 0;
+    int numFailed = 0;
+    qint64 checkpointOffset = -1;
+    qint64 validSize = header.size();
+    qint64 offset = validSize;
+    quint8 type;
+    QByteArray payload;
+    while (readFrame(contents, offset, type, payload)) {
+        if ((FrameType)type == FrameType::Checkpoint) {
+            // later checkpoints are for snapshots that were never written, so the records after them still apply
+            if (checkpointOffset < 0 && payload.size() == sizeof(qint64) &&
+                qFromBigEndian<qint64>(payload.constData()) == dataVersion) {
+                checkpointOffset = validSize;
+            }
+        } else if ((FrameType)type == FrameType::Record && checkpointOffset >= 0) {
+            if (apply(payload)) {
+                ++numApplied;
+            } else {
+                ++numFailed;
+            }
+        }
+        validSize = offset;
+    }
+
+    if (checkpointOffset < 0) {
+        qCDebug(octree) << "Edit log" << _filename << "has no checkpoint for data version" << dataVersion
+            << "- starting it over";
+        reset(dataVersion);
+        return 0;
+    }
+
+    if (validSize < contents.size()) {
+        qCWarning(octree) << "Discarding" << (contents.size() - validSize) << "bytes of torn edits at the end of" << _filename;
+    }
+    if (numFailed > 0) {
+        qCWarning(octree) << "Failed to replay" << numFailed << "edits from" << _filename;
+    }
+    qCDebug(octree) << "Replayed" << numApplied << "edits from" << _filename;
+
+    // new frames go after the last good one
+    if (!_file.open(QIODevice::ReadWrite) || !_file.resize(validSize) || !_file.seek(validSize)) {
+        qCWarning(octree) << "Failed to open edit log" << _filename << _file.errorString();
+        _file.close();
+    }
+
+    std::lock_guard<std::mutex> bufferLock(_bufferMutex);
+    _buffer.clear();
+    _bufferOffset = validSize;
+    _checkpointVersion = dataVersion;
+    _checkpointOffset = checkpointOffset;
+    return numApplied;
+}
+
+bool OctreeEditLog::reset(int64_t dataVersion) {
+    QByteArray header = makeHeader(_persistID);
+    {
+        std::lock_guard<std::mutex> bufferLock(_bufferMutex);
+        _buffer.clear();
+        _bufferOffset = header.size();
+    }
+
+    if (!_file.open(QIODevice::ReadWrite | QIODevice::Truncate) || _file.write(header) != header.size()) {
+        qCWarning(octree) << "Failed to create edit log" << _filename << _file.errorString();
+        _file.close();
+        return false;
+    }
+
+    // the loaded data is where the edits that follow start from
+    checkpoint(dataVersion);
+    return writeBuffer();
+}
+
+void OctreeEditLog::append(const QByteArray& record) {
+    std::lock_guard<std::mutex> bufferLock(_bufferMutex);
+    appendFrame(FrameType::Record, record);
+    ++_numAppended;
+}
+
+void OctreeEditLog::checkpoint(int64_t dataVersion) {
+    char payload[sizeof(qint64)];
+    qToBigEndian<qint64>(dataVersion, payload);
+
+    std::lock_guard<std::mutex> bufferLock(_bufferMutex);
+    _checkpointVersion = dataVersion;
+    _checkpointOffset = _bufferOffset + _buffer.size();
+    appendFrame(FrameType::Checkpoint, QByteArray(payload, sizeof(payload)));
+}
+
+void OctreeEditLog::appendFrame(FrameType type, const QByteArray& payload) {
+    char frameHeader[FRAME_HEADER_SIZE];
+    frameHeader[0] = (char)type;
+    qToBigEndian<quint32>(payload.size(), frameHeader + sizeof(quint8));
+
+    int frameStart = _buffer.size();
+    _buffer.append(frameHeader, FRAME_HEADER_SIZE);
+    _buffer.append(payload);
+
+    char checksum[FRAME_CHECKSUM_SIZE];
+    qToBigEndian<quint16>(qChecksum(_buffer.constData() + frameStart, _buffer.size() - frameStart), checksum);
+    _buffer.append(checksum, FRAME_CHECKSUM_SIZE);
+}
+
+bool OctreeEditLog::flush() {
+    std::lock_guard<std::mutex> fileLock(_fileMutex);
+    return writeBuffer();
+}
+
+void OctreeEditLog::startFlushing(std::chrono::milliseconds interval) {
+    stopFlushing();
+
+    _stopFlushing = false;
+    _flushThread = std::thread([this, interval] {
+        std::unique_lock<std::mutex> lock(_flushThreadMutex);
+        while (!_flushThreadCondition.wait_for(lock, interval, [this] { return _stopFlushing; })) {
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    });
+}
+
+void OctreeEditLog::stopFlushing() {
+    if (!_flushThread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_flushThreadMutex);
+        _stopFlushing = true;
+    }
+    _flushThreadCondition.notify_one();
+    _flushThread.join();
+}
+
+bool OctreeEditLog::writeBuffer() {
+    QByteArray buffer;
+    {
+        std::lock_guard<std::mutex> bufferLock(_bufferMutex);
+        buffer.swap(_buffer);
+        _bufferOffset += buffer.size();
+    }
+
+    if (buffer.isEmpty()) {
+        return true;
+    }
+
+    quint64 start = usecTimestampNow();
+    bool success = _file.isOpen() && _file.write(buffer) == buffer.size() && syncFile(_file);
+    _lastFlushUsecs = usecTimestampNow() - start;
+    ++_numFlushes;
+
+    if (!success) {
+        qCWarning(octree) << "Failed to write" << buffer.size() << "bytes of edits to" << _filename << _file.errorString();
+    }
+    return success;
+}
+
+bool OctreeEditLog::compact(int64_t dataVersion) {
+    std::lock_guard<std::mutex> fileLock(_fileMutex);
+    if (!writeBuffer()) {
+        return false;
+    }
+
+    qint64 checkpointOffset;
+    {
+        std::lock_guard<std::mutex> bufferLock(_bufferMutex);
+        if (_checkpointVersion != dataVersion) {
+            return false;   // a later snapshot has already been started
+        }
+        checkpointOffset = _checkpointOffset;
+    }
+
+    QByteArray header = makeHeader(_persistID);
+    qint64 shift = checkpointOffset - header.size();
+    if (shift <= 0) {
+        return true;
+    }
+
+    // keep the checkpoint and everything after it
+    qint64 end = _file.size();
+    QByteArray tail;
+    if (_file.seek(checkpointOffset)) {
+        tail = _file.read(end - checkpointOffset);
+    }
+    _file.seek(end);
+
+    QSaveFile compacted(_filename);
+    if (tail.size() != end - checkpointOffset || !compacted.open(QIODevice::WriteOnly) ||
+        compacted.write(header) != header.size() || compacted.write(tail) != tail.size()) {
+        qCWarning(octree) << "Failed to compact edit log" << _filename << compacted.errorString();
+        compacted.cancelWriting();
+        return false;
+    }
+
+    // the log can't be replaced while it is open on Windows
+    _file.close();
+    bool committed = compacted.commit();
+    if (!committed) {
+        qCWarning(octree) << "Failed to compact edit log" << _filename << compacted.errorString();
+        shift = 0;
+    }
+
+    if (!_file.open(QIODevice::ReadWrite) || !_file.seek(_file.size())) {
+        qCWarning(octree) << "Failed to reopen edit log" << _filename << _file.errorString();
+        _file.close();
+    }
+
+    std::lock_guard<std::mutex> bufferLock(_bufferMutex);
+    _bufferOffset -= shift;
+    _checkpointOffset -= shift;
+    return committed;
+}
+
+qint64 OctreeEditLog::getSize() const {
+    std::lock_guard<std::mutex> bufferLock(_bufferMutex);
+    return _bufferOffset + _buffer.size();
+}
@@ -0,0 +1,100 @@
+//
+//  OctreeEditLog.h
+//  libraries/octree/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeEditLog_h
+#define hifi_OctreeEditLog_h
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QUuid>
+
+//
+// Append-only log of the edits a server has accepted since its last full snapshot, so that a crash loses at most
+// one flush of edits and full snapshots can be taken much less often.
+//
+// The records are opaque to the log and are defined by the tree. They have to describe state rather than deltas:
+// the records appended while a snapshot is being written may or may not be in it, and are replayed on top of it.
+// Before each snapshot the server appends a checkpoint with the data version the snapshot is written with, and once
+// the snapshot is safely on disk the log is compacted down to the records after that checkpoint.
+//
+// append() and checkpoint() only buffer, and are safe from any thread; flush() writes the buffer and syncs the file.
+// startFlushing() flushes periodically on a thread of its own, so that a long snapshot write doesn't hold edits back.
+//
+class OctreeEditLog {
+public:
+    OctreeEditLog(const QString& filename);
+    ~OctreeEditLog();
+
+    const QString& getFilename() const { return _filename; }
+
+    // reads the log and calls apply() with every record after the checkpoint of the loaded data, then leaves the log open
+    // for appending; a log that doesn't follow on from the loaded data is started over. Returns the number of records
+    // that were applied.
+    int open(const QUuid& persistID, int64_t dataVersion, const std::function<bool(const QByteArray&)>& apply);
+
+    void append(const QByteArray& record);
+    void checkpoint(int64_t dataVersion);
+    bool flush();
+
+    void startFlushing(std::chrono::milliseconds interval);
+    void stopFlushing();
+
+    // drops everything before the checkpoint for dataVersion, once the snapshot it marks has been written
+    bool compact(int64_t dataVersion);
+
+    qint64 getSize() const;
+    quint64 getNumAppended() const { return _numAppended; }
+    quint64 getNumFlushes() const { return _numFlushes; }
+    quint64 getLastFlushUsecs() const { return _lastFlushUsecs; }
+
+private:
+    enum class FrameType : quint8 {
+        Checkpoint = 1,
+        Record
+    };
+
+    void appendFrame(FrameType type, const QByteArray& payload);
+    bool writeBuffer();
+    bool reset(int64_t dataVersion);
+
+    QString _filename;
+    QUuid _persistID;
+
+    // guards the file; held while writing, syncing and compacting
+    std::mutex _fileMutex;
+    QFile _file;
+
+    // guards the buffered frames, and the offsets that depend on them
+    mutable std::mutex _bufferMutex;
+    QByteArray _buffer;
+    qint64 _bufferOffset { 0 };          // where the buffer will land in the file
+    int64_t _checkpointVersion { -1 };
+    qint64 _checkpointOffset { -1 };
+
+    std::thread _flushThread;
+    std::mutex _flushThreadMutex;
+    std::condition_variable _flushThreadCondition;
+    bool _stopFlushing { false };
+
+    std::atomic<quint64> _numAppended { 0 };
+    std::atomic<quint64> _numFlushes { 0 };
+    std::atomic<quint64> _lastFlushUsecs { 0 };
+};
+
+#endif // hifi_OctreeEditLog_h
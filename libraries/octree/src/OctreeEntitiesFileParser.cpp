@@ -11,16 +11,23 @@
 
 #include "OctreeEntitiesFileParser.h"
 
+#include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <cctype>
+#include <vector>
 
 #include <QUuid>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QtConcurrent/QtConcurrentMap>
 
 
 using std::string;
 
+// small enough to balance the pool, big enough that scheduling is a rounding error next to parsing
+static const int ENTITIES_PER_PARSE_CHUNK = 256;
+
 std::string OctreeEntitiesFileParser::getErrorString() const {
     std::ostringstream err;
     if (_errorString.size() != 0) {
@@ -219,6 +226,8 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
         return false;
     }
 
+    // find where each entity starts and ends, then parse them on the thread pool
+    std::vector<std::pair<int, int>> entitySpans;
     while (true) {
         if (nextToken() != '{') {
             _errorString = "Entity array item is not an object";
@@ -230,23 +239,56 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
             return false;
         }
 
-        QByteArray jsonEntity = _entitiesContents.mid(_position - 1, matchingBrace - _position + 1);
-        QJsonDocument entity = QJsonDocument::fromJson(jsonEntity);
-        if (entity.isNull()) {
-            _errorString = "Ill-formed entity";
-            return false;
-        }
-
-        entitiesArray.append(entity.object());
+        entitySpans.emplace_back(_position - 1, matchingBrace);
         _position = matchingBrace;
         char c = nextToken();
         if (c == ']') {
-            return true;
+            break;
         } else if (c != ',') {
             _errorString = "Entity array item incorrectly terminated";
             return false;
         }
     }
+
+    if (_skipEntities) {
+        return true;
+    }
+
+    const int numEntities = (int)entitySpans.size();
+    std::vector<QJsonObject> entities(numEntities);
+    std::vector<std::pair<int, int>> chunks;
+    for (int begin = 0; begin < numEntities; begin += ENTITIES_PER_PARSE_CHUNK) {
+        chunks.emplace_back(begin, std::min(begin + ENTITIES_PER_PARSE_CHUNK, numEntities));
+    }
+
+    std::atomic<int> firstIllFormed { numEntities };
+    QtConcurrent::blockingMap(chunks, [&](const std::pair<int, int>& chunk) {
+        for (int i = chunk.first; i < chunk.second; ++i) {
+            const std::pair<int, int>& span = entitySpans[i];
+            QJsonDocument entity = QJsonDocument::fromJson(
+                QByteArray::fromRawData(_entitiesContents.constData() + span.first, span.second - span.first));
+            if (entity.isNull()) {
+                int illFormed = firstIllFormed;
+                while (i < illFormed && !firstIllFormed.compare_exchange_weak(illFormed, i)) {
+                }
+                return;
+            }
+            entities[i] = entity.object();
+        }
+    });
+
+    if (firstIllFormed < numEntities) {
+        // report the error where the serial parse would have
+        _position = entitySpans[firstIllFormed].first + 1;
+        _line = 1 + (int)std::count(_entitiesContents.constData(), _entitiesContents.constData() + _position, '\n');
+        _errorString = "Ill-formed entity";
+        return false;
+    }
+
+    entitiesArray.reserve(numEntities);
+    for (auto& entity : entities) {
+        entitiesArray.append(entity);
+    }
     return true;
 }
 
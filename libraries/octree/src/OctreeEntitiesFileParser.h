@@ -21,6 +21,10 @@ class OctreeEntitiesFileParser {
 public:
     void setEntitiesString(const QByteArray& entitiesContents);
     bool parseEntities(QVariantMap& parsedEntities);
+
+    // only check that the entities are delimited, leaving "Entities" empty, for callers that just need the header values
+    void setSkipEntities(bool skipEntities) { _skipEntities = skipEntities; }
+
     std::string getErrorString() const;
 
 private:
@@ -34,6 +38,7 @@ private:
     int _position { 0 };
     int _line { 1 };
     int _entitiesLength { 0 };
+    bool _skipEntities { false };
     std::string _errorString;
 };
 
@@ -38,7 +38,10 @@
 #include "OctreeDataUtils.h"
 
 constexpr std::chrono::seconds OctreePersistThread::DEFAULT_PERSIST_INTERVAL { 30 };
+constexpr std::chrono::minutes OctreePersistThread::DEFAULT_SNAPSHOT_INTERVAL { 10 };
 constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
+constexpr std::chrono::milliseconds EDIT_LOG_FLUSH_INTERVAL { 250 };
+constexpr qint64 MAX_EDIT_LOG_SIZE_BYTES { 64 * 1000 * 1000 };
 
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
@@ -60,6 +63,12 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     _filename = sansExt + "." + _persistAsFileType;
 }
 
+void OctreePersistThread::enableEditLog(std::chrono::milliseconds snapshotInterval) {
+    QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
+    _editLog = std::make_shared<OctreeEditLog>(sansExt + ".log");
+    _snapshotInterval = snapshotInterval;
+}
+
 void OctreePersistThread::start() {
     cleanupOldReplacementBackups();
 
@@ -81,7 +90,14 @@ void OctreePersistThread::start() {
             _cachedJSONData = jsonData;
         }
 
-        if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
+        bool hasOctreeData = data.readOctreeDataInfoFromData(_cachedJSONData);
+        if (hasOctreeData && OctreeUtils::isSnapshot(_cachedJSONData) && data.version != _tree->expectedVersion()) {
+            // a binary snapshot can't be migrated to a newer data version, so ask for the domain-server's JSON copy
+            qCWarning(octree) << "Snapshot was written with data version" << data.version << "- requesting data from the DS";
+            hasOctreeData = false;
+        }
+
+        if (hasOctreeData) {
             qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
             packet->writePrimitive(true);
             auto id = data.id.toRfc4122();
@@ -109,13 +125,11 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     bool includesNewData;
     message->readPrimitive(&includesNewData);
-    QByteArray replacementData;
     OctreeUtils::RawOctreeData data;
     bool hasValidOctreeData { false };
     if (includesNewData) {
         _cachedJSONData.clear();
-        replacementData = message->readAll();
-        replaceData(replacementData);
+        replaceData(*message);
         hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
         qDebug() << "Got OctreeDataFileReply, new data sent";
     } else {
@@ -149,6 +163,7 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     }
 
     bool persistentFileRead;
+    int numReplayedEdits = 0;
 
     _tree->withWriteLock([&] {
         PerformanceWarning warn(true, "Loading Octree File", true);
@@ -159,6 +174,14 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
             QDataStream jsonStream(_cachedJSONData);
             persistentFileRead = _tree->readFromStream(-1, jsonStream);
         }
+
+        if (_editLog) {
+            // the log is only replayed on top of the data it was checkpointed against, and started over otherwise
+            numReplayedEdits = _editLog->open(_tree->getPersistID(), _tree->getPersistDataVersion(),
+                                              [this](const QByteArray& record) {
+                return _tree->replayEditLogRecord(record);
+            });
+        }
         _tree->pruneTree();
     });
 
@@ -168,6 +191,16 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     _tree->clearDirtyBit(); // the tree is clean since we just loaded it
 
+    if (_editLog) {
+        if (numReplayedEdits > 0) {
+            _tree->setDirtyBit(); // ...apart from the edits replayed from the log
+        }
+        _tree->setEditLog(_editLog);
+
+        // flushed from a thread of its own, so that writing a snapshot doesn't hold back the edits made meanwhile
+        _editLog->startFlushing(EDIT_LOG_FLUSH_INTERVAL);
+    }
+
     unsigned long nodeCount = OctreeElement::getNodeCount();
     unsigned long internalNodeCount = OctreeElement::getInternalNodeCount();
     unsigned long leafNodeCount = OctreeElement::getLeafNodeCount();
@@ -190,8 +223,13 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     // Since we just loaded the persistent file, we can consider ourselves as having just persisted
     _lastPersistCheck = std::chrono::steady_clock::now();
+    _lastSnapshot = _lastPersistCheck;
+    if (!hasValidOctreeData) {
+        // without a snapshot to follow on from, a new persist ID would orphan the log after a crash
+        _lastSnapshot -= _snapshotInterval;
+    }
 
-    if (replacementData.isNull()) {
+    if (!includesNewData) {
         sendLatestEntityDataToDS();
     }
 
@@ -206,16 +244,21 @@ QString OctreePersistThread::getPersistFileMimeType() const {
         return "application/json";
     } if (_persistAsFileType == "json.gz") {
         return "application/zip";
+    } if (_persistAsFileType == "snapshot") {
+        return "application/octet-stream";
     }
     return "";
 }
 
-void OctreePersistThread::replaceData(QByteArray data) {
+void OctreePersistThread::replaceData(ReceivedMessage& message) {
     backupCurrentFile();
 
     QFile currentFile { _filename };
     if (currentFile.open(QIODevice::WriteOnly)) {
-        currentFile.write(data);
+        // write the rest of the message straight from the packets it arrived in
+        message.readSegments(message.getBytesLeftToRead(), [&currentFile](const char* data, qint64 size) {
+            currentFile.write(data, size);
+        });
         qDebug() << "Wrote replacement data";
     } else {
         qWarning() << "Failed to write replacement data";
@@ -250,7 +293,12 @@ void OctreePersistThread::process() {
 
     if (timeSinceLastPersist > _persistInterval) {
         _lastPersistCheck = now;
-        persist();
+
+        // with an edit log the edits are already on disk, so a full snapshot is only taken once in a while,
+        // or once the log has grown big enough to slow down the replay
+        if (!_editLog || now - _lastSnapshot > _snapshotInterval || _editLog->getSize() > MAX_EDIT_LOG_SIZE_BYTES) {
+            persist();
+        }
     }
 
     QTimer::singleShot(TIME_BETWEEN_PROCESSING.count(), this, &OctreePersistThread::process);
@@ -259,6 +307,10 @@ void OctreePersistThread::process() {
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
     persist();
+    if (_editLog) {
+        _editLog->stopFlushing();
+        _editLog->flush();
+    }
     qCDebug(octree) << "Persist thread done with about to finish...";
 }
 
@@ -303,20 +355,38 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
 
 void OctreePersistThread::persist() {
     if (_tree->isDirty() && _initialLoadComplete) {
+        _lastSnapshot = std::chrono::steady_clock::now();
+        int64_t dataVersion;
 
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
             _tree->pruneTree();
             qCDebug(octree) << "DONE pruning Octree before saving...";
+
+            // edits logged after the checkpoint may or may not make it into this snapshot, so they are replayed on top of it
+            _tree->incrementPersistDataVersion();
+            dataVersion = _tree->getPersistDataVersion();
+            if (_editLog) {
+                _editLog->checkpoint(dataVersion);
+            }
         });
 
-        _tree->incrementPersistDataVersion();
+        // the snapshot takes a while to write, get the edits made before it onto disk first
+        if (_editLog) {
+            _editLog->flush();
+        }
 
         qCDebug(octree) << "Saving Octree data to:" << _filename;
+
+        // clear the dirty bit before saving, so that edits made while the file is written are saved next time
+        _tree->clearDirtyBit();
         if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
-            _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
+            if (_editLog) {
+                _editLog->compact(dataVersion);
+            }
         } else {
+            _tree->setDirtyBit();
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
         }
 
@@ -17,6 +17,7 @@
 #include <QString>
 #include <GenericThread.h>
 #include "Octree.h"
+#include "OctreeEditLog.h"
 
 class OctreePersistThread : public QObject {
     Q_OBJECT
@@ -31,6 +32,7 @@ public:
     };
 
     static const std::chrono::seconds DEFAULT_PERSIST_INTERVAL;
+    static const std::chrono::minutes DEFAULT_SNAPSHOT_INTERVAL;
 
     OctreePersistThread(OctreePointer tree,
                         const QString& filename,
@@ -45,6 +47,10 @@ public:
     QString getPersistFileMimeType() const;
     QByteArray getPersistFileContents() const;
 
+    /// log accepted edits next to the persist file and replay them on load, so that full snapshots can be taken less often
+    void enableEditLog(std::chrono::milliseconds snapshotInterval = DEFAULT_SNAPSHOT_INTERVAL);
+    std::shared_ptr<OctreeEditLog> getEditLog() const { return _editLog; }
+
     void aboutToFinish(); /// call this to inform the persist thread that the owner is about to finish to support final persist
 
 public slots:
@@ -62,7 +68,7 @@ protected:
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
-    void replaceData(QByteArray data);
+    void replaceData(ReceivedMessage& message);
     void sendLatestEntityDataToDS();
 
 private:
@@ -79,6 +85,10 @@ private:
 
     QString _persistAsFileType;
     QByteArray _cachedJSONData;
+
+    std::shared_ptr<OctreeEditLog> _editLog;
+    std::chrono::milliseconds _snapshotInterval { DEFAULT_SNAPSHOT_INTERVAL };
+    std::chrono::steady_clock::time_point _lastSnapshot;
 };
 
 #endif // hifi_OctreePersistThread_h
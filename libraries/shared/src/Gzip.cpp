@@ -11,10 +11,19 @@
 
 #include "Gzip.h"
 
+#include <algorithm>
+#include <limits>
+
+#include <QtCore/QIODevice>
+#include <QtCore/QtEndian>
+
 #include <zlib.h>
 
 const int GZIP_WINDOWS_BIT = 31;
 const int GZIP_CHUNK_SIZE = 4096;
+const int GZIP_STREAM_CHUNK_SIZE = 256 * 1024;
+const int GZIP_TRAILER_SIZE = 8;    // CRC32, then the uncompressed size modulo 2^32
+const qint64 MAX_DEFLATE_RATIO = 1032;
 const int DEFAULT_MEM_LEVEL = 8;
 
 bool gunzip(QByteArray source, QByteArray &destination) {
@@ -88,6 +97,74 @@ bool gunzip(QByteArray source, QByteArray &destination) {
     return status == Z_STREAM_END;
 }
 
+bool gunzip(QIODevice& source, QByteArray& destination) {
+    destination.clear();
+
+    int used = 0;
+    if (!source.isSequential() && source.size() - source.pos() > GZIP_TRAILER_SIZE) {
+        qint64 start = source.pos();
+        char uncompressedSize[sizeof(quint32)];
+        if (source.seek(source.size() - sizeof(uncompressedSize)) &&
+            source.read(uncompressedSize, sizeof(uncompressedSize)) == sizeof(uncompressedSize)) {
+            // the trailer only holds the low 32 bits, so don't trust it beyond what a QByteArray can hold anyway,
+            // nor beyond what deflate could have expanded to, which means the trailer is garbage from a truncated file
+            quint32 size = qFromLittleEndian<quint32>(uncompressedSize);
+            if (size < (quint32)std::numeric_limits<int>::max() && size <= (source.size() - start) * MAX_DEFLATE_RATIO) {
+                destination.resize((int)size);
+            }
+        }
+        if (!source.seek(start)) {
+            return false;
+        }
+    }
+
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.avail_in = 0;
+    strm.next_in = Z_NULL;
+
+    int status = inflateInit2(&strm, GZIP_WINDOWS_BIT);
+    if (status != Z_OK) {
+        return false;
+    }
+
+    QByteArray input(GZIP_STREAM_CHUNK_SIZE, Qt::Uninitialized);
+    while (status != Z_STREAM_END) {
+        if (strm.avail_in == 0) {
+            qint64 got = source.read(input.data(), input.size());
+            if (got <= 0) {
+                break;
+            }
+            strm.next_in = (unsigned char*)input.data();
+            strm.avail_in = (uInt)got;
+        }
+
+        // inflate into the destination itself
+        strm.next_out = (unsigned char*)destination.data() + used;
+        strm.avail_out = (uInt)(destination.size() - used);
+        status = inflate(&strm, Z_NO_FLUSH);
+        if (status == Z_NEED_DICT || status == Z_DATA_ERROR || status == Z_MEM_ERROR || status == Z_STREAM_ERROR) {
+            break;
+        }
+        used = destination.size() - (int)strm.avail_out;
+
+        // out of room, because the trailer was missing or wrong
+        if (status == Z_BUF_ERROR && strm.avail_out == 0) {
+            destination.resize(std::max(2 * destination.size(), GZIP_STREAM_CHUNK_SIZE));
+        }
+    }
+
+    inflateEnd(&strm);
+    if (status != Z_STREAM_END) {
+        destination.clear();
+        return false;
+    }
+    destination.resize(used);
+    return true;
+}
+
 bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     destination.clear();
     if (source.length() == 0) {
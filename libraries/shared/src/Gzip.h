@@ -14,6 +14,8 @@
 
 #include <QByteArray>
 
+class QIODevice;
+
 // The compression level must be Z_DEFAULT_COMPRESSION (-1), or between 0 and
 // 9: 1 gives best speed, 9 gives best compression, 0 gives no
 // compression at all (the input data is simply copied a block at a
@@ -24,4 +26,8 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1)
 
 bool gunzip(QByteArray source, QByteArray &destination);
 
+// Inflates straight from the device, without holding the whole compressed source in memory. When the device
+// is a file, the destination is sized up front from the gzip trailer.
+bool gunzip(QIODevice& source, QByteArray& destination);
+
 #endif
@@ -41,6 +41,60 @@ namespace PrioritySortUtil {
         float _priority { 0.0f };
     };
 
+    // The view-dependent terms of a thing's priority: the best weighted angular size and centering among the views
+    // that contain it, and among those that do not. These only change when the thing or the views move,
+    // so callers that sort the same things every frame can cache them and refresh the age term with priorityForAge().
+    struct ViewTerms {
+        float inView { std::numeric_limits<float>::lowest() };
+        float outOfView { std::numeric_limits<float>::lowest() };
+    };
+
+    inline ViewTerms computeViewTerms(const ConicalViewFrustums& views, const glm::vec3& position, float radius,
+                                      float angularWeight, float centerWeight) {
+        ViewTerms terms;
+
+        const float MIN_RADIUS = 0.1f; // WORKAROUND for zero size objects (we still want them to sort by distance)
+        radius = glm::max(radius, MIN_RADIUS);
+
+        for (const auto& view : views) {
+            glm::vec3 offset = position - view.getPosition();
+            float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
+            // Other item's angle from view centre:
+            float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
+            if (cosineAngle > 0.0f) {
+                cosineAngle = std::sqrt(cosineAngle);
+            }
+            float angularSize = radius / distance;
+            float weight = angularWeight * angularSize + centerWeight * cosineAngle;
+
+            // things outside the keyhole are penalized in priorityForAge()
+            if (distance - radius > view.getRadius() && !view.intersects(offset, distance, radius)) {
+                terms.outOfView = std::max(terms.outOfView, weight);
+            } else {
+                terms.inView = std::max(terms.inView, weight);
+            }
+        }
+        return terms;
+    }
+
+    inline float priorityForAge(const ViewTerms& terms, float age, float ageWeight) {
+        // priority = weighted linear combination of multiple values:
+        //   (a) angular size
+        //   (b) proximity to center of view
+        //   (c) time since last update
+        // where the relative "weights" are tuned to scale the contributing values into units of "priority".
+        // The "age" term accumulates at the sum of all weights.
+        float priority = std::numeric_limits<float>::min();
+        if (terms.inView != std::numeric_limits<float>::lowest()) {
+            priority = std::max(priority, terms.inView * (age + 1.0f) + ageWeight * age);
+        }
+        if (terms.outOfView != std::numeric_limits<float>::lowest()) {
+            // decrement priority of things outside keyhole
+            priority = std::max(priority, terms.outOfView * (age + 1.0f) + ageWeight * age + OUT_OF_VIEW_PENALTY);
+        }
+        return priority;
+    }
+
     template <typename T>
     class PriorityQueue {
     public:
@@ -82,45 +136,9 @@ namespace PrioritySortUtil {
     private:
 
         float computePriority(const T& thing) const {
-            float priority = std::numeric_limits<float>::min();
-
-            for (const auto& view : _views) {
-                priority = std::max(priority, computePriority(view, thing));
-            }
-
-            return priority;
-        }
-
-        float computePriority(const ConicalViewFrustum& view, const T& thing) const {
-            // priority = weighted linear combination of multiple values:
-            //   (a) angular size
-            //   (b) proximity to center of view
-            //   (c) time since last update
-            // where the relative "weights" are tuned to scale the contributing values into units of "priority".
-
-            glm::vec3 position = thing.getPosition();
-            glm::vec3 offset = position - view.getPosition();
-            float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
-            const float MIN_RADIUS = 0.1f; // WORKAROUND for zero size objects (we still want them to sort by distance)
-            float radius = glm::max(thing.getRadius(), MIN_RADIUS);
-            // Other item's angle from view centre:
-            float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
-            if (cosineAngle > 0.0f) {
-                cosineAngle = std::sqrt(cosineAngle);
-            }
+            ViewTerms terms = computeViewTerms(_views, thing.getPosition(), thing.getRadius(), _angularWeight, _centerWeight);
             float age = float((_usecCurrentTime - thing.getTimestamp()) / USECS_PER_SECOND);
-
-            // the "age" term accumulates at the sum of all weights
-            float angularSize = radius / distance;
-            float priority = (_angularWeight * angularSize + _centerWeight * cosineAngle) * (age + 1.0f) + _ageWeight * age;
-
-            // decrement priority of things outside keyhole
-            if (distance - radius > view.getRadius()) {
-                if (!view.intersects(offset, distance, radius)) {
-                    priority += OUT_OF_VIEW_PENALTY;
-                }
-            }
-            return priority;
+            return priorityForAge(terms, age, _ageWeight);
         }
 
         ConicalViewFrustums _views;
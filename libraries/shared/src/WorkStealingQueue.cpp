@@ -0,0 +1,101 @@
+//
+//  WorkStealingQueue.cpp
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkStealingQueue.h"
+
+#include <algorithm>
+
+static const size_t CHUNKS_PER_WORKER = 8;
+
+static inline uint64_t packBounds(uint32_t front, uint32_t back) {
+    return ((uint64_t)front << 32) | back;
+}
+
+static inline uint32_t frontOf(uint64_t bounds) {
+    return (uint32_t)(bounds >> 32);
+}
+
+static inline uint32_t backOf(uint64_t bounds) {
+    return (uint32_t)bounds;
+}
+
+void WorkStealingQueue::reset(size_t numItems, int numWorkers, size_t chunkSize) {
+    numWorkers = std::max(numWorkers, 1);
+
+    if (numWorkers > _capacity) {
+        _deques.reset(new Deque[numWorkers]);
+        _capacity = numWorkers;
+    }
+    _numDeques = numWorkers;
+    _numItems = numItems;
+
+    if (chunkSize == 0) {
+        chunkSize = numItems / (numWorkers * CHUNKS_PER_WORKER);
+    }
+    _chunkSize = std::max(chunkSize, (size_t)1);
+
+    // deal contiguous runs of chunks, so that each worker starts on neighbouring items
+    size_t numChunks = (numItems + _chunkSize - 1) / _chunkSize;
+    for (int i = 0; i < numWorkers; ++i) {
+        uint32_t front = (uint32_t)(numChunks * i / numWorkers);
+        uint32_t back = (uint32_t)(numChunks * (i + 1) / numWorkers);
+        _deques[i].bounds.store(packBounds(front, back), std::memory_order_relaxed);
+    }
+
+    // publish the new bounds before the workers are woken
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+bool WorkStealingQueue::pop(int worker, size_t& begin, size_t& end, bool& stolen) {
+    uint32_t chunk = 0;
+
+    stolen = false;
+    bool found = (worker >= 0 && worker < _numDeques) && popFront(_deques[worker], chunk);
+
+    // steal from the other workers, starting with our neighbour
+    for (int i = 1; !found && i <= _numDeques; ++i) {
+        int victim = (std::max(worker, 0) + i) % _numDeques;
+        found = popBack(_deques[victim], chunk);
+        stolen = found;
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    begin = chunk * _chunkSize;
+    end = std::min(begin + _chunkSize, _numItems);
+    return true;
+}
+
+bool WorkStealingQueue::popFront(Deque& deque, uint32_t& chunk) {
+    uint64_t bounds = deque.bounds.load(std::memory_order_acquire);
+    while (frontOf(bounds) < backOf(bounds)) {
+        if (deque.bounds.compare_exchange_weak(bounds, packBounds(frontOf(bounds) + 1, backOf(bounds)),
+                                               std::memory_order_acq_rel, std::memory_order_acquire)) {
+            chunk = frontOf(bounds);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingQueue::popBack(Deque& deque, uint32_t& chunk) {
+    uint64_t bounds = deque.bounds.load(std::memory_order_acquire);
+    while (frontOf(bounds) < backOf(bounds)) {
+        if (deque.bounds.compare_exchange_weak(bounds, packBounds(frontOf(bounds), backOf(bounds) - 1),
+                                               std::memory_order_acq_rel, std::memory_order_acquire)) {
+            chunk = backOf(bounds) - 1;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,55 @@
+//
+//  WorkStealingQueue.h
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_WorkStealingQueue_h
+#define hifi_WorkStealingQueue_h
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+//
+// Hands out the items [0, numItems) to a fixed set of workers in chunks.
+// Each worker starts with a contiguous run of chunks in its own deque and takes from the front of it,
+// then steals from the back of the other workers' deques once its own is empty,
+// so that a few expensive items do not leave one worker running long after the others are done.
+//
+// reset() must not run concurrently with pop(); pop() is lock-free and safe from any number of workers.
+//
+class WorkStealingQueue {
+public:
+    // chunkSize == 0 picks a size that gives every worker several chunks
+    void reset(size_t numItems, int numWorkers, size_t chunkSize = 0);
+
+    // claims the next chunk for worker, returning false once all work has been claimed
+    bool pop(int worker, size_t& begin, size_t& end, bool& stolen);
+
+    size_t getNumItems() const { return _numItems; }
+    size_t getChunkSize() const { return _chunkSize; }
+
+private:
+    // front and back chunk indices of a deque, packed so that both ends move with a single compare-and-swap
+    struct Deque {
+        std::atomic<uint64_t> bounds { 0 };
+        char padding[64 - sizeof(std::atomic<uint64_t>)];   // keep deques on separate cache lines
+    };
+
+    bool popFront(Deque& deque, uint32_t& chunk);
+    bool popBack(Deque& deque, uint32_t& chunk);
+
+    std::unique_ptr<Deque[]> _deques;
+    int _numDeques { 0 };
+    int _capacity { 0 };
+    size_t _numItems { 0 };
+    size_t _chunkSize { 1 };
+};
+
+#endif // hifi_WorkStealingQueue_h
@@ -0,0 +1,236 @@
+//
+//  ChunkedAssetStoreTests.cpp
+//  tests/assignment-client/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ChunkedAssetStoreTests.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include <QTemporaryDir>
+
+#include <AssetChunking.h>
+#include <AssetUtils.h>
+#include <Node.h>
+#include <ReceivedMessage.h>
+
+#include <ChunkedAssetStore.h>
+#include <UploadChunkedAssetTask.h>
+
+QTEST_MAIN(ChunkedAssetStoreTests)
+
+static QByteArray randomData(int size, unsigned int seed) {
+    std::mt19937 generator(seed);
+    QByteArray data(size, Qt::Uninitialized);
+    for (char& byte : data) {
+        byte = (char)(generator() & 0xFF);
+    }
+    return data;
+}
+
+static QString hexHash(const QByteArray& data) {
+    return AssetUtils::hashData(data).toHex();
+}
+
+// an AssetUpload message after its message ID, as AssetClient::uploadChunkedAsset writes it
+static QSharedPointer<ReceivedMessage> createUpload(const QByteArray& data, const AssetUtils::AssetChunks& chunks,
+                                                    const std::vector<bool>& chunksPresent) {
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    auto writePrimitive = [&](const auto& value) {
+        stream.writeRawData(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    writePrimitive((uint64_t)data.size());
+    writePrimitive((uint32_t)chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const auto& chunk = chunks[i];
+        stream.writeRawData(chunk.hash.constData(), chunk.hash.size());
+        writePrimitive((uint32_t)chunk.size);
+        writePrimitive((uint8_t)(chunksPresent[i] ? 0 : 1));
+        if (!chunksPresent[i]) {
+            stream.writeRawData(data.constData() + chunk.offset, (int)chunk.size);
+        }
+    }
+
+    return QSharedPointer<ReceivedMessage>::create(payload, PacketType::AssetUpload, 0, HifiSockAddr());
+}
+
+static AssetUtils::AssetServerError upload(const QTemporaryDir& dir, ChunkedAssetStore& store, const QByteArray& data,
+                                           const AssetUtils::AssetChunks& chunks, const std::vector<bool>& chunksPresent,
+                                           QByteArray& hash) {
+    UploadChunkedAssetTask task(createUpload(data, chunks, chunksPresent), QSharedPointer<Node>(), QDir(dir.path()), store,
+                                std::numeric_limits<uint64_t>::max());
+    return task.storeChunks(hash);
+}
+
+void ChunkedAssetStoreTests::manifestRoundTripTest() {
+    QTemporaryDir dir;
+    ChunkedAssetStore store;
+    store.setFilesDirectory(QDir(dir.path()));
+
+    QByteArray data = randomData(3 * 1024 * 1024, 1);
+    auto chunks = AssetUtils::splitIntoChunks(data);
+    QVERIFY(chunks.size() > 1);
+    for (const auto& chunk : chunks) {
+        QVERIFY(store.writeChunk(chunk.hash, data.mid((int)chunk.offset, (int)chunk.size)));
+    }
+
+    QString hash = hexHash(data);
+    QVERIFY(!store.hasAsset(hash));
+    QVERIFY(store.writeManifest(hash, chunks));
+    QVERIFY(store.hasAsset(hash));
+    QCOMPARE(store.getAssetHashes(), QStringList({ hash }));
+    QCOMPARE(store.getAssetSize(hash), (qint64)data.size());
+
+    AssetUtils::AssetChunks readChunks;
+    QVERIFY(store.readManifest(hash, readChunks));
+    QCOMPARE(readChunks.size(), chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        QCOMPARE(readChunks[i].hash, chunks[i].hash);
+        QCOMPARE(readChunks[i].offset, chunks[i].offset);
+        QCOMPARE(readChunks[i].size, chunks[i].size);
+    }
+
+    QByteArray readData;
+    QVERIFY(store.readAsset(hash, readData));
+    QCOMPARE(readData, data);
+
+    QString filePath = dir.filePath("reassembled");
+    QVERIFY(store.writeAssetToFile(hash, filePath));
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), data);
+
+    // a file that isn't a manifest isn't mistaken for one
+    QString otherHash = hexHash("other");
+    QFile notManifest(QDir(dir.path()).filePath("manifests/" + otherHash));
+    QVERIFY(notManifest.open(QIODevice::WriteOnly));
+    notManifest.write("not a manifest");
+    notManifest.close();
+    QVERIFY(!store.readManifest(otherHash, readChunks));
+    QCOMPARE(store.getAssetSize(otherHash), (qint64)-1);
+}
+
+void ChunkedAssetStoreTests::uploadTest() {
+    QTemporaryDir dir;
+    ChunkedAssetStore store;
+    store.setFilesDirectory(QDir(dir.path()));
+
+    QByteArray data = randomData(3 * 1024 * 1024, 2);
+    auto chunks = AssetUtils::splitIntoChunks(data);
+
+    QByteArray hash;
+    QCOMPARE(upload(dir, store, data, chunks, std::vector<bool>(chunks.size(), false), hash),
+             AssetUtils::AssetServerError::NoError);
+    QCOMPARE(hash, AssetUtils::hashData(data));
+
+    QByteArray readData;
+    QVERIFY(store.readAsset(hash.toHex(), readData));
+    QCOMPARE(readData, data);
+    QCOMPARE(store.getBytesSent(), (quint64)data.size());
+
+    // the same asset again, without sending any of its chunks
+    QVERIFY(store.removeAsset(hash.toHex()));
+    QCOMPARE(upload(dir, store, data, chunks, std::vector<bool>(chunks.size(), true), hash),
+             AssetUtils::AssetServerError::NoError);
+    QCOMPARE(hash, AssetUtils::hashData(data));
+    QVERIFY(store.readAsset(hash.toHex(), readData));
+    QCOMPARE(readData, data);
+    QCOMPARE(store.getNumUploads(), (quint64)2);
+    QCOMPARE(store.getBytesDeduplicated(), (quint64)data.size());
+}
+
+void ChunkedAssetStoreTests::hashMismatchTest() {
+    QTemporaryDir dir;
+    ChunkedAssetStore store;
+    store.setFilesDirectory(QDir(dir.path()));
+
+    QByteArray data = randomData(3 * 1024 * 1024, 3);
+    auto chunks = AssetUtils::splitIntoChunks(data);
+    QByteArray corrupted = data;
+    corrupted[(int)chunks.back().offset] = (char)~corrupted.at((int)chunks.back().offset);
+
+    QByteArray hash;
+    QCOMPARE(upload(dir, store, corrupted, chunks, std::vector<bool>(chunks.size(), false), hash),
+             AssetUtils::AssetServerError::FileOperationFailed);
+    QVERIFY(!store.hasAsset(hexHash(data)));
+    QVERIFY(!store.hasAsset(hexHash(corrupted)));
+    QVERIFY(!store.hasChunk(chunks.back().hash));
+}
+
+void ChunkedAssetStoreTests::chunksMissingTest() {
+    QTemporaryDir dir;
+    ChunkedAssetStore store;
+    store.setFilesDirectory(QDir(dir.path()));
+
+    QByteArray data = randomData(3 * 1024 * 1024, 4);
+    auto chunks = AssetUtils::splitIntoChunks(data);
+
+    // the client was told the first chunk is stored, but it has since been collected
+    std::vector<bool> chunksPresent(chunks.size(), false);
+    chunksPresent[0] = true;
+
+    QByteArray hash;
+    QCOMPARE(upload(dir, store, data, chunks, chunksPresent, hash), AssetUtils::AssetServerError::ChunksMissing);
+    QVERIFY(!store.hasAsset(hexHash(data)));
+
+    // retrying with every chunk succeeds
+    QCOMPARE(upload(dir, store, data, chunks, std::vector<bool>(chunks.size(), false), hash),
+             AssetUtils::AssetServerError::NoError);
+    QVERIFY(store.hasAsset(hexHash(data)));
+}
+
+void ChunkedAssetStoreTests::collectionTest() {
+    QTemporaryDir dir;
+    ChunkedAssetStore store;
+    store.setFilesDirectory(QDir(dir.path()));
+
+    // two assets that share their first half
+    QByteArray shared = randomData(2 * 1024 * 1024, 5);
+    QByteArray first = shared + randomData(2 * 1024 * 1024, 6);
+    QByteArray second = shared + randomData(2 * 1024 * 1024, 7);
+    auto firstChunks = AssetUtils::splitIntoChunks(first);
+    auto secondChunks = AssetUtils::splitIntoChunks(second);
+
+    QByteArray hash;
+    QCOMPARE(upload(dir, store, first, firstChunks, std::vector<bool>(firstChunks.size(), false), hash),
+             AssetUtils::AssetServerError::NoError);
+    std::vector<bool> secondPresent;
+    for (const auto& chunk : secondChunks) {
+        secondPresent.push_back(store.hasChunk(chunk.hash));
+    }
+    QCOMPARE(upload(dir, store, second, secondChunks, secondPresent, hash), AssetUtils::AssetServerError::NoError);
+    QVERIFY(store.getBytesDeduplicated() > 0);
+
+    QCOMPARE(store.removeUnreferencedChunks(), 0);
+
+    QVERIFY(store.removeAsset(hexHash(first)));
+    QThreadPool pool;
+    store.collectUnreferencedChunks(pool);
+    store.collectUnreferencedChunks(pool);
+    pool.waitForDone();
+
+    for (const auto& chunk : firstChunks) {
+        bool isShared = std::any_of(secondChunks.begin(), secondChunks.end(), [&](const AssetUtils::AssetChunk& other) {
+            return other.hash == chunk.hash;
+        });
+        QCOMPARE(store.hasChunk(chunk.hash), isShared);
+    }
+
+    QByteArray readData;
+    QVERIFY(store.readAsset(hexHash(second), readData));
+    QCOMPARE(readData, second);
+
+    QVERIFY(store.removeAsset(hexHash(second)));
+    QCOMPARE(store.removeUnreferencedChunks(), (int)secondChunks.size());
+    QVERIFY(QDir(dir.filePath("chunks")).entryList(QDir::Files).isEmpty());
+}
@@ -0,0 +1,36 @@
+//
+//  ChunkedAssetStoreTests.h
+//  tests/assignment-client/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ChunkedAssetStoreTests_h
+#define hifi_ChunkedAssetStoreTests_h
+
+#include <QtTest/QtTest>
+
+class ChunkedAssetStoreTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a manifest is read back as written, and the asset reassembled from its chunks
+    void manifestRoundTripTest();
+
+    // Test an upload carrying every chunk, then one of the same asset that only refers to them
+    void uploadTest();
+
+    // Test that an upload whose chunk doesn't match its hash is rejected without a manifest
+    void hashMismatchTest();
+
+    // Test that an upload referring to a chunk that isn't stored asks for it to be sent
+    void chunksMissingTest();
+
+    // Test that only chunks no manifest refers to are collected
+    void collectionTest();
+};
+
+#endif // hifi_ChunkedAssetStoreTests_h
@@ -0,0 +1,133 @@
+//
+//  AudioHRTFTests.cpp
+//  tests/audio/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioHRTFTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "AudioHRTF.h"
+
+QTEST_MAIN(AudioHRTFTests)
+
+// the vectorized kernels may use FMA, so compare against the scalar reference with a tolerance
+static const float TOLERANCE = 1e-6f;
+
+static void fillInput(int16_t* input, int numSamples) {
+    uint32_t seed = 12345;
+    for (int i = 0; i < numSamples; i++) {
+        seed = seed * 1664525 + 1013904223;     // LCG
+        input[i] = (int16_t)(seed >> 16);
+    }
+    input[0] = INT16_MIN;   // exercise sign extension at the extremes
+    input[1] = INT16_MAX;
+}
+
+static void fillOutput(float* output, int numSamples) {
+    for (int i = 0; i < numSamples; i++) {
+        output[i] = (i % 7) * 0.01f - 0.03f;    // accumulation must preserve existing content
+    }
+}
+
+void AudioHRTFTests::mixMonoTest() {
+    int16_t input[HRTF_BLOCK];
+    float output[2 * HRTF_BLOCK];
+    float expected[2 * HRTF_BLOCK];
+    fillInput(input, HRTF_BLOCK);
+    fillOutput(output, 2 * HRTF_BLOCK);
+    fillOutput(expected, 2 * HRTF_BLOCK);
+
+    AudioHRTF hrtf;
+    const float gain = 0.7f;
+
+    // the first block after reset uses a constant gain
+    hrtf.mixMono(input, output, gain, HRTF_BLOCK);
+
+    float scale = gain * hrtf.getGainAdjustment() * (1/32768.0f);
+    for (int i = 0; i < HRTF_BLOCK; i++) {
+        expected[2*i+0] += (float)input[i] * scale;
+        expected[2*i+1] += (float)input[i] * scale;
+    }
+
+    for (int i = 0; i < 2 * HRTF_BLOCK; i++) {
+        QVERIFY2(std::fabs(output[i] - expected[i]) <= TOLERANCE, qPrintable(QString("sample %1").arg(i)));
+    }
+}
+
+void AudioHRTFTests::mixStereoTest() {
+    int16_t input[2 * HRTF_BLOCK];
+    float output[2 * HRTF_BLOCK];
+    float expected[2 * HRTF_BLOCK];
+    fillInput(input, 2 * HRTF_BLOCK);
+    fillOutput(output, 2 * HRTF_BLOCK);
+    fillOutput(expected, 2 * HRTF_BLOCK);
+
+    AudioHRTF hrtf;
+    const float gain = 0.3f;
+
+    hrtf.mixStereo(input, output, gain, HRTF_BLOCK);
+
+    float scale = gain * hrtf.getGainAdjustment() * (1/32768.0f);
+    for (int i = 0; i < 2 * HRTF_BLOCK; i++) {
+        expected[i] += (float)input[i] * scale;
+    }
+
+    for (int i = 0; i < 2 * HRTF_BLOCK; i++) {
+        QVERIFY2(std::fabs(output[i] - expected[i]) <= TOLERANCE, qPrintable(QString("sample %1").arg(i)));
+    }
+}
+
+void AudioHRTFTests::gainCrossfadeTest() {
+    int16_t mono[HRTF_BLOCK];
+    int16_t stereo[2 * HRTF_BLOCK];
+    fillInput(mono, HRTF_BLOCK);
+    for (int i = 0; i < HRTF_BLOCK; i++) {
+        stereo[2*i+0] = mono[i];
+        stereo[2*i+1] = mono[i];
+    }
+
+    float monoOutput[2 * HRTF_BLOCK] = {};
+    float stereoOutput[2 * HRTF_BLOCK] = {};
+
+    AudioHRTF monoHRTF;
+    AudioHRTF stereoHRTF;
+    const float gain0 = 1.0f;
+    const float gain1 = 0.25f;
+
+    // settle the old gain, then crossfade to the new gain
+    monoHRTF.mixMono(mono, monoOutput, gain0, HRTF_BLOCK);
+    stereoHRTF.mixStereo(stereo, stereoOutput, gain0, HRTF_BLOCK);
+    memset(monoOutput, 0, sizeof(monoOutput));
+    memset(stereoOutput, 0, sizeof(stereoOutput));
+    monoHRTF.mixMono(mono, monoOutput, gain1, HRTF_BLOCK);
+    stereoHRTF.mixStereo(stereo, stereoOutput, gain1, HRTF_BLOCK);
+
+    float scale0 = gain0 * monoHRTF.getGainAdjustment() * (1/32768.0f);
+    float scale1 = gain1 * monoHRTF.getGainAdjustment() * (1/32768.0f);
+
+    for (int i = 0; i < HRTF_BLOCK; i++) {
+        float x = (float)mono[i];
+        float lo = std::min(x * scale0, x * scale1) - TOLERANCE;
+        float hi = std::max(x * scale0, x * scale1) + TOLERANCE;
+
+        // every sample lies between the old and new gain
+        QVERIFY(monoOutput[2*i+0] >= lo && monoOutput[2*i+0] <= hi);
+        QVERIFY(monoOutput[2*i+0] == monoOutput[2*i+1]);
+
+        // the mono and stereo kernels apply the same gain ramp
+        QVERIFY(std::fabs(stereoOutput[2*i+0] - monoOutput[2*i+0]) <= TOLERANCE);
+        QVERIFY(std::fabs(stereoOutput[2*i+1] - monoOutput[2*i+1]) <= TOLERANCE);
+    }
+
+    // the crossfade starts at the old gain
+    QVERIFY(std::fabs(monoOutput[0] - (float)mono[0] * scale0) <= TOLERANCE);
+}
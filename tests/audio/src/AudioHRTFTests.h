@@ -0,0 +1,25 @@
+//
+//  AudioHRTFTests.h
+//  tests/audio/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioHRTFTests_h
+#define hifi_AudioHRTFTests_h
+
+#include <QtTest/QtTest>
+
+class AudioHRTFTests : public QObject {
+    Q_OBJECT
+private slots:
+    void mixMonoTest();
+    void mixStereoTest();
+    void gainCrossfadeTest();
+};
+
+#endif // hifi_AudioHRTFTests_h
@@ -0,0 +1,187 @@
+//
+//  AudioSpatialGridTests.cpp
+//  tests/audio/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSpatialGridTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <AudioSpatialGrid.h>
+
+QTEST_MAIN(AudioSpatialGridTests)
+
+using Grid = AudioSpatialGrid<int>;
+
+void AudioSpatialGridTests::queryTest() {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> coordinate(-200.0f, 200.0f);
+
+    const int NUM_POINTS = 2000;
+    std::vector<glm::vec3> points;
+    Grid grid;
+    grid.setCellSize(15.0f);
+    for (int i = 0; i < NUM_POINTS; i++) {
+        points.emplace_back(coordinate(generator), coordinate(generator) * 0.1f, coordinate(generator));
+        grid.insert(points.back(), i);
+    }
+    QCOMPARE(grid.size(), (size_t)NUM_POINTS);
+
+    // radii smaller than, equal to and larger than the cell size
+    for (float radius : { 5.0f, 15.0f, 40.0f }) {
+        for (int q = 0; q < 50; q++) {
+            glm::vec3 center(coordinate(generator), 0.0f, coordinate(generator));
+
+            std::set<int> expected;
+            for (int i = 0; i < NUM_POINTS; i++) {
+                glm::vec3 delta = points[i] - center;
+                if (glm::dot(delta, delta) <= radius * radius) {
+                    expected.insert(i);
+                }
+            }
+
+            std::set<int> found;
+            grid.query(center, radius, [&](const Grid::Entry& entry) {
+                QVERIFY(found.insert(entry.value).second);
+            });
+
+            QCOMPARE(found, expected);
+        }
+    }
+}
+
+void AudioSpatialGridTests::reuseTest() {
+    Grid grid;
+    grid.setCellSize(10.0f);
+    grid.insert(glm::vec3(0.0f), 1);
+    grid.insert(glm::vec3(-5.0f, 0.0f, 5.0f), 2);
+
+    grid.clear();
+    QCOMPARE(grid.size(), (size_t)0);
+
+    int count = 0;
+    grid.query(glm::vec3(0.0f), 100.0f, [&](const Grid::Entry&) { ++count; });
+    QCOMPARE(count, 0);
+
+    grid.insert(glm::vec3(1.0f), 3);
+    grid.query(glm::vec3(0.0f), 100.0f, [&](const Grid::Entry& entry) {
+        QCOMPARE(entry.value, 3);
+        ++count;
+    });
+    QCOMPARE(count, 1);
+}
+
+void AudioSpatialGridTests::movingTest() {
+    // a source walking across a large domain only holds onto the cells it was in over the last couple of frames
+    Grid grid;
+    grid.setCellSize(10.0f);
+    for (int frame = 0; frame < 1000; frame++) {
+        grid.clear();
+        grid.insert(glm::vec3(frame * 10.0f, 0.0f, 0.0f), 1);
+        grid.insert(glm::vec3(0.0f), 2);
+        QVERIFY(grid.getNumCells() <= 3);
+    }
+
+    int count = 0;
+    grid.query(glm::vec3(9990.0f, 0.0f, 0.0f), 1.0f, [&](const Grid::Entry& entry) {
+        QCOMPARE(entry.value, 1);
+        ++count;
+    });
+    QCOMPARE(count, 1);
+
+    grid.clear();
+    grid.clear();
+    QCOMPARE(grid.getNumCells(), (size_t)0);
+}
+
+void AudioSpatialGridTests::mixBenchmark_data() {
+    QTest::addColumn<int>("numAgents");
+    QTest::addColumn<bool>("useGrid");
+
+    QTest::newRow("256 agents, all pairs") << 256 << false;
+    QTest::newRow("256 agents, grid") << 256 << true;
+    QTest::newRow("1024 agents, all pairs") << 1024 << false;
+    QTest::newRow("1024 agents, grid") << 1024 << true;
+}
+
+void AudioSpatialGridTests::mixBenchmark() {
+    QFETCH(int, numAgents);
+    QFETCH(bool, useGrid);
+
+    const float AGENT_SPACING = 4.0f;   // meters
+    const float AUDIBILITY_RADIUS = 10.0f;
+    const int HRTF_DATASET_INDEX = 1;
+
+    // agents stand on a square grid
+    int side = (int)std::ceil(std::sqrt((float)numAgents));
+    std::vector<glm::vec3> positions;
+    for (int i = 0; i < numAgents; i++) {
+        positions.emplace_back((i % side) * AGENT_SPACING, 0.0f, (i / side) * AGENT_SPACING);
+    }
+
+    int16_t input[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+        input[i] = (int16_t)(8192.0f * std::sin(i * 0.1f));
+    }
+    float output[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    std::unique_ptr<AudioHRTF> hrtf(new AudioHRTF);
+
+    Grid grid;
+    grid.setCellSize(AUDIBILITY_RADIUS);
+    int mixes = 0;
+
+    auto mix = [&](int listener, int source) {
+        glm::vec3 relativePosition = positions[source] - positions[listener];
+        float distance = std::max(std::sqrt(glm::dot(relativePosition, relativePosition)), 0.1f);
+        float azimuth = std::atan2(relativePosition.x, -relativePosition.z);
+        hrtf->render(input, output, HRTF_DATASET_INDEX, azimuth, distance, 1.0f / distance,
+                     AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        ++mixes;
+    };
+
+    // one iteration is one mix frame for every listener
+    QBENCHMARK {
+        mixes = 0;
+        if (useGrid) {
+            grid.clear();
+            for (int i = 0; i < numAgents; i++) {
+                grid.insert(positions[i], i);
+            }
+        }
+
+        for (int listener = 0; listener < numAgents; listener++) {
+            memset(output, 0, sizeof(output));
+
+            if (useGrid) {
+                grid.query(positions[listener], AUDIBILITY_RADIUS, [&](const Grid::Entry& entry) {
+                    if (entry.value != listener) {
+                        mix(listener, entry.value);
+                    }
+                });
+            } else {
+                for (int source = 0; source < numAgents; source++) {
+                    glm::vec3 delta = positions[source] - positions[listener];
+                    if (source != listener && glm::dot(delta, delta) <= AUDIBILITY_RADIUS * AUDIBILITY_RADIUS) {
+                        mix(listener, source);
+                    }
+                }
+            }
+        }
+    }
+
+    qDebug() << numAgents << "agents," << mixes << "mixes per frame";
+}
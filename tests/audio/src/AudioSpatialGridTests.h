@@ -0,0 +1,29 @@
+//
+//  AudioSpatialGridTests.h
+//  tests/audio/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSpatialGridTests_h
+#define hifi_AudioSpatialGridTests_h
+
+#include <QtTest/QtTest>
+
+class AudioSpatialGridTests : public QObject {
+    Q_OBJECT
+private slots:
+    void queryTest();
+    void reuseTest();
+    void movingTest();
+
+    // simulates a crowd of agents standing on a grid, each listening to the others
+    void mixBenchmark_data();
+    void mixBenchmark();
+};
+
+#endif // hifi_AudioSpatialGridTests_h
@@ -0,0 +1,99 @@
+//
+//  AssetChunkingTests.cpp
+//  tests/networking/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkingTests.h"
+
+#include <random>
+#include <set>
+
+#include <AssetChunking.h>
+#include <AssetUtils.h>
+
+QTEST_MAIN(AssetChunkingTests)
+
+static QByteArray randomData(int size, unsigned int seed) {
+    std::mt19937 generator(seed);
+    QByteArray data(size, Qt::Uninitialized);
+    for (char& byte : data) {
+        byte = (char)(generator() & 0xFF);
+    }
+    return data;
+}
+
+void AssetChunkingTests::smallDataTest() {
+    QVERIFY(AssetUtils::splitIntoChunks(QByteArray()).empty());
+
+    QByteArray data = randomData(AssetUtils::MIN_CHUNK_SIZE, 1);
+    auto chunks = AssetUtils::splitIntoChunks(data);
+    QCOMPARE((int)chunks.size(), 1);
+    QCOMPARE(chunks[0].offset, (qint64)0);
+    QCOMPARE(chunks[0].size, (qint64)data.size());
+    QCOMPARE(chunks[0].hash, AssetUtils::hashData(data));
+}
+
+void AssetChunkingTests::chunksCoverDataTest() {
+    QByteArray data = randomData(4 * 1024 * 1024, 2);
+    auto chunks = AssetUtils::splitIntoChunks(data);
+
+    qint64 offset = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const auto& chunk = chunks[i];
+        QCOMPARE(chunk.offset, offset);
+        QVERIFY(chunk.size <= AssetUtils::MAX_CHUNK_SIZE);
+        if (i + 1 < chunks.size()) {
+            QVERIFY(chunk.size > AssetUtils::MIN_CHUNK_SIZE);
+        }
+        QCOMPARE(chunk.hash, AssetUtils::hashData(data.mid((int)chunk.offset, (int)chunk.size)));
+        offset += chunk.size;
+    }
+    QCOMPARE(offset, (qint64)data.size());
+
+    // the sizes are spread around the average rather than pinned to the limits
+    qint64 averageSize = data.size() / (qint64)chunks.size();
+    QVERIFY(averageSize > AssetUtils::AVERAGE_CHUNK_SIZE / 2);
+    QVERIFY(averageSize < AssetUtils::AVERAGE_CHUNK_SIZE * 2);
+}
+
+void AssetChunkingTests::deterministicTest() {
+    QByteArray data = randomData(1024 * 1024, 3);
+    auto first = AssetUtils::splitIntoChunks(data);
+    auto second = AssetUtils::splitIntoChunks(QByteArray(data.constData(), data.size()));
+
+    QCOMPARE(first.size(), second.size());
+    for (size_t i = 0; i < first.size(); ++i) {
+        QCOMPARE(first[i].offset, second[i].offset);
+        QCOMPARE(first[i].hash, second[i].hash);
+    }
+}
+
+void AssetChunkingTests::insertionTest() {
+    QByteArray original = randomData(4 * 1024 * 1024, 4);
+    QByteArray edited = original;
+    edited.insert(original.size() / 2, randomData(100, 5));
+
+    auto originalChunks = AssetUtils::splitIntoChunks(original);
+    auto editedChunks = AssetUtils::splitIntoChunks(edited);
+
+    std::set<QByteArray> originalHashes;
+    for (const auto& chunk : originalChunks) {
+        originalHashes.insert(chunk.hash);
+    }
+
+    // only the chunks around the insertion change
+    int numChanged = 0;
+    for (const auto& chunk : editedChunks) {
+        if (originalHashes.find(chunk.hash) == originalHashes.end()) {
+            ++numChanged;
+        }
+    }
+    QVERIFY(numChanged >= 1);
+    QVERIFY(numChanged <= 3);
+}
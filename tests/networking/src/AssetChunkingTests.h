@@ -0,0 +1,26 @@
+//
+//  AssetChunkingTests.h
+//  tests/networking/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunkingTests_h
+#define hifi_AssetChunkingTests_h
+
+#include <QtTest/QtTest>
+
+class AssetChunkingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void smallDataTest();
+    void chunksCoverDataTest();
+    void deterministicTest();
+    void insertionTest();
+};
+
+#endif // hifi_AssetChunkingTests_h
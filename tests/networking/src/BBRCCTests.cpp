@@ -0,0 +1,161 @@
+//
+//  BBRCCTests.cpp
+//  tests/networking/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCCTests.h"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include <NumericalConstants.h>
+#include <udt/BBRCC.h>
+
+QTEST_MAIN(BBRCCTests)
+
+using namespace udt;
+using namespace std::chrono;
+
+static const int64_t BOTTLENECK_SERVICE_USECS = 1000; // 1000 packets per second
+static const int64_t ONE_WAY_DELAY_USECS = 25 * 1000;
+
+// BBRCC as a Connection drives it, with its controls exposed
+class TestBBRCC : public BBRCC {
+public:
+    TestBBRCC() { setInitialSendSequenceNumber(SequenceNumber(0)); }
+
+    void sent(SequenceNumber seq, p_high_resolution_clock::time_point time) {
+        onPacketSent(MAX_PACKET_SIZE, seq, time);
+        setSendCurrentSequenceNumber(seq);
+    }
+
+    int getWindowSize() const { return _congestionWindowSize; }
+    double getPacketSendPeriod() const { return _packetSendPeriod; }
+};
+
+// a sender paced and windowed by the congestion control, over a path with a single bottleneck queue
+// and no loss, whose receiver ACKs every packet
+class PathSimulation {
+public:
+    PathSimulation(TestBBRCC& cc) : _cc(cc), _start(p_high_resolution_clock::now()) {}
+
+    // runs until the given time, in microseconds since the start
+    void runUntil(int64_t endUsecs) {
+        while (true) {
+            int inFlight = (int)_acks.size();
+            bool canSend = inFlight < _cc.getWindowSize();
+            int64_t nextACK = _acks.empty() ? endUsecs : _acks.front().first;
+            int64_t next = canSend ? std::min(_nextSendUsecs, nextACK) : nextACK;
+            if (next >= endUsecs) {
+                _nowUsecs = endUsecs;
+                return;
+            }
+            _nowUsecs = std::max(_nowUsecs, next);
+
+            if (!_acks.empty() && _acks.front().first <= _nowUsecs) {
+                SequenceNumber seq = _acks.front().second;
+                _acks.pop_front();
+                _cc.onACK(seq, timeAt(_nowUsecs));
+                recordMode();
+            } else {
+                ++_seq;
+                _cc.sent(_seq, timeAt(_nowUsecs));
+
+                // queue at the bottleneck, then cross the rest of the path and back
+                _bottleneckFreeUsecs = std::max(_bottleneckFreeUsecs, _nowUsecs + oneWayDelayUsecs) + BOTTLENECK_SERVICE_USECS;
+                _acks.push_back({ _bottleneckFreeUsecs + oneWayDelayUsecs, _seq });
+                _nextSendUsecs = _nowUsecs + (int64_t)_cc.getPacketSendPeriod();
+            }
+        }
+    }
+
+    std::vector<BBRCC::Mode> modes;
+    int64_t oneWayDelayUsecs { ONE_WAY_DELAY_USECS };
+
+private:
+    p_high_resolution_clock::time_point timeAt(int64_t usecs) const { return _start + microseconds(usecs); }
+
+    void recordMode() {
+        if (modes.empty() || modes.back() != _cc.getMode()) {
+            modes.push_back(_cc.getMode());
+        }
+    }
+
+    TestBBRCC& _cc;
+    p_high_resolution_clock::time_point _start;
+    int64_t _nowUsecs { 0 };
+    int64_t _nextSendUsecs { 0 };
+    int64_t _bottleneckFreeUsecs { 0 };
+    SequenceNumber _seq { 0 };
+    std::deque<std::pair<int64_t, SequenceNumber>> _acks;
+};
+
+void BBRCCTests::startupTest() {
+    TestBBRCC cc;
+    PathSimulation path(cc);
+    QCOMPARE(cc.getMode(), BBRCC::Mode::Startup);
+
+    path.runUntil(3 * 1000 * 1000);
+
+    QVERIFY(path.modes.size() >= 3);
+    QCOMPARE(path.modes[0], BBRCC::Mode::Startup);
+    QCOMPARE(path.modes[1], BBRCC::Mode::Drain);
+    QCOMPARE(path.modes[2], BBRCC::Mode::ProbeBandwidth);
+    QCOMPARE(cc.getMode(), BBRCC::Mode::ProbeBandwidth);
+
+    double bandwidth = (double)USECS_PER_SECOND / BOTTLENECK_SERVICE_USECS;
+    QVERIFY(cc.getBottleneckBandwidth() > 0.9 * bandwidth);
+    QVERIFY(cc.getBottleneckBandwidth() < 1.1 * bandwidth);
+
+    int pathRTT = (int)(2 * ONE_WAY_DELAY_USECS + BOTTLENECK_SERVICE_USECS);
+    QVERIFY(cc.getMinRTT() >= pathRTT);
+    QVERIFY(cc.getMinRTT() < pathRTT + 2 * BOTTLENECK_SERVICE_USECS);
+
+    // the window is the probing gain's worth of the bandwidth-delay product, plus about a packet for each ACK interval
+    int bandwidthDelayProduct = (int)(bandwidth * pathRTT / USECS_PER_SECOND);
+    QVERIFY(cc.getWindowSize() >= 2 * bandwidthDelayProduct);
+    QVERIFY(cc.getWindowSize() <= 2 * bandwidthDelayProduct + 4);
+}
+
+void BBRCCTests::probeRTTTest() {
+    TestBBRCC cc;
+    PathSimulation path(cc);
+    path.runUntil(3 * 1000 * 1000);
+    QCOMPARE(cc.getMode(), BBRCC::Mode::ProbeBandwidth);
+    int shortRTT = cc.getMinRTT();
+
+    // a route change doubles the delay, which no sample can show until the min RTT expires
+    path.oneWayDelayUsecs = 2 * ONE_WAY_DELAY_USECS;
+    path.modes.clear();
+    path.runUntil(8 * 1000 * 1000);
+    QCOMPARE(cc.getMinRTT(), shortRTT);
+    QCOMPARE(cc.getMode(), BBRCC::Mode::ProbeBandwidth);
+
+    path.runUntil(16 * 1000 * 1000);
+    QVERIFY(std::find(path.modes.begin(), path.modes.end(), BBRCC::Mode::ProbeRTT) != path.modes.end());
+    QCOMPARE(cc.getMode(), BBRCC::Mode::ProbeBandwidth);
+    QVERIFY(cc.getMinRTT() >= 2 * shortRTT - 2 * BOTTLENECK_SERVICE_USECS);
+}
+
+void BBRCCTests::timeoutTest() {
+    TestBBRCC cc;
+    PathSimulation path(cc);
+    path.runUntil(3 * 1000 * 1000);
+    int windowSize = cc.getWindowSize();
+    QVERIFY(windowSize > 4);
+
+    cc.onTimeout();
+    QCOMPARE(cc.getWindowSize(), 4);
+
+    // the model survives the timeout, so the window comes back with the first ACK
+    path.runUntil(3 * 1000 * 1000 + 100 * 1000);
+    QVERIFY(cc.getWindowSize() >= windowSize / 2);
+    QCOMPARE(cc.getMode(), BBRCC::Mode::ProbeBandwidth);
+}
@@ -0,0 +1,32 @@
+//
+//  BBRCCTests.h
+//  tests/networking/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BBRCCTests_h
+#define hifi_BBRCCTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class BBRCCTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that startup finds the bottleneck, drains its queue and settles into probing for bandwidth
+    void startupTest();
+
+    // Test that a longer path is noticed through ProbeRTT once the min RTT expires
+    void probeRTTTest();
+
+    // Test that a timeout holds the window down until an ACK makes progress
+    void timeoutTest();
+};
+
+#endif // hifi_BBRCCTests_h
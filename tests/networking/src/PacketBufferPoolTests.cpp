@@ -0,0 +1,91 @@
+//
+//  PacketBufferPoolTests.cpp
+//  tests/networking/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPoolTests.h"
+
+#include <thread>
+
+#include <NLPacket.h>
+#include <udt/PacketBufferPool.h>
+
+QTEST_MAIN(PacketBufferPoolTests)
+
+using udt::PacketBufferPool;
+
+void PacketBufferPoolTests::initTestCase() {
+    // start every test from zeroed counters
+    PacketBufferPool::sampleStats();
+}
+
+void PacketBufferPoolTests::recycleTest() {
+    auto buffer = PacketBufferPool::acquire();
+    auto address = buffer.get();
+    PacketBufferPool::release(std::move(buffer));
+
+    auto recycled = PacketBufferPool::acquire();
+    QCOMPARE(recycled.get(), address);
+    PacketBufferPool::release(std::move(recycled));
+
+    auto stats = PacketBufferPool::sampleStats();
+    QVERIFY(stats.hits >= 1);
+    QCOMPARE(stats.outstanding, (uint64_t)0);
+}
+
+void PacketBufferPoolTests::packetRecycleTest() {
+    const char* address = nullptr;
+    {
+        auto packet = NLPacket::create(PacketType::Unknown);
+        QVERIFY(packet->isBufferPooled());
+        QCOMPARE(PacketBufferPool::sampleStats().outstanding, (uint64_t)1);
+        address = packet->getData();
+    }
+    QCOMPARE(PacketBufferPool::sampleStats().outstanding, (uint64_t)0);
+
+    // a freshly created packet is zeroed even though its buffer is recycled
+    auto packet = NLPacket::create(PacketType::Unknown);
+    QCOMPARE(packet->getData(), address);
+    QCOMPARE(packet->getPayload()[0], (char)0);
+
+    // a packet larger than the pool buffers falls back to its own allocation
+    auto bigPacket = udt::Packet::create(2 * PacketBufferPool::BUFFER_SIZE);
+    QVERIFY(!bigPacket->isBufferPooled());
+}
+
+void PacketBufferPoolTests::crossThreadTest() {
+    const int NUM_BUFFERS = 256;
+
+    std::vector<std::unique_ptr<char[]>> buffers;
+    for (int i = 0; i < NUM_BUFFERS; ++i) {
+        buffers.push_back(PacketBufferPool::acquire());
+    }
+
+    // release everything on another thread, which overflows its cache into the shared queue
+    std::thread releaser([&] {
+        for (auto& buffer : buffers) {
+            PacketBufferPool::release(std::move(buffer));
+        }
+    });
+    releaser.join();
+
+    PacketBufferPool::sampleStats();
+
+    for (int i = 0; i < NUM_BUFFERS; ++i) {
+        buffers[i] = PacketBufferPool::acquire();
+    }
+
+    auto stats = PacketBufferPool::sampleStats();
+    QCOMPARE(stats.hits + stats.misses, (uint64_t)NUM_BUFFERS);
+    QCOMPARE(stats.hits, (uint64_t)NUM_BUFFERS);
+
+    for (auto& buffer : buffers) {
+        PacketBufferPool::release(std::move(buffer));
+    }
+}
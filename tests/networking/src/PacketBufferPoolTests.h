@@ -0,0 +1,34 @@
+//
+//  PacketBufferPoolTests.h
+//  tests/networking/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketBufferPoolTests_h
+#define hifi_PacketBufferPoolTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketBufferPoolTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that a released buffer is handed back out
+    void recycleTest();
+
+    // Test that packets return their buffer on destruction
+    void packetRecycleTest();
+
+    // Test that buffers released on another thread are picked up again
+    void crossThreadTest();
+};
+
+#endif // hifi_PacketBufferPoolTests_h
@@ -0,0 +1,142 @@
+//
+//  ReceivedMessageTests.cpp
+//  tests/networking/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReceivedMessageTests.h"
+
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(ReceivedMessageTests)
+
+static const int PAYLOAD_SIZE = 7;
+
+// a payload of PAYLOAD_SIZE bytes counting up from first
+static QByteArray makePayload(int first) {
+    QByteArray payload;
+    for (int i = 0; i < PAYLOAD_SIZE; ++i) {
+        payload.append((char)(first + i));
+    }
+    return payload;
+}
+
+static std::unique_ptr<NLPacket> makePart(NLPacket::PacketPosition position, int partNumber) {
+    auto packet = NLPacket::create(PacketType::BulkAvatarTraits, -1, true, true);
+    packet->writeMessageNumber(1, position, partNumber);
+    packet->write(makePayload(partNumber * PAYLOAD_SIZE));
+    return packet;
+}
+
+// a message chained from numParts packets, whose bytes count up from zero
+static std::unique_ptr<ReceivedMessage> makeMessage(int numParts) {
+    auto message = std::unique_ptr<ReceivedMessage>(new ReceivedMessage(makePart(NLPacket::FIRST, 0)));
+    for (int i = 1; i < numParts; ++i) {
+        message->appendPacket(makePart(i == numParts - 1 ? NLPacket::LAST : NLPacket::MIDDLE, i));
+    }
+    return message;
+}
+
+static QByteArray expectedBytes(int from, int size) {
+    QByteArray bytes;
+    for (int i = from; i < from + size; ++i) {
+        bytes.append((char)i);
+    }
+    return bytes;
+}
+
+void ReceivedMessageTests::readAcrossPacketsTest() {
+    auto message = makeMessage(3);
+    QVERIFY(!message->isContiguous());
+    QVERIFY(message->isComplete());
+    QCOMPARE(message->getSize(), (qint64)(3 * PAYLOAD_SIZE));
+
+    // bytes 5 to 8 straddle the first boundary
+    message->seek(5);
+    quint32 value;
+    QCOMPARE(message->readPrimitive(&value), (qint64)sizeof(value));
+    QByteArray valueBytes(reinterpret_cast<const char*>(&value), sizeof(value));
+    QCOMPARE(valueBytes, expectedBytes(5, sizeof(value)));
+    QCOMPARE(message->getPosition(), (qint64)9);
+
+    // the rest spans the second boundary, and reading past the end is clamped
+    QCOMPARE(message->read(100), expectedBytes(9, 3 * PAYLOAD_SIZE - 9));
+    QCOMPARE(message->getBytesLeftToRead(), (qint64)0);
+}
+
+void ReceivedMessageTests::peekAcrossPacketsTest() {
+    auto message = makeMessage(3);
+
+    message->seek(3);
+    QCOMPARE(message->peek(PAYLOAD_SIZE * 2), expectedBytes(3, PAYLOAD_SIZE * 2));
+    QCOMPARE(message->getPosition(), (qint64)3);
+
+    char buffer[PAYLOAD_SIZE + 2];
+    QCOMPARE(message->peek(buffer, sizeof(buffer)), (qint64)sizeof(buffer));
+    QCOMPARE(QByteArray(buffer, sizeof(buffer)), expectedBytes(3, sizeof(buffer)));
+    QCOMPARE(message->getPosition(), (qint64)3);
+}
+
+void ReceivedMessageTests::readSegmentsTest() {
+    auto message = makeMessage(3);
+
+    message->seek(2);
+    QByteArray visited;
+    int numSegments = 0;
+    qint64 size = message->readSegments(2 * PAYLOAD_SIZE + 1, [&](const char* data, qint64 length) {
+        visited.append(data, (int)length);
+        ++numSegments;
+    });
+
+    QCOMPARE(size, (qint64)(2 * PAYLOAD_SIZE + 1));
+    QCOMPARE(numSegments, 3);
+    QCOMPARE(visited, expectedBytes(2, 2 * PAYLOAD_SIZE + 1));
+    QCOMPARE(message->getPosition(), (qint64)(2 * PAYLOAD_SIZE + 3));
+}
+
+void ReceivedMessageTests::readWithoutCopyTest() {
+    auto message = makeMessage(3);
+
+    // within the first packet, this points into it
+    auto inPacket = message->readWithoutCopy(4);
+    QCOMPARE(inPacket, expectedBytes(0, 4));
+
+    const char* segment = nullptr;
+    message->readSegments(2, [&](const char* data, qint64) {
+        segment = data;
+    });
+
+    // across the boundaries, this is a copy
+    auto acrossPackets = message->readWithoutCopy(PAYLOAD_SIZE * 2);
+    QCOMPARE(acrossPackets, expectedBytes(6, PAYLOAD_SIZE * 2));
+
+    // making the message contiguous must not free the packets the earlier results point into
+    QCOMPARE(message->getMessage(), expectedBytes(0, 3 * PAYLOAD_SIZE));
+    QCOMPARE(message->getRawMessage()[PAYLOAD_SIZE], (char)PAYLOAD_SIZE);
+    QCOMPARE(inPacket, expectedBytes(0, 4));
+    QCOMPARE(QByteArray(segment, 2), expectedBytes(4, 2));
+    QCOMPARE(acrossPackets, expectedBytes(6, PAYLOAD_SIZE * 2));
+}
+
+void ReceivedMessageTests::getMessageAfterAppendTest() {
+    auto message = std::unique_ptr<ReceivedMessage>(new ReceivedMessage(makePart(NLPacket::FIRST, 0)));
+    message->appendPacket(makePart(NLPacket::MIDDLE, 1));
+
+    auto partial = message->getMessage();
+    QCOMPARE(partial, expectedBytes(0, 2 * PAYLOAD_SIZE));
+
+    message->appendPacket(makePart(NLPacket::LAST, 2));
+    QVERIFY(message->isComplete());
+    QCOMPARE(message->getMessage(), expectedBytes(0, 3 * PAYLOAD_SIZE));
+
+    // copies handed out earlier keep what they had
+    QCOMPARE(partial, expectedBytes(0, 2 * PAYLOAD_SIZE));
+}
@@ -0,0 +1,38 @@
+//
+//  ReceivedMessageTests.h
+//  tests/networking/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReceivedMessageTests_h
+#define hifi_ReceivedMessageTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class ReceivedMessageTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test reading primitives and byte arrays that straddle packet boundaries
+    void readAcrossPacketsTest();
+
+    // Test that peeking across packet boundaries reads the right bytes and leaves the position alone
+    void peekAcrossPacketsTest();
+
+    // Test that readSegments visits each packet's bytes in order
+    void readSegmentsTest();
+
+    // Test that readWithoutCopy results stay valid once the message is made contiguous
+    void readWithoutCopyTest();
+
+    // Test that getMessage picks up packets appended after it was first called
+    void getMessageAfterAppendTest();
+};
+
+#endif // hifi_ReceivedMessageTests_h
@@ -0,0 +1,313 @@
+//
+//  SentPacketWindowTests.cpp
+//  tests/networking/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketWindowTests.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include <udt/ControlPacket.h>
+#include <udt/LossList.h>
+#include <udt/SentPacketWindow.h>
+
+QTEST_MAIN(SentPacketWindowTests)
+
+using namespace udt;
+
+static const int WINDOW_SIZE = 10000;
+
+// sequence numbers counted from a base just short of the wrap around
+static SequenceNumber sequenceAt(int64_t offset) {
+    const int64_t BASE = SequenceNumber::MAX - 5000;
+    return SequenceNumber((SequenceNumber::UType)((BASE + offset) % ((int64_t)SequenceNumber::MAX + 1)));
+}
+
+void SentPacketWindowTests::windowTest() {
+    SentPacketWindow window(16);
+    std::vector<Packet*> sent;
+
+    for (int i = 0; i < WINDOW_SIZE; ++i) {
+        auto packet = Packet::create();
+        sent.push_back(packet.get());
+        window.insert(sequenceAt(i), std::move(packet));
+    }
+    QCOMPARE(window.getSize(), WINDOW_SIZE);
+    QVERIFY(window.getCapacity() >= WINDOW_SIZE);
+
+    for (int i = 0; i < WINDOW_SIZE; i += 7) {
+        auto entry = window.find(sequenceAt(i));
+        QVERIFY(entry);
+        QCOMPARE(entry->packet.get(), sent[i]);
+        QCOMPARE(entry->sequenceNumber, sequenceAt(i));
+        QCOMPARE(entry->resends, (uint8_t)0);
+    }
+    QVERIFY(!window.find(sequenceAt(-1)));
+    QVERIFY(!window.find(sequenceAt(WINDOW_SIZE)));
+
+    // ACK past the wrap around
+    window.acknowledge(sequenceAt(6000));
+    QCOMPARE(window.getSize(), WINDOW_SIZE - 6001);
+    QVERIFY(!window.find(sequenceAt(6000)));
+    QCOMPARE(window.find(sequenceAt(6001))->packet.get(), sent[6001]);
+
+    // an old ACK changes nothing
+    window.acknowledge(sequenceAt(10));
+    QCOMPARE(window.getSize(), WINDOW_SIZE - 6001);
+
+    window.clear();
+    QVERIFY(window.isEmpty());
+    QVERIFY(!window.find(sequenceAt(WINDOW_SIZE - 1)));
+
+    // the window restarts wherever the next packet is
+    window.insert(sequenceAt(WINDOW_SIZE + 100), Packet::create());
+    QCOMPARE(window.getSize(), 1);
+    QVERIFY(window.find(sequenceAt(WINDOW_SIZE + 100)));
+}
+
+void SentPacketWindowTests::lossListTest() {
+    std::mt19937 generator(1234);
+    LossList lossList;
+    std::set<int64_t> expected;
+    int64_t next = 0;
+
+    auto checkWrite = [&] {
+        auto packet = ControlPacket::create(ControlPacket::ACK);
+        int maxPairs = (int)(packet->getPayloadCapacity() / (2 * sizeof(SequenceNumber)));
+        lossList.write(*packet, maxPairs);
+
+        std::vector<SequenceNumber> pairs;
+        auto it = expected.begin();
+        while (it != expected.end() && (int)pairs.size() < 2 * maxPairs) {
+            int64_t start = *it;
+            int64_t end = start;
+            while (++it != expected.end() && *it == end + 1) {
+                ++end;
+            }
+            pairs.push_back(sequenceAt(start));
+            pairs.push_back(sequenceAt(end));
+        }
+
+        QCOMPARE(packet->getPayloadSize(), (qint64)(pairs.size() * sizeof(SequenceNumber)));
+        packet->seek(0);
+        for (auto& seq : pairs) {
+            SequenceNumber written;
+            packet->readPrimitive(&written);
+            QCOMPARE(written, seq);
+        }
+    };
+
+    for (int i = 0; i < 5000; ++i) {
+        switch (generator() % 5) {
+            case 0: {
+                int64_t start = next + generator() % 8;
+                int64_t end = start + generator() % 200;
+                lossList.append(sequenceAt(start), sequenceAt(end));
+                for (auto seq = start; seq <= end; ++seq) {
+                    expected.insert(seq);
+                }
+                next = end + 1;
+                break;
+            }
+            case 1: {
+                int64_t start = generator() % (next + 1);
+                int64_t end = start + generator() % 100;
+                lossList.insert(sequenceAt(start), sequenceAt(end));
+                for (auto seq = start; seq <= end; ++seq) {
+                    expected.insert(seq);
+                }
+                next = std::max(next, end + 1);
+                break;
+            }
+            case 2: {
+                int64_t seq = generator() % (next + 1);
+                QCOMPARE(lossList.remove(sequenceAt(seq)), expected.erase(seq) == 1);
+                break;
+            }
+            case 3: {
+                int64_t start = generator() % (next + 1);
+                int64_t end = start + generator() % 300;
+                lossList.remove(sequenceAt(start), sequenceAt(end));
+                expected.erase(expected.lower_bound(start), expected.upper_bound(end));
+                break;
+            }
+            default:
+                if (!expected.empty()) {
+                    QCOMPARE(lossList.popFirstSequenceNumber(), sequenceAt(*expected.begin()));
+                    expected.erase(expected.begin());
+                }
+                break;
+        }
+
+        QCOMPARE(lossList.getLength(), (int)expected.size());
+        if (!expected.empty()) {
+            QCOMPARE(lossList.getFirstSequenceNumber(), sequenceAt(*expected.begin()));
+        }
+        if (i % 100 == 0) {
+            checkWrite();
+        }
+    }
+
+    lossList.clear();
+    QVERIFY(lossList.isEmpty());
+}
+
+void SentPacketWindowTests::lossListGapTest() {
+    // a packet far ahead of the last one received
+    const int64_t GAP_END = 1 << 24;
+
+    auto readPairs = [](LossList& lossList) {
+        auto packet = ControlPacket::create(ControlPacket::ACK);
+        lossList.write(*packet);
+
+        std::vector<SequenceNumber> pairs;
+        packet->seek(0);
+        while (packet->bytesLeftToRead() >= (qint64)sizeof(SequenceNumber)) {
+            SequenceNumber seq;
+            packet->readPrimitive(&seq);
+            pairs.push_back(seq);
+        }
+        return pairs;
+    };
+
+    LossList lossList;
+    lossList.append(sequenceAt(0), sequenceAt(9));
+    lossList.append(sequenceAt(20), sequenceAt(GAP_END));
+    QCOMPARE(lossList.getLength(), (int)(10 + GAP_END - 19));
+    QCOMPARE(lossList.getFirstSequenceNumber(), sequenceAt(0));
+
+    // recover a few across the gap, splitting it
+    QVERIFY(lossList.remove(sequenceAt(5)));
+    QVERIFY(!lossList.remove(sequenceAt(15)));
+    lossList.remove(sequenceAt(1000), sequenceAt(1999));
+    lossList.insert(sequenceAt(12), sequenceAt(12));
+    QCOMPARE(lossList.getLength(), (int)(10 + GAP_END - 19 - 1 - 1000 + 1));
+
+    std::vector<SequenceNumber> expected {
+        sequenceAt(0), sequenceAt(4), sequenceAt(6), sequenceAt(9), sequenceAt(12), sequenceAt(12),
+        sequenceAt(20), sequenceAt(999), sequenceAt(2000), sequenceAt(GAP_END)
+    };
+    QCOMPARE(readPairs(lossList), expected);
+
+    // once everything is recovered, losses go back in the bitmap
+    lossList.remove(sequenceAt(0), sequenceAt(GAP_END));
+    QVERIFY(lossList.isEmpty());
+    lossList.append(sequenceAt(GAP_END + 10), sequenceAt(GAP_END + 12));
+    QCOMPARE(lossList.popFirstSequenceNumber(), sequenceAt(GAP_END + 10));
+    QCOMPARE(lossList.getLength(), 2);
+
+    // and a gap that is cleared doesn't outlive the connection reset
+    lossList.append(sequenceAt(GAP_END * 2), sequenceAt(GAP_END * 3));
+    lossList.clear();
+    QVERIFY(lossList.isEmpty());
+    lossList.append(sequenceAt(100));
+    expected = { sequenceAt(100), sequenceAt(100) };
+    QCOMPARE(readPairs(lossList), expected);
+}
+
+void SentPacketWindowTests::windowBenchmark_data() {
+    QTest::addColumn<bool>("useWindow");
+
+    QTest::newRow("unordered_map") << false;
+    QTest::newRow("window") << true;
+}
+
+void SentPacketWindowTests::windowBenchmark() {
+    QFETCH(bool, useWindow);
+
+    const int RESEND_INTERVAL = 100; // one packet in a hundred is resent
+    const int ACK_INTERVAL = 32;
+
+    std::unordered_map<SequenceNumber, std::pair<uint8_t, std::unique_ptr<Packet>>> map;
+    SentPacketWindow window;
+    int resends = 0;
+
+    // one iteration fills the window, then resends and acknowledges everything in it
+    QBENCHMARK {
+        for (int i = 0; i < WINDOW_SIZE; ++i) {
+            if (useWindow) {
+                window.insert(sequenceAt(i), Packet::create());
+            } else {
+                auto& entry = map[sequenceAt(i)];
+                entry.first = 0;
+                entry.second = Packet::create();
+            }
+        }
+
+        for (int i = 0; i < WINDOW_SIZE; i += RESEND_INTERVAL) {
+            if (useWindow) {
+                resends += ++window.find(sequenceAt(i))->resends;
+            } else {
+                resends += ++map.find(sequenceAt(i))->second.first;
+            }
+        }
+
+        for (int i = ACK_INTERVAL - 1; i < WINDOW_SIZE + ACK_INTERVAL; i += ACK_INTERVAL) {
+            if (useWindow) {
+                window.acknowledge(sequenceAt(std::min(i, WINDOW_SIZE - 1)));
+            } else {
+                for (int seq = i - (ACK_INTERVAL - 1); seq <= std::min(i, WINDOW_SIZE - 1); ++seq) {
+                    map.erase(sequenceAt(seq));
+                }
+            }
+        }
+    }
+
+    QVERIFY(window.isEmpty() && map.empty());
+    QVERIFY(resends > 0);
+}
+
+void SentPacketWindowTests::lossListBenchmark_data() {
+    QTest::addColumn<int>("lossPercent");
+
+    QTest::newRow("1% loss") << 1;
+    QTest::newRow("10% loss") << 10;
+}
+
+void SentPacketWindowTests::lossListBenchmark() {
+    QFETCH(int, lossPercent);
+
+    const int NAK_INTERVAL = 100;
+
+    std::mt19937 generator(1234);
+    std::vector<int> lost;
+    for (int i = 0; i < WINDOW_SIZE; ++i) {
+        if ((int)(generator() % 100) < lossPercent) {
+            lost.push_back(i);
+        }
+    }
+    std::vector<int> recovered = lost;
+    std::shuffle(recovered.begin(), recovered.end(), generator);
+
+    LossList lossList;
+    // the loss list has no NAK packet to write to in this tree, an ACK control packet has the same capacity
+    auto nak = ControlPacket::create(ControlPacket::ACK);
+
+    // one iteration records every loss in the window as the receiver sees it,
+    // sending NAKs as it goes, then recovers the losses in random order
+    QBENCHMARK {
+        for (size_t i = 0; i < lost.size(); ++i) {
+            lossList.append(sequenceAt(lost[i]));
+            if (i % NAK_INTERVAL == 0) {
+                nak->reset();
+                lossList.write(*nak, (int)(nak->getPayloadCapacity() / (2 * sizeof(SequenceNumber))));
+            }
+        }
+
+        for (int seq : recovered) {
+            lossList.remove(sequenceAt(seq));
+        }
+    }
+
+    QVERIFY(lossList.isEmpty());
+}
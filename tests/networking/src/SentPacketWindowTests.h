@@ -0,0 +1,40 @@
+//
+//  SentPacketWindowTests.h
+//  tests/networking/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SentPacketWindowTests_h
+#define hifi_SentPacketWindowTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class SentPacketWindowTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test insert, find and acknowledge, including growth and sequence number wrap around
+    void windowTest();
+
+    // Test the bitmap loss list against a set of lost sequence numbers
+    void lossListTest();
+
+    // Test a gap too wide for the bitmap, which the loss list keeps as ranges until it empties
+    void lossListGapTest();
+
+    // Send, resend and acknowledge a 10k packet window
+    void windowBenchmark_data();
+    void windowBenchmark();
+
+    // Record, NAK and recover the losses of a 10k packet window
+    void lossListBenchmark_data();
+    void lossListBenchmark();
+};
+
+#endif // hifi_SentPacketWindowTests_h
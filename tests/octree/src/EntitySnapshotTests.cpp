@@ -0,0 +1,159 @@
+//
+//  EntitySnapshotTests.cpp
+//  tests/octree/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySnapshotTests.h"
+
+#include <QTemporaryDir>
+
+#include <EntityTree.h>
+#include <OctreeDataUtils.h>
+
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(EntitySnapshotTests)
+
+static EntityTreePointer createTree() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    return tree;
+}
+
+static EntityItemPointer addEntity(const EntityTreePointer& tree, EntityTypes::EntityType type, const QString& name,
+                                   const QString& userData = QString()) {
+    EntityItemProperties properties;
+    properties.setType(type);
+    properties.setName(name);
+    properties.setUserData(userData);
+    properties.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    if (type == EntityTypes::Text) {
+        properties.setText("text of " + name);
+    }
+    return tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+}
+
+static void compareTrees(const EntityTreePointer& expected, const EntityTreePointer& actual) {
+    QCOMPARE(actual->getPersistID(), expected->getPersistID());
+    QCOMPARE(actual->getPersistDataVersion(), expected->getPersistDataVersion());
+
+    auto entities = expected->getEntitySnapshot();
+    QCOMPARE(actual->getEntitySnapshot().size(), entities.size());
+    for (const auto& entity : entities) {
+        auto read = actual->findEntityByID(entity->getID());
+        QVERIFY(read);
+        QCOMPARE(read->getType(), entity->getType());
+        QCOMPARE(read->getName(), entity->getName());
+        QCOMPARE(read->getUserData(), entity->getUserData());
+        QCOMPARE(read->getWorldPosition(), entity->getWorldPosition());
+        QCOMPARE(read->getProperties().getText(), entity->getProperties().getText());
+    }
+}
+
+void EntitySnapshotTests::snapshotRoundTripTest() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.snapshot");
+
+    auto tree = createTree();
+    tree->setOctreeVersionInfo(QUuid::createUuid(), 7);
+    QVERIFY(addEntity(tree, EntityTypes::Box, "box", "{ \"a\": 1 }"));
+    QVERIFY(addEntity(tree, EntityTypes::Text, "text"));
+    QVERIFY(tree->writeToSnapshotFile(filename.toUtf8().constData()));
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QVERIFY(OctreeUtils::isSnapshot(file.peek(OctreeUtils::SNAPSHOT_MAGIC_SIZE)));
+    file.close();
+
+    auto readTree = createTree();
+    QVERIFY(readTree->readFromFile(filename.toUtf8().constData()));
+    compareTrees(tree, readTree);
+}
+
+void EntitySnapshotTests::jsonFallbackTest() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.snapshot");
+
+    // the entity data encoding prefixes strings with a 16 bit length
+    QString largeUserData = QString("{ \"a\": \"%1\" }").arg(QString(100000, 'x'));
+
+    auto tree = createTree();
+    QVERIFY(addEntity(tree, EntityTypes::Box, "small"));
+    QVERIFY(addEntity(tree, EntityTypes::Box, "large", largeUserData));
+    QVERIFY(tree->writeToSnapshotFile(filename.toUtf8().constData()));
+
+    // the JSON record is larger than the user data, which the entity data records could not hold
+    QVERIFY(QFileInfo(filename).size() > largeUserData.size());
+
+    auto readTree = createTree();
+    QVERIFY(readTree->readFromFile(filename.toUtf8().constData()));
+    compareTrees(tree, readTree);
+}
+
+void EntitySnapshotTests::formatDetectionTest() {
+    QVERIFY(OctreeUtils::isSnapshot(QByteArray(OctreeUtils::SNAPSHOT_MAGIC) + "rest"));
+    QVERIFY(!OctreeUtils::isSnapshot("{ \"Entities\": [] }"));
+    QVERIFY(!OctreeUtils::isSnapshot(QByteArray("HF")));
+
+    auto tree = createTree();
+    QVERIFY(addEntity(tree, EntityTypes::Box, "box"));
+    QVERIFY(addEntity(tree, EntityTypes::Text, "text"));
+
+    auto checkFormat = [&](const QString& persistAs, const QString& renameTo) {
+        QTemporaryDir dir;
+        QString filename = dir.filePath("models." + persistAs);
+        QVERIFY(tree->writeToFile(dir.filePath("models").toUtf8().constData(), nullptr, persistAs));
+        QVERIFY(QFileInfo::exists(filename));
+
+        // the domain-server replaces content without regard for the extension
+        if (!renameTo.isEmpty()) {
+            QString renamed = dir.filePath("models." + renameTo);
+            QVERIFY(QFile::rename(filename, renamed));
+            filename = renamed;
+        }
+
+        auto readTree = createTree();
+        QVERIFY(readTree->readFromFile(filename.toUtf8().constData()));
+        compareTrees(tree, readTree);
+    };
+
+    checkFormat("json", QString());
+    checkFormat("json.gz", QString());
+    checkFormat("snapshot", QString());
+    checkFormat("json.gz", "json");
+    checkFormat("snapshot", "json");
+    checkFormat("json", "snapshot");
+}
+
+void EntitySnapshotTests::invalidSnapshotTest() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.snapshot");
+
+    auto tree = createTree();
+    QVERIFY(addEntity(tree, EntityTypes::Box, "box"));
+    QVERIFY(tree->writeToSnapshotFile(filename.toUtf8().constData()));
+
+    // a snapshot cut off before its End record
+    {
+        QFile file(filename);
+        QVERIFY(file.resize(file.size() - 1));
+    }
+    QVERIFY(!createTree()->readFromFile(filename.toUtf8().constData()));
+
+    // a snapshot whose records were encoded by another data version
+    {
+        QFile file(filename);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QDataStream stream(&file);
+        OctreeUtils::writeSnapshotHeader(stream, QUuid::createUuid(), 1, tree->expectedVersion() + 1);
+        stream << (quint8)0;
+    }
+    QVERIFY(!createTree()->readFromFile(filename.toUtf8().constData()));
+}
@@ -0,0 +1,33 @@
+//
+//  EntitySnapshotTests.h
+//  tests/octree/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySnapshotTests_h
+#define hifi_EntitySnapshotTests_h
+
+#include <QtTest/QtTest>
+
+class EntitySnapshotTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that entities and the persist ID survive a binary snapshot
+    void snapshotRoundTripTest();
+
+    // Test that an entity too large for the entity data encoding is written as JSON and read back
+    void jsonFallbackTest();
+
+    // Test that readFromFile tells snapshots, gzipped JSON and JSON apart whatever the file is called
+    void formatDetectionTest();
+
+    // Test that truncated snapshots and snapshots of another data version are rejected
+    void invalidSnapshotTest();
+};
+
+#endif // hifi_EntitySnapshotTests_h
@@ -0,0 +1,179 @@
+//
+//  OctreeEditLogTests.cpp
+//  tests/octree/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEditLogTests.h"
+
+#include <QTemporaryDir>
+
+#include <OctreeEditLog.h>
+
+QTEST_MAIN(OctreeEditLogTests)
+
+// opens the log as a restarting server would, returning the records it replays
+static QList<QByteArray> replay(const QString& filename, const QUuid& persistID, int64_t dataVersion) {
+    QList<QByteArray> records;
+    OctreeEditLog log(filename);
+    log.open(persistID, dataVersion, [&](const QByteArray& record) {
+        records.append(record);
+        return true;
+    });
+    return records;
+}
+
+void OctreeEditLogTests::replayTest() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.log");
+    QUuid persistID = QUuid::createUuid();
+
+    {
+        OctreeEditLog log(filename);
+        QCOMPARE(log.open(persistID, 1, [](const QByteArray&) { return true; }), 0);
+        log.append("a");
+        log.append("b");
+        log.append(QByteArray(100000, 'c'));
+        QVERIFY(log.flush());
+        QCOMPARE(log.getNumAppended(), (quint64)3);
+        QCOMPARE(log.getSize(), QFileInfo(filename).size());
+    }
+
+    QList<QByteArray> records = replay(filename, persistID, 1);
+    QCOMPARE(records.size(), 3);
+    QCOMPARE(records[0], QByteArray("a"));
+    QCOMPARE(records[1], QByteArray("b"));
+    QCOMPARE(records[2], QByteArray(100000, 'c'));
+
+    // replaying doesn't change the log, so a second crash replays the same edits
+    QCOMPARE(replay(filename, persistID, 1).size(), 3);
+}
+
+void OctreeEditLogTests::checkpointTest() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.log");
+    QUuid persistID = QUuid::createUuid();
+
+    {
+        OctreeEditLog log(filename);
+        log.open(persistID, 1, [](const QByteArray&) { return true; });
+        log.append("a");
+        log.checkpoint(2);
+        log.append("b");
+    }
+
+    // edits follow on from the checkpoint of the data that was loaded...
+    QCOMPARE(replay(filename, persistID, 2), QList<QByteArray>({ "b" }));
+
+    // ...and run through later checkpoints, whose snapshots might never have been written
+    QCOMPARE(replay(filename, persistID, 1), QList<QByteArray>({ "a", "b" }));
+}
+
+void OctreeEditLogTests::compactTest() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.log");
+    QUuid persistID = QUuid::createUuid();
+
+    {
+        OctreeEditLog log(filename);
+        log.open(persistID, 1, [](const QByteArray&) { return true; });
+        log.append(QByteArray(1000, 'a'));
+        log.checkpoint(2);
+        log.append("b");
+
+        qint64 sizeBefore = log.getSize();
+        QVERIFY(!log.compact(3));
+        QVERIFY(log.compact(2));
+        QVERIFY(log.getSize() < sizeBefore - 1000);
+        QCOMPARE(log.getSize(), QFileInfo(filename).size());
+
+        // appends carry on after compaction
+        log.append("c");
+        log.checkpoint(3);
+        log.append("d");
+        QVERIFY(log.compact(3));
+    }
+
+    QCOMPARE(replay(filename, persistID, 3), QList<QByteArray>({ "d" }));
+}
+
+void OctreeEditLogTests::tornTailTest() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.log");
+    QUuid persistID = QUuid::createUuid();
+
+    {
+        OctreeEditLog log(filename);
+        log.open(persistID, 1, [](const QByteArray&) { return true; });
+        log.append("a");
+        log.append("b");
+    }
+
+    // a crash part way through the last frame loses only that edit
+    QFile file(filename);
+    QVERIFY(file.resize(file.size() - 1));
+
+    {
+        OctreeEditLog log(filename);
+        QList<QByteArray> records;
+        log.open(persistID, 1, [&](const QByteArray& record) {
+            records.append(record);
+            return true;
+        });
+        QCOMPARE(records, QList<QByteArray>({ "a" }));
+
+        log.append("c");
+    }
+
+    QCOMPARE(replay(filename, persistID, 1), QList<QByteArray>({ "a", "c" }));
+}
+
+void OctreeEditLogTests::otherDataTest() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.log");
+    QUuid persistID = QUuid::createUuid();
+
+    {
+        OctreeEditLog log(filename);
+        log.open(persistID, 1, [](const QByteArray&) { return true; });
+        log.append("a");
+    }
+
+    // replacement content has a new persist ID, and older data has no checkpoint; either way the log starts over
+    QVERIFY(replay(filename, QUuid::createUuid(), 1).isEmpty());
+    QVERIFY(replay(filename, persistID, 1).isEmpty());
+
+    {
+        OctreeEditLog log(filename);
+        log.open(persistID, 1, [](const QByteArray&) { return true; });
+        log.append("a");
+    }
+    QVERIFY(replay(filename, persistID, 0).isEmpty());
+    QVERIFY(replay(filename, persistID, 1).isEmpty());
+}
+
+void OctreeEditLogTests::flushingTest() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.log");
+    QUuid persistID = QUuid::createUuid();
+
+    OctreeEditLog log(filename);
+    log.open(persistID, 1, [](const QByteArray&) { return true; });
+    log.startFlushing(std::chrono::milliseconds(10));
+
+    // the edits reach the disk without anyone calling flush()
+    log.append("a");
+    log.append("b");
+    QTRY_COMPARE(QFileInfo(filename).size(), log.getSize());
+    QCOMPARE(replay(filename, persistID, 1), QList<QByteArray>({ "a", "b" }));
+
+    log.stopFlushing();
+    log.append("c");
+    QTest::qWait(50);
+    QVERIFY(QFileInfo(filename).size() < log.getSize());
+}
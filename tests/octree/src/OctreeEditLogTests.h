@@ -0,0 +1,28 @@
+//
+//  OctreeEditLogTests.h
+//  tests/octree/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeEditLogTests_h
+#define hifi_OctreeEditLogTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeEditLogTests : public QObject {
+    Q_OBJECT
+private slots:
+    void replayTest();
+    void checkpointTest();
+    void compactTest();
+    void tornTailTest();
+    void otherDataTest();
+    void flushingTest();
+};
+
+#endif // hifi_OctreeEditLogTests_h
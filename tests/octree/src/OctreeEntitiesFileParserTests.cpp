@@ -0,0 +1,112 @@
+//
+//  OctreeEntitiesFileParserTests.cpp
+//  tests/octree/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEntitiesFileParserTests.h"
+
+#include <QJsonObject>
+
+#include <OctreeEntitiesFileParser.h>
+
+QTEST_MAIN(OctreeEntitiesFileParserTests)
+
+static const QString PERSIST_ID = "{2c51dc58-1a0e-4ab4-8a3b-f0bd0d4cc5c5}";
+static const int HEADER_LINES = 4;
+
+// one entity per line, with strings that the brace matching has to skip over
+static QString entityLine(int index) {
+    return QString("{\"id\":\"entity-%1\",\"name\":\"}{ \\\"%1\\\" \\u007b\",\"userData\":\"{\\\"nested\\\":{}}\","
+                   "\"position\":{\"x\":%1,\"y\":0,\"z\":0}}").arg(index);
+}
+
+static QByteArray persistFile(const QStringList& entityLines) {
+    QString contents = QString("{\n\"DataVersion\": 7,\n\"Id\": \"%1\",\n\"Entities\": [\n").arg(PERSIST_ID);
+    contents += entityLines.join(",\n");
+    contents += "\n],\n\"Version\": 120\n}\n";
+    return contents.toUtf8();
+}
+
+static QStringList entityLines(int numEntities) {
+    QStringList lines;
+    for (int i = 0; i < numEntities; ++i) {
+        lines.append(entityLine(i));
+    }
+    return lines;
+}
+
+void OctreeEntitiesFileParserTests::parseTest() {
+    // enough entities for several chunks on the thread pool, and a partial last chunk
+    const int NUM_ENTITIES = 2000;
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(persistFile(entityLines(NUM_ENTITIES)));
+
+    QVariantMap parsed;
+    QVERIFY(parser.parseEntities(parsed));
+    QCOMPARE(parsed["DataVersion"].toInt(), 7);
+    QCOMPARE(parsed["Version"].toInt(), 120);
+    QCOMPARE(parsed["Id"].toUuid(), QUuid(PERSIST_ID));
+
+    // the entities keep their order in the file
+    QVariantList entities = parsed["Entities"].toList();
+    QCOMPARE(entities.size(), NUM_ENTITIES);
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        QVariantMap entity = entities[i].toMap();
+        QCOMPARE(entity["id"].toString(), QString("entity-%1").arg(i));
+        QCOMPARE(entity["name"].toString(), QString("}{ \"%1\" {").arg(i));
+        QCOMPARE(entity["position"].toMap()["x"].toInt(), i);
+    }
+}
+
+void OctreeEntitiesFileParserTests::illFormedTest() {
+    // the braces match, so only parsing the entities finds them; the first one is reported, wherever it was parsed
+    const int NUM_ENTITIES = 2000;
+    const int FIRST_ILL_FORMED = 700;
+    QStringList lines = entityLines(NUM_ENTITIES);
+    lines[FIRST_ILL_FORMED] = "{\"id\":\"entity\" \"name\":\"entity\"}";
+    lines[NUM_ENTITIES - 10] = "{\"id\" \"entity\"}";
+    lines[NUM_ENTITIES - 1] = "{\"id\":entity}";
+
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(persistFile(lines));
+    QVariantMap parsed;
+    QVERIFY(!parser.parseEntities(parsed));
+
+    QString error = QString::fromStdString(parser.getErrorString());
+    QVERIFY(error.contains("Ill-formed entity"));
+    QVERIFY(error.contains(QString("Line %1,").arg(HEADER_LINES + FIRST_ILL_FORMED + 1)));
+}
+
+void OctreeEntitiesFileParserTests::skipEntitiesTest() {
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(persistFile(entityLines(100)));
+    parser.setSkipEntities(true);
+
+    QVariantMap parsed;
+    QVERIFY(parser.parseEntities(parsed));
+    QCOMPARE(parsed["DataVersion"].toInt(), 7);
+    QCOMPARE(parsed["Version"].toInt(), 120);
+    QCOMPARE(parsed["Id"].toUuid(), QUuid(PERSIST_ID));
+    QVERIFY(parsed["Entities"].toList().isEmpty());
+
+    // the entities still have to be delimited
+    parser.setEntitiesString(persistFile({ entityLine(0), "{\"id\":\"entity\"" }));
+    QVERIFY(!parser.parseEntities(parsed));
+}
+
+void OctreeEntitiesFileParserTests::singleEntityTest() {
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(persistFile({ entityLine(42) }));
+
+    QVariantMap parsed;
+    QVERIFY(parser.parseEntities(parsed));
+    QVariantList entities = parsed["Entities"].toList();
+    QCOMPARE(entities.size(), 1);
+    QCOMPARE(entities[0].toMap()["id"].toString(), QString("entity-42"));
+}
@@ -0,0 +1,120 @@
+//
+//  GzipTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GzipTests.h"
+
+#include <QBuffer>
+#include <QTemporaryFile>
+
+#include <Gzip.h>
+
+QTEST_MAIN(GzipTests)
+
+// a buffer that can't seek, as a socket or pipe would be, so that gunzip can't read the size from the trailer
+class SequentialBuffer : public QBuffer {
+public:
+    SequentialBuffer(QByteArray* data) : QBuffer(data) {}
+    bool isSequential() const override { return true; }
+};
+
+// compressible like a persist file, but not so much that a few chunks of input hold all of it
+static QByteArray makeData(int size) {
+    QByteArray data;
+    data.reserve(size);
+    quint32 seed = 1;
+    while (data.size() < size) {
+        seed = seed * 1664525 + 1013904223;
+        data.append(QString("{\"id\":\"%1\",\"position\":%2},\n").arg(seed).arg(seed % 1000).toUtf8());
+    }
+    data.resize(size);
+    return data;
+}
+
+static QByteArray compress(const QByteArray& data) {
+    QByteArray compressed;
+    gzip(data, compressed);
+    return compressed;
+}
+
+void GzipTests::fileTest() {
+    for (int size : { 1, 1000, 100 * 1000, 5 * 1000 * 1000 }) {
+        QByteArray data = makeData(size);
+
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        file.write(compress(data));
+        QVERIFY(file.seek(0));
+
+        QByteArray inflated;
+        QVERIFY(gunzip(file, inflated));
+        QCOMPARE(inflated.size(), data.size());
+        QCOMPARE(inflated, data);
+    }
+}
+
+void GzipTests::sequentialTest() {
+    // without the trailer the destination grows as it fills
+    QByteArray data = makeData(3 * 1000 * 1000);
+    QByteArray compressed = compress(data);
+    SequentialBuffer buffer(&compressed);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QByteArray inflated;
+    QVERIFY(gunzip(buffer, inflated));
+    QCOMPARE(inflated, data);
+}
+
+void GzipTests::offsetTest() {
+    // the stream starts wherever the device is
+    QByteArray data = makeData(100 * 1000);
+    QByteArray contents = QByteArray("header") + compress(data);
+    QBuffer buffer(&contents);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QCOMPARE(buffer.read(6), QByteArray("header"));
+
+    QByteArray inflated;
+    QVERIFY(gunzip(buffer, inflated));
+    QCOMPARE(inflated, data);
+
+    // the byte array version agrees
+    QByteArray unzipped;
+    QVERIFY(gunzip(contents.mid(6), unzipped));
+    QCOMPARE(unzipped, data);
+}
+
+void GzipTests::corruptTest() {
+    QByteArray compressed = compress(makeData(100 * 1000));
+    for (int i = compressed.size() / 2; i < compressed.size() / 2 + 16; ++i) {
+        compressed[i] = compressed[i] ^ 0x5a;
+    }
+    QBuffer buffer(&compressed);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QByteArray inflated("left over");
+    QVERIFY(!gunzip(buffer, inflated));
+    QVERIFY(inflated.isEmpty());
+}
+
+void GzipTests::truncatedTest() {
+    QByteArray compressed = compress(makeData(100 * 1000));
+    compressed.chop(compressed.size() / 3);
+
+    QBuffer buffer(&compressed);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QByteArray inflated;
+    QVERIFY(!gunzip(buffer, inflated));
+    QVERIFY(inflated.isEmpty());
+
+    SequentialBuffer sequentialBuffer(&compressed);
+    QVERIFY(sequentialBuffer.open(QIODevice::ReadOnly));
+    QVERIFY(!gunzip(sequentialBuffer, inflated));
+    QVERIFY(inflated.isEmpty());
+}
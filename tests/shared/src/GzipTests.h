@@ -0,0 +1,27 @@
+//
+//  GzipTests.h
+//  tests/shared/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_GzipTests_h
+#define hifi_GzipTests_h
+
+#include <QtTest/QtTest>
+
+class GzipTests : public QObject {
+    Q_OBJECT
+private slots:
+    void fileTest();
+    void sequentialTest();
+    void offsetTest();
+    void corruptTest();
+    void truncatedTest();
+};
+
+#endif // hifi_GzipTests_h
@@ -0,0 +1,107 @@
+//
+//  WorkStealingQueueTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkStealingQueueTests.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <WorkStealingQueue.h>
+
+QTEST_MAIN(WorkStealingQueueTests)
+
+void WorkStealingQueueTests::singleWorkerTest() {
+    WorkStealingQueue queue;
+    queue.reset(10, 1, 4);
+
+    size_t begin, end;
+    bool stolen;
+    std::vector<std::pair<size_t, size_t>> chunks;
+    while (queue.pop(0, begin, end, stolen)) {
+        QVERIFY(!stolen);
+        chunks.emplace_back(begin, end);
+    }
+
+    // a lone worker takes its chunks in order, the last one short
+    QCOMPARE(chunks.size(), (size_t)3);
+    QCOMPARE(chunks[0], std::make_pair((size_t)0, (size_t)4));
+    QCOMPARE(chunks[1], std::make_pair((size_t)4, (size_t)8));
+    QCOMPARE(chunks[2], std::make_pair((size_t)8, (size_t)10));
+
+    // an empty queue has nothing to give
+    queue.reset(0, 4);
+    QVERIFY(!queue.pop(0, begin, end, stolen));
+}
+
+void WorkStealingQueueTests::stealTest() {
+    WorkStealingQueue queue;
+    queue.reset(8, 2, 1);
+
+    // worker 0 drains its own half front to back...
+    size_t begin, end;
+    bool stolen;
+    for (size_t i = 0; i < 4; ++i) {
+        QVERIFY(queue.pop(0, begin, end, stolen));
+        QVERIFY(!stolen);
+        QCOMPARE(begin, i);
+    }
+
+    // ...then steals worker 1's half from the back
+    QVERIFY(queue.pop(0, begin, end, stolen));
+    QVERIFY(stolen);
+    QCOMPARE(begin, (size_t)7);
+
+    // while worker 1 still takes from its front
+    QVERIFY(queue.pop(1, begin, end, stolen));
+    QVERIFY(!stolen);
+    QCOMPARE(begin, (size_t)4);
+}
+
+void WorkStealingQueueTests::concurrentTest() {
+    const int NUM_WORKERS = 4;
+    const size_t NUM_ITEMS = 10000;
+
+    WorkStealingQueue queue;
+    std::vector<std::atomic<int>> claims(NUM_ITEMS);
+
+    for (int round = 0; round < 20; ++round) {
+        for (auto& claim : claims) {
+            claim = 0;
+        }
+        queue.reset(NUM_ITEMS, NUM_WORKERS);
+
+        // worker 0 is slow, so the others have to steal its share
+        std::vector<std::thread> workers;
+        for (int worker = 0; worker < NUM_WORKERS; ++worker) {
+            workers.emplace_back([&, worker] {
+                size_t begin, end;
+                bool stolen;
+                while (queue.pop(worker, begin, end, stolen)) {
+                    for (size_t i = begin; i < end; ++i) {
+                        ++claims[i];
+                    }
+                    if (worker == 0) {
+                        std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        // every item is handed out exactly once
+        for (auto& claim : claims) {
+            QCOMPARE((int)claim, 1);
+        }
+    }
+}
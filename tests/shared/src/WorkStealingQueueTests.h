@@ -0,0 +1,25 @@
+//
+//  WorkStealingQueueTests.h
+//  tests/shared/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_WorkStealingQueueTests_h
+#define hifi_WorkStealingQueueTests_h
+
+#include <QtTest/QtTest>
+
+class WorkStealingQueueTests : public QObject {
+    Q_OBJECT
+private slots:
+    void singleWorkerTest();
+    void stealTest();
+    void concurrentTest();
+};
+
+#endif // hifi_WorkStealingQueueTests_h
@@ -0,0 +1,380 @@
+//
+//  AudioMixerBench.cpp
+//  tools/audio-mixer-bench/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerBench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QFile>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QTextStream>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <AudioConstants.h>
+#include <DependencyManager.h>
+#include <NumericalConstants.h>
+#include <PortableHighResolutionClock.h>
+#include <ReceivedMessage.h>
+#include <Sound.h>
+#include <plugins/PluginManager.h>
+#include <udt/PacketHeaders.h>
+
+#include "AudioMixerClientData.h"
+
+static const int WARMUP_FRAMES = 10;
+static const int SYNTHETIC_SOURCE_SECONDS = 10;
+
+// nothing listens on these ports, the kernel drops the mixed packets but their send cost is measured
+static const quint16 AGENT_BASE_PORT = 50000;
+
+AudioMixerBench::AudioMixerBench(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures audio mixer capacity with synthetic agents");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption wavOption("wav", "16-bit WAV file each agent speaks (looped)", "path");
+    parser.addOption(wavOption);
+
+    const QCommandLineOption codecOption("codec", "codec used by every agent (pcm, zlib, hifiAC)", "name", _codecName);
+    parser.addOption(codecOption);
+
+    const QCommandLineOption listenersOption("listeners", "maximum number of listeners", "count",
+                                             QString::number(_maxListeners));
+    parser.addOption(listenersOption);
+
+    const QCommandLineOption stepOption("step", "listeners added at each step", "count", QString::number(_listenerStep));
+    parser.addOption(stepOption);
+
+    const QCommandLineOption framesOption("frames", "mix frames measured at each step", "count",
+                                          QString::number(_numFrames));
+    parser.addOption(framesOption);
+
+    const QCommandLineOption threadsOption("threads", "mixer slave threads", "count",
+                                           QString::number(QThread::idealThreadCount()));
+    parser.addOption(threadsOption);
+
+    const QCommandLineOption spacingOption("spacing", "distance between agents on the grid (meters)", "meters",
+                                           QString::number(_spacing));
+    parser.addOption(spacingOption);
+
+    const QCommandLineOption hrtfCacheOption("hrtf-cache", "share far-field HRTF renders between listeners");
+    parser.addOption(hrtfCacheOption);
+
+    const QCommandLineOption verboseOption("v", "verbose output");
+    parser.addOption(verboseOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    _wavPath = parser.value(wavOption);
+    _codecName = parser.value(codecOption);
+    _maxListeners = std::max(parser.value(listenersOption).toInt(), 1);
+    _listenerStep = std::max(parser.value(stepOption).toInt(), 1);
+    _numFrames = std::max(parser.value(framesOption).toInt(), 1);
+    _numThreads = std::max(parser.value(threadsOption).toInt(), 1);
+    _spacing = parser.value(spacingOption).toFloat();
+    _useHRTFCache = parser.isSet(hrtfCacheOption);
+    _verbose = parser.isSet(verboseOption);
+
+    if (!_verbose) {
+        QLoggingCategory::setFilterRules("*.debug=false\n*.info=false");
+    }
+
+    QTimer::singleShot(0, this, &AudioMixerBench::run);
+}
+
+AudioMixerBench::~AudioMixerBench() {
+    _slavePool.reset();
+
+    for (auto& agent : _agents) {
+        if (agent.encoder) {
+            _codec->releaseEncoder(agent.encoder);
+        }
+    }
+    _agents.clear();
+
+    DependencyManager::destroy<NodeList>();
+    DependencyManager::destroy<PluginManager>();
+}
+
+bool AudioMixerBench::loadSource(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Could not open" << path;
+        return false;
+    }
+
+    QByteArray data = file.readAll();
+    QByteArray samples;
+
+    SoundProcessor processor(QWeakPointer<Resource>(), data);
+    auto properties = processor.interpretAsWav(data, samples);
+    if (properties.sampleRate == 0 || properties.numChannels == 0) {
+        qCritical() << path << "is not a supported WAV file";
+        return false;
+    }
+    samples = processor.downSample(samples, properties);
+
+    // downmix to mono
+    int numChannels = properties.numChannels;
+    int numFrames = samples.size() / (numChannels * AudioConstants::SAMPLE_SIZE);
+    const int16_t* input = reinterpret_cast<const int16_t*>(samples.constData());
+
+    _source.resize(numFrames * AudioConstants::SAMPLE_SIZE);
+    int16_t* output = reinterpret_cast<int16_t*>(_source.data());
+    for (int i = 0; i < numFrames; i++) {
+        int sum = 0;
+        for (int c = 0; c < numChannels; c++) {
+            sum += input[i * numChannels + c];
+        }
+        output[i] = (int16_t)(sum / numChannels);
+    }
+
+    return numFrames >= AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+}
+
+void AudioMixerBench::generateSource() {
+    // band-limited noise with a syllable-rate envelope, loud enough to never be treated as silence
+    const int numSamples = SYNTHETIC_SOURCE_SECONDS * AudioConstants::SAMPLE_RATE;
+    _source.resize(numSamples * AudioConstants::SAMPLE_SIZE);
+    int16_t* output = reinterpret_cast<int16_t*>(_source.data());
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    float lowpass = 0.0f;
+    for (int i = 0; i < numSamples; i++) {
+        lowpass += 0.2f * (noise(generator) - lowpass);
+        float envelope = 0.55f + 0.45f * std::sin(TWO_PI * 4.0f * i / AudioConstants::SAMPLE_RATE);
+        output[i] = (int16_t)(12000.0f * envelope * lowpass);
+    }
+}
+
+bool AudioMixerBench::setupCodec() {
+    auto pluginManager = DependencyManager::set<PluginManager>();
+    pluginManager->setPluginFilter([](const QJsonObject& metaData) {
+        QJsonValue nameValue = metaData["MetaData"]["name"];
+        return nameValue.toString().contains("codec", Qt::CaseInsensitive);
+    });
+
+    for (auto& codec : pluginManager->getCodecPlugins()) {
+        if (codec->getName() == _codecName) {
+            _codec = codec;
+            return true;
+        }
+    }
+
+    // raw PCM does not need the plugin
+    return _codecName == "pcm";
+}
+
+void AudioMixerBench::addAgents(int numAgents) {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // agents fill a square grid, centered on the origin
+    int side = (int)std::ceil(std::sqrt((float)_maxListeners));
+    float offset = 0.5f * (side - 1) * _spacing;
+
+    for (int i = 0; i < numAgents; i++) {
+        int index = (int)_agents.size();
+
+        Agent agent;
+        agent.position = glm::vec3((index % side) * _spacing - offset, 0.0f, (index / side) * _spacing - offset);
+        agent.sourceOffset = (index * 7919) % (_source.size() / AudioConstants::SAMPLE_SIZE);
+        if (_codec) {
+            agent.encoder = _codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
+        }
+
+        HifiSockAddr socket(QHostAddress::LocalHost, AGENT_BASE_PORT + index);
+        agent.node = nodeList->addOrUpdateNode(QUuid::createUuid(), NodeType::Agent, socket, socket,
+                                               (Node::LocalID)(index + 1));
+        agent.node->activatePublicSocket();
+
+        // linked data is created by the node list callback
+        nodeList->getOrCreateLinkedData(agent.node);
+
+        _agents.push_back(std::move(agent));
+    }
+}
+
+void AudioMixerBench::queueAudioPackets() {
+    const int sourceSamples = _source.size() / AudioConstants::SAMPLE_SIZE;
+    const int16_t* source = reinterpret_cast<const int16_t*>(_source.constData());
+    const PacketType packetType = PacketType::MicrophoneAudioNoEcho;
+    const glm::vec3 boundingBoxScale(0.5f, 1.8f, 0.5f);
+
+    QByteArray decoded(AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL, Qt::Uninitialized);
+    int16_t* decodedSamples = reinterpret_cast<int16_t*>(decoded.data());
+
+    for (auto& agent : _agents) {
+        // the next frame of this agent's speech, looping over the source
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+            decodedSamples[i] = source[(agent.sourceOffset + i) % sourceSamples];
+        }
+        agent.sourceOffset = (agent.sourceOffset + AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL) % sourceSamples;
+
+        QByteArray encoded;
+        if (agent.encoder) {
+            agent.encoder->encode(decoded, encoded);
+        } else {
+            encoded = decoded;
+        }
+
+        // same layout as AbstractAudioInterface::emitAudioPacket
+        auto packet = NLPacket::create(packetType);
+        packet->writePrimitive(agent.sequence++);
+        packet->writeString(_codecName);
+        packet->writePrimitive((quint8)0);  // mono
+        packet->writePrimitive(agent.position);
+        packet->writePrimitive(glm::quat());
+        packet->writePrimitive(agent.position - 0.5f * boundingBoxScale);
+        packet->writePrimitive(boundingBoxScale);
+        packet->write(encoded);
+
+        QByteArray payload(packet->getPayload(), (int)packet->getPayloadSize());
+        auto message = QSharedPointer<ReceivedMessage>::create(payload, packetType, versionForPacketType(packetType),
+                                                               agent.node->getPublicSocket(), agent.node->getLocalID());
+
+        auto clientData = static_cast<AudioMixerClientData*>(agent.node->getLinkedData());
+        clientData->queuePacket(message, agent.node);
+    }
+}
+
+void AudioMixerBench::runFrame(FrameTimings& timings) {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    queueAudioPackets();
+
+    auto start = p_high_resolution_clock::now();
+
+    nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+        _slavePool->processPackets(cbegin, cend);
+    });
+
+    auto processed = p_high_resolution_clock::now();
+
+    nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+        _slavePool->mix(cbegin, cend, _frame, -1);
+    });
+
+    auto mixed = p_high_resolution_clock::now();
+
+    _sharedData.hrtfCache.prune(_frame);
+    _sharedData.addedStreams.clear();
+
+    // the slaves time mixing and encoding separately, with the same clock
+    _slavePool->each([&](AudioMixerSlave& slave) {
+        timings.mix += slave.stats.mixTime;
+        timings.encode += slave.stats.encodeTime;
+        slave.stats.reset();
+    });
+
+    timings.processPackets += std::chrono::duration_cast<std::chrono::microseconds>(processed - start).count();
+    timings.total += std::chrono::duration_cast<std::chrono::microseconds>(mixed - start).count();
+
+    ++_frame;
+}
+
+void AudioMixerBench::run() {
+    if (_wavPath.isEmpty()) {
+        generateSource();
+    } else if (!loadSource(_wavPath)) {
+        exit(1);
+        return;
+    }
+
+    if (!setupCodec()) {
+        qCritical() << "Codec" << _codecName << "is not available";
+        exit(1);
+        return;
+    }
+
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>(false, [&]{ return QString("Mozilla/5.0 (HighFidelityAudioMixerBench)"); });
+    DependencyManager::set<AddressManager>();
+    auto nodeList = DependencyManager::set<NodeList>(NodeType::AudioMixer, 0);
+
+    nodeList->linkedDataCreateCallback = [&](Node* node) {
+        auto clientData = new AudioMixerClientData(node->getUUID(), node->getLocalID());
+        clientData->setupCodec(_codec, _codecName);
+        node->setLinkedData(std::unique_ptr<NodeData> { clientData });
+    };
+
+    if (_useHRTFCache) {
+        AudioMixerHRTFCache::Settings settings;
+        settings.enabled = true;
+        _sharedData.hrtfCache.setSettings(settings);
+    }
+
+    _slavePool.reset(new AudioMixerSlavePool(_sharedData, _numThreads));
+
+    QTextStream out(stdout);
+    const int frameBudget = AudioConstants::NETWORK_FRAME_USECS;
+
+    out << "codec: " << _codecName << ", threads: " << _numThreads << ", spacing: " << _spacing << "m"
+        << ", hrtf cache: " << (_useHRTFCache ? "on" : "off") << ", frame budget: " << frameBudget << "us" << endl;
+    out << "mix_us and encode_us are summed over the mixing threads, total_us is wall clock" << endl;
+    out << qSetFieldWidth(12) << "listeners" << "packets_us" << "mix_us" << "encode_us" << "total_us"
+        << qSetFieldWidth(0) << endl;
+
+    int budgetBlownAt = 0;
+    for (int numListeners = _listenerStep; numListeners <= _maxListeners; numListeners += _listenerStep) {
+        addAgents(numListeners - (int)_agents.size());
+
+        // fill the jitter buffers and let the streams settle
+        for (int i = 0; i < WARMUP_FRAMES; i++) {
+            FrameTimings warmup;
+            runFrame(warmup);
+        }
+
+        FrameTimings timings;
+        for (int i = 0; i < _numFrames; i++) {
+            runFrame(timings);
+        }
+
+        uint64_t packetsPerFrame = timings.processPackets / _numFrames;
+        uint64_t mixPerFrame = timings.mix / 1000 / _numFrames;
+        uint64_t encodePerFrame = timings.encode / 1000 / _numFrames;
+        uint64_t totalPerFrame = timings.total / _numFrames;
+
+        out << qSetFieldWidth(12) << numListeners << packetsPerFrame << mixPerFrame << encodePerFrame << totalPerFrame
+            << qSetFieldWidth(0) << endl;
+
+        if (totalPerFrame > (uint64_t)frameBudget) {
+            budgetBlownAt = numListeners;
+            break;
+        }
+    }
+
+    if (budgetBlownAt > 0) {
+        out << "frame budget blown at " << budgetBlownAt << " listeners" << endl;
+    } else {
+        out << "frame budget held up to " << _agents.size() << " listeners" << endl;
+    }
+
+    exit(0);
+}
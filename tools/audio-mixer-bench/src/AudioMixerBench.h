@@ -0,0 +1,83 @@
+//
+//  AudioMixerBench.h
+//  tools/audio-mixer-bench/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerBench_h
+#define hifi_AudioMixerBench_h
+
+#include <memory>
+#include <vector>
+
+#include <QCoreApplication>
+
+#include <glm/glm.hpp>
+
+#include <NodeList.h>
+#include <plugins/CodecPlugin.h>
+
+#include "AudioMixerSlave.h"
+#include "AudioMixerSlavePool.h"
+
+// Runs the audio mixer's frame (packet processing, mixing, encoding and sending) against synthetic agents
+// standing on a grid, ramping up the number of listeners until the frame budget is blown.
+class AudioMixerBench : public QCoreApplication {
+    Q_OBJECT
+public:
+    AudioMixerBench(int argc, char* argv[]);
+    ~AudioMixerBench();
+
+private slots:
+    void run();
+
+private:
+    struct Agent {
+        SharedNodePointer node;
+        Encoder* encoder { nullptr };
+        quint16 sequence { 0 };
+        glm::vec3 position;
+        int sourceOffset { 0 };
+    };
+
+    struct FrameTimings {
+        uint64_t processPackets { 0 };  // us
+        uint64_t mix { 0 };             // ns, summed over the slave threads
+        uint64_t encode { 0 };          // ns, summed over the slave threads
+        uint64_t total { 0 };           // us, wall clock of packet processing and mixing (mix and encode included)
+    };
+
+    bool loadSource(const QString& path);
+    void generateSource();
+    bool setupCodec();
+    void addAgents(int numAgents);
+    void queueAudioPackets();
+    void runFrame(FrameTimings& timings);
+
+    // options
+    QString _wavPath;
+    QString _codecName { "pcm" };
+    int _maxListeners { 1000 };
+    int _listenerStep { 50 };
+    int _numFrames { 200 };
+    int _numThreads { 1 };
+    float _spacing { 2.0f };
+    bool _useHRTFCache { false };
+    bool _verbose { false };
+
+    QByteArray _source;     // 24kHz mono int16 samples
+    CodecPluginPointer _codec;
+
+    std::vector<Agent> _agents;
+    unsigned int _frame { 1 };
+
+    AudioMixerSlave::SharedData _sharedData;
+    std::unique_ptr<AudioMixerSlavePool> _slavePool;
+};
+
+#endif // hifi_AudioMixerBench_h
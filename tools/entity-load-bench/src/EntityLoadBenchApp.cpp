@@ -0,0 +1,194 @@
+//
+//  EntityLoadBenchApp.cpp
+//  tools/entity-load-bench/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityLoadBenchApp.h"
+
+#include <random>
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThreadPool>
+#include <QUuid>
+
+#if defined(Q_OS_WIN)
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <Gzip.h>
+#include <NodeList.h>
+#include <SharedUtil.h>
+#include <udt/PacketHeaders.h>
+
+#include "AssignmentParentFinder.h"
+
+static const int DEFAULT_NUM_ENTITIES = 200000;
+static const float SYNTHETIC_DOMAIN_SCALE = 1000.0f;
+static const quint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+
+static quint64 getPeakResidentBytes() {
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(Q_OS_MAC)
+    return usage.ru_maxrss;
+#else
+    return (quint64)usage.ru_maxrss * 1024;    // in kilobytes on Linux
+#endif
+#endif
+}
+
+EntityLoadBenchApp::EntityLoadBenchApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity entity server load benchmark");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "entities file to load, rather than a synthetic one", "models.json.gz");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption numEntitiesOption("n", "number of entities in the synthetic file", "count",
+                                               QString::number(DEFAULT_NUM_ENTITIES));
+    parser.addOption(numEntitiesOption);
+
+    const QCommandLineOption threadsOption("threads", "number of threads to load with (defaults to one per core)", "count");
+    parser.addOption(threadsOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    if (parser.isSet(threadsOption)) {
+        QThreadPool::globalInstance()->setMaxThreadCount(std::max(parser.value(threadsOption).toInt(), 1));
+    }
+
+    QTemporaryDir syntheticDir;
+    QString filename;
+    if (parser.isSet(inputFilenameOption)) {
+        filename = parser.value(inputFilenameOption);
+    } else {
+        filename = syntheticDir.filePath("models.json.gz");
+        if (!writeSyntheticEntities(filename, std::max(parser.value(numEntitiesOption).toInt(), 1))) {
+            _returnCode = 2;
+            return;
+        }
+    }
+
+    // entities are added as they would be by the entity server
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>(false, [&]{ return QString("Mozilla/5.0 (HighFidelityEntityLoadBench)"); });
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, 0);
+
+    if (!loadEntities(filename)) {
+        _returnCode = 3;
+    }
+
+    DependencyManager::destroy<NodeList>();
+}
+
+bool EntityLoadBenchApp::writeSyntheticEntities(const QString& filename, int numEntities) {
+    std::mt19937 generator(numEntities);
+    std::uniform_real_distribution<float> position(-SYNTHETIC_DOMAIN_SCALE, SYNTHETIC_DOMAIN_SCALE);
+    std::uniform_real_distribution<float> dimension(0.1f, 10.0f);
+    std::uniform_int_distribution<int> color(0, 255);
+
+    // mostly boxes and spheres, with the odd model, each with a little userData as real content has
+    static const QStringList SHAPES { "Cube", "Sphere", "Cylinder" };
+    QByteArray json;
+    json.append("{\"DataVersion\":0,\"Entities\":[");
+    for (int i = 0; i < numEntities; ++i) {
+        QString entity;
+        if (i % 10 == 0) {
+            entity = QString("{\"type\":\"Model\",\"modelURL\":\"https://example.com/models/%1.fbx\",\"shapeType\":\"static-mesh\",")
+                .arg(i % 97);
+        } else {
+            entity = QString("{\"type\":\"Shape\",\"shape\":\"%1\",\"color\":{\"red\":%2,\"green\":%3,\"blue\":%4},")
+                .arg(SHAPES[i % SHAPES.size()]).arg(color(generator)).arg(color(generator)).arg(color(generator));
+        }
+        entity += QString("\"id\":\"%1\",\"name\":\"bench-%2\",\"position\":{\"x\":%3,\"y\":%4,\"z\":%5},"
+                          "\"dimensions\":{\"x\":%6,\"y\":%7,\"z\":%8},\"userData\":\"{\\\"index\\\":%2}\"}")
+            .arg(QUuid::createUuid().toString()).arg(i)
+            .arg(position(generator)).arg(position(generator)).arg(position(generator))
+            .arg(dimension(generator)).arg(dimension(generator)).arg(dimension(generator));
+        if (i > 0) {
+            json.append(',');
+        }
+        json.append(entity.toUtf8());
+    }
+    json.append(QString("],\"Id\":\"%1\",\"Version\":%2}")
+        .arg(QUuid::createUuid().toString()).arg((int)versionForPacketType(PacketType::EntityData)).toUtf8());
+
+    QByteArray compressed;
+    QFile file(filename);
+    if (!gzip(json, compressed) || !file.open(QIODevice::WriteOnly) || file.write(compressed) != compressed.size()) {
+        qCritical() << "Failed to write synthetic entities to" << filename;
+        return false;
+    }
+
+    qDebug() << "Wrote" << numEntities << "synthetic entities," << json.size() << "bytes of JSON," << compressed.size()
+        << "gzipped";
+    return true;
+}
+
+bool EntityLoadBenchApp::loadEntities(const QString& filename) {
+    auto tree = EntityTreePointer(new EntityTree(true));
+    tree->createRootElement();
+    tree->setIsServer(true);
+
+    DependencyManager::registerInheritance<SpatialParentFinder, AssignmentParentFinder>();
+    DependencyManager::set<AssignmentParentFinder>(tree);
+
+    quint64 peakBefore = getPeakResidentBytes();
+    quint64 start = usecTimestampNow();
+    bool success = false;
+    tree->withWriteLock([&] {
+        success = tree->readFromFile(filename.toLocal8Bit().constData());
+    });
+    quint64 elapsed = usecTimestampNow() - start;
+    quint64 peakAfter = getPeakResidentBytes();
+
+    DependencyManager::destroy<AssignmentParentFinder>();
+
+    if (!success) {
+        qCritical() << "Failed to load entities from" << filename;
+        return false;
+    }
+
+    qDebug().noquote() << QString("Loaded %1 entities with %2 threads in %3 ms; peak RSS %4 MB (%5 MB before loading)")
+        .arg(tree->getEntitySnapshot().size()).arg(QThreadPool::globalInstance()->maxThreadCount())
+        .arg(elapsed / USECS_PER_MSEC).arg(peakAfter / BYTES_PER_MEGABYTE).arg(peakBefore / BYTES_PER_MEGABYTE);
+    return true;
+}
@@ -0,0 +1,33 @@
+//
+//  EntityLoadBenchApp.h
+//  tools/entity-load-bench/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityLoadBenchApp_h
+#define hifi_EntityLoadBenchApp_h
+
+#include <QCoreApplication>
+
+// Times how long an entity server takes to load its persist file, and how much memory that takes at its peak.
+// Loads the given file, or a synthetic gzipped JSON file with as many entities as asked for.
+class EntityLoadBenchApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    EntityLoadBenchApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    bool writeSyntheticEntities(const QString& filename, int numEntities);
+    bool loadEntities(const QString& filename);
+
+    int _returnCode { 0 };
+};
+
+#endif // hifi_EntityLoadBenchApp_h
@@ -0,0 +1,133 @@
+//
+//  EntitySnapshotApp.cpp
+//  tools/entity-snapshot/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySnapshotApp.h"
+
+#include <QCommandLineParser>
+#include <QDataStream>
+#include <QFile>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <Gzip.h>
+#include <NodeList.h>
+#include <PerfStat.h>
+
+#include "AssignmentParentFinder.h"
+
+EntitySnapshotApp::EntitySnapshotApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity entities file converter");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input file", "models.json.gz");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption outputFilenameOption("o", "output file, in the format given by its extension", "models.snapshot");
+    parser.addOption(outputFilenameOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    if (!parser.isSet(inputFilenameOption) || !parser.isSet(outputFilenameOption)) {
+        qCritical() << "Both an input and an output file are required";
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    // entities are added as they would be by the entity server
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>(false, [&]{ return QString("Mozilla/5.0 (HighFidelityEntitySnapshot)"); });
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, 0);
+
+    _tree = EntityTreePointer(new EntityTree(true));
+    _tree->createRootElement();
+    _tree->setIsServer(true);
+
+    DependencyManager::registerInheritance<SpatialParentFinder, AssignmentParentFinder>();
+    DependencyManager::set<AssignmentParentFinder>(_tree);
+
+    if (!readEntities(parser.value(inputFilenameOption))) {
+        _returnCode = 2;
+    } else if (!writeEntities(parser.value(outputFilenameOption))) {
+        _returnCode = 3;
+    }
+
+    DependencyManager::destroy<AssignmentParentFinder>();
+    DependencyManager::destroy<NodeList>();
+}
+
+bool EntitySnapshotApp::readEntities(const QString& inputFilename) {
+    QFile file(inputFilename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open file" << inputFilename;
+        return false;
+    }
+
+    // read the file as given, rather than the most recent of its siblings as Octree::readFromFile() would
+    QByteArray data = file.readAll();
+    QByteArray uncompressedData;
+    if (gunzip(data, uncompressedData)) {
+        data = uncompressedData;
+    }
+
+    bool success = false;
+    _tree->withWriteLock([&] {
+        PerformanceWarning warn(true, "Reading entities", true);
+        QDataStream inputStream(data);
+        success = _tree->readFromStream(data.size(), inputStream);
+    });
+
+    if (!success) {
+        qCritical() << "Failed to read entities from" << inputFilename;
+        return false;
+    }
+
+    qDebug() << "Read" << _tree->getEntitySnapshot().size() << "entities from" << inputFilename;
+    return true;
+}
+
+bool EntitySnapshotApp::writeEntities(const QString& outputFilename) {
+    QString persistAsFileType;
+    for (const auto& extension : PERSIST_EXTENSIONS) {
+        if (outputFilename.endsWith("." + extension, Qt::CaseInsensitive) && extension.size() > persistAsFileType.size()) {
+            persistAsFileType = extension;
+        }
+    }
+
+    if (persistAsFileType.isEmpty()) {
+        qCritical() << "Output file" << outputFilename << "should end in one of" << PERSIST_EXTENSIONS;
+        return false;
+    }
+
+    PerformanceWarning warn(true, "Writing entities", true);
+    if (!_tree->writeToFile(outputFilename.toLocal8Bit().constData(), nullptr, persistAsFileType)) {
+        qCritical() << "Failed to write entities to" << outputFilename;
+        return false;
+    }
+
+    qDebug() << "Wrote" << outputFilename;
+    return true;
+}
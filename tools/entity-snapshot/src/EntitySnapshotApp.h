@@ -0,0 +1,36 @@
+//
+//  EntitySnapshotApp.h
+//  tools/entity-snapshot/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySnapshotApp_h
+#define hifi_EntitySnapshotApp_h
+
+#include <QCoreApplication>
+
+#include <EntityTree.h>
+
+// Converts an entity server's persist file between the JSON formats and the binary snapshot format,
+// picking the output format from the output file's extension.
+class EntitySnapshotApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    EntitySnapshotApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    bool readEntities(const QString& inputFilename);
+    bool writeEntities(const QString& outputFilename);
+
+    EntityTreePointer _tree;
+    int _returnCode { 0 };
+};
+
+#endif // hifi_EntitySnapshotApp_h
@@ -0,0 +1,21 @@
+//
+//  main.cpp
+//  tools/entity-snapshot/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SharedUtil.h>
+
+#include "EntitySnapshotApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Entity Snapshot");
+
+    EntitySnapshotApp app(argc, argv);
+    return app.getReturnCode();
+}
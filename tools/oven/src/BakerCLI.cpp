@@ -50,17 +50,12 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
         QUrl bakeableModelURL = getBakeableModelURL(inputUrl);
         if (!bakeableModelURL.isEmpty()) {
             _baker = getModelBaker(bakeableModelURL, outputPath);
-            if (_baker) {
-                _baker->moveToThread(Oven::instance().getNextWorkerThread());
-            }
         }
     } else if (type == SCRIPT_EXTENSION) {
         // FIXME: disabled for now because it breaks some scripts
         //_baker = std::unique_ptr<Baker> { new JSBaker(inputUrl, outputPath) };
-        //_baker->moveToThread(Oven::instance().getNextWorkerThread());
     } else if (type == MATERIAL_EXTENSION) {
         _baker = std::unique_ptr<Baker> { new MaterialBaker(inputUrl.toDisplayString(), true, outputPath) };
-        _baker->moveToThread(Oven::instance().getNextWorkerThread());
     } else {
         // If the type doesn't match the above, we assume we have a texture, and the type specified is the
         // texture usage type (albedo, cubemap, normals, etc.)
@@ -94,7 +89,6 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
                 QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
             }
             _baker = std::unique_ptr<Baker> { new TextureBaker(inputUrl, it->second, outputPath) };
-            _baker->moveToThread(Oven::instance().getNextWorkerThread());
         }
     }
 
@@ -104,15 +98,18 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
         return;
     }
 
-    // invoke the bake method on the baker thread
-    QMetaObject::invokeMethod(_baker.get(), "bake");
-
     // make sure we hear about the results of this baker when it is done
     connect(_baker.get(), &Baker::finished, this, &BakerCLI::handleFinishedBaker);
+
+    // bake it on a worker thread, along with the bakers it starts
+    Oven::instance().startBaker(_baker.get());
 }
 
 void BakerCLI::handleFinishedBaker() {
     qCDebug(model_baking) << "Finished baking file.";
+    for (const auto& stageTiming : Oven::instance().getStageTimingSummary()) {
+        qCInfo(model_baking).noquote() << stageTiming;
+    }
     int exitCode = OVEN_STATUS_CODE_SUCCESS;
     // Do we need this?
     if (_baker->wasAborted()) {
@@ -167,10 +167,8 @@ void DomainBaker::addModelBaker(const QString& property, const QString& url, con
                 _modelBakers.insert(bakeableModelURL, baker);
                 haveBaker = true;
 
-                // move the baker to the baker thread
-                // and kickoff the bake
-                baker->moveToThread(Oven::instance().getNextWorkerThread());
-                QMetaObject::invokeMethod(baker.data(), "bake", Qt::QueuedConnection);
+                // queue the baker to be baked on the next free worker thread
+                Oven::instance().startBaker(baker.data());
 
                 // keep track of the total number of baking entities
                 ++_totalNumberOfSubBakes;
@@ -211,9 +209,8 @@ void DomainBaker::addTextureBaker(const QString& property, const QString& url, i
             // insert it into our bakers hash so we hold a strong pointer to it
             _textureBakers.insert(key, textureBaker);
 
-            // move the baker to a worker thread and kickoff the bake
-            textureBaker->moveToThread(Oven::instance().getNextWorkerThread());
-            QMetaObject::invokeMethod(textureBaker.data(), "bake", Qt::QueuedConnection);
+            // queue the baker to be baked on the next free worker thread
+            Oven::instance().startBaker(textureBaker.data());
 
             // keep track of the total number of baking entities
             ++_totalNumberOfSubBakes;
@@ -247,9 +244,8 @@ void DomainBaker::addScriptBaker(const QString& property, const QString& url, co
         // insert it into our bakers hash so we hold a strong pointer to it
         _scriptBakers.insert(scriptURL, scriptBaker);
 
-        // move the baker to a worker thread and kickoff the bake
-        scriptBaker->moveToThread(Oven::instance().getNextWorkerThread());
-        QMetaObject::invokeMethod(scriptBaker.data(), "bake", Qt::QueuedConnection);
+        // queue the baker to be baked on the next free worker thread
+        Oven::instance().startBaker(scriptBaker.data());
 
         // keep track of the total number of baking entities
         ++_totalNumberOfSubBakes;
@@ -284,9 +280,8 @@ void DomainBaker::addMaterialBaker(const QString& property, const QString& data,
         // insert it into our bakers hash so we hold a strong pointer to it
         _materialBakers.insert(materialData, materialBaker);
 
-        // move the baker to a worker thread and kickoff the bake
-        materialBaker->moveToThread(Oven::instance().getNextWorkerThread());
-        QMetaObject::invokeMethod(materialBaker.data(), "bake", Qt::QueuedConnection);
+        // queue the baker to be baked on the next free worker thread
+        Oven::instance().startBaker(materialBaker.data());
 
         // keep track of the total number of baking entities
         ++_totalNumberOfSubBakes;
@@ -746,6 +741,10 @@ void DomainBaker::checkIfRewritingComplete() {
             return;
         }
 
+        for (const auto& stageTiming : Oven::instance().getStageTimingSummary()) {
+            qDebug().noquote() << stageTiming;
+        }
+
         // we've now written out our new models file - time to say that we are finished up
         emit finished();
     }
@@ -14,6 +14,8 @@
 #include <QtCore/QDebug>
 #include <QtCore/QThread>
 
+#include <algorithm>
+
 #include <image/TextureProcessing.h>
 
 #include <DependencyManager.h>
@@ -26,7 +28,10 @@
 #include <hfm/ModelFormatRegistry.h>
 #include <FBXSerializer.h>
 #include <OBJSerializer.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 
+#include "Baker.h"
 #include "MaterialBaker.h"
 
 Oven* Oven::_staticInstance { nullptr };
@@ -45,8 +50,8 @@ Oven::Oven() {
     DependencyManager::set<TextureCache>();
     DependencyManager::set<MaterialCache>();
 
-    MaterialBaker::setNextOvenWorkerThreadOperator([] {
-        return Oven::instance().getNextWorkerThread();
+    MaterialBaker::setStartOvenBakerOperator([](Baker* baker, Baker* dependent) {
+        Oven::instance().startBaker(baker, dependent);
     });
 
     {
@@ -84,14 +89,9 @@ void Oven::setupWorkerThreads(int numWorkerThreads) {
 }
 
 QThread* Oven::getNextWorkerThread() {
-    // FIXME: we assign these threads when we make the bakers, but if certain bakers finish quickly, we could end up
-    // in a situation where threads have finished and others have tons of work queued.  Instead of assigning them at initialization,
-    // we should build a queue of bakers, and when threads finish, they can take the next available baker.
-
     // Here we replicate some of the functionality of QThreadPool by giving callers an available worker thread to use.
     // We can't use QThreadPool because we want to put QObjects with signals/slots on these threads.
-    // So instead we setup our own list of threads, up to one less than the ideal thread count
-    // (for the FBX Baker Thread to have room), and cycle through them to hand a usable running thread back to our callers.
+    // Bakers that do the work go through startBaker instead, so that they are handed to threads as they free up.
 
     auto nextIndex = ++_nextWorkerThreadIndex;
     auto& nextThread = _workerThreads[nextIndex % _workerThreads.size()];
@@ -104,3 +104,171 @@ QThread* Oven::getNextWorkerThread() {
     return nextThread.get();
 }
 
+void Oven::startBaker(Baker* baker, Baker* dependent) {
+    QueuedBaker queued;
+    queued.baker = baker;
+    queued.stage = baker->metaObject()->className();
+    queued.queuedUsecs = usecTimestampNow();
+
+    // bakers that are aborted or destroyed don't always say they are finished
+    auto finish = [baker] {
+        if (_staticInstance) {
+            _staticInstance->finishBaker(baker);
+        }
+    };
+    QObject::connect(baker, &Baker::finished, finish);
+    QObject::connect(baker, &Baker::aborted, finish);
+    QObject::connect(baker, &QObject::destroyed, finish);
+
+    Lock lock(_bakersMutex);
+
+    if (dependent) {
+        auto it = _runningBakers.find(dependent);
+        if (it != _runningBakers.end()) {
+            queued.parent = dependent;
+            ++it->second.numDependencies;
+
+            // the dependent is still running, and only waits once the work it is doing now returns
+            it->second.isWaiting = false;
+            QMetaObject::invokeMethod(dependent, [dependent] {
+                if (_staticInstance) {
+                    _staticInstance->setWaiting(dependent);
+                }
+            }, Qt::QueuedConnection);
+        }
+        _queuedDependencies.push_back(queued);
+    } else {
+        _queuedBakers.push_back(queued);
+    }
+
+    startQueuedBakers();
+}
+
+void Oven::startQueuedBakers() {
+    std::vector<int> numRunning(_workerThreads.size(), 0);
+    std::vector<int> numBusy(_workerThreads.size(), 0);
+    for (const auto& running : _runningBakers) {
+        ++numRunning[running.second.threadIndex];
+        if (!running.second.isWaiting) {
+            ++numBusy[running.second.threadIndex];
+        }
+    }
+
+    while (!_queuedDependencies.empty() || !_queuedBakers.empty()) {
+        // dependencies can go to a thread whose bakers are waiting, preferring one with none, other bakers need an idle one
+        bool isDependency = !_queuedDependencies.empty();
+        int threadIndex = -1;
+        for (int i = 0; i < (int)_workerThreads.size(); ++i) {
+            bool isFree = isDependency ? numBusy[i] == 0 : numRunning[i] == 0;
+            if (isFree && (threadIndex == -1 || numRunning[i] < numRunning[threadIndex])) {
+                threadIndex = i;
+            }
+        }
+        if (threadIndex == -1) {
+            return;
+        }
+
+        auto& queue = isDependency ? _queuedDependencies : _queuedBakers;
+        QueuedBaker queued = queue.front();
+        queue.pop_front();
+
+        if (!queued.baker) {
+            // destroyed before it got a thread
+            releaseDependency(queued.parent);
+            continue;
+        }
+
+        RunningBaker running;
+        running.threadIndex = threadIndex;
+        running.parent = queued.parent;
+        running.stage = queued.stage;
+        running.queuedUsecs = queued.queuedUsecs;
+        running.startedUsecs = usecTimestampNow();
+        _runningBakers[queued.baker.data()] = running;
+        ++numRunning[threadIndex];
+        ++numBusy[threadIndex];
+
+        QThread* thread = _workerThreads[threadIndex].get();
+        if (!thread->isRunning()) {
+            thread->start();
+        }
+
+        // an object can only be pushed to another thread from the one it lives on, so the baker is moved from there
+        Baker* baker = queued.baker.data();
+        QMetaObject::invokeMethod(baker, [baker, thread] {
+            baker->moveToThread(thread);
+            QMetaObject::invokeMethod(baker, "bake", Qt::QueuedConnection);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void Oven::releaseDependency(Baker* parent) {
+    if (!parent) {
+        return;
+    }
+
+    auto it = _runningBakers.find(parent);
+    if (it != _runningBakers.end() && it->second.numDependencies > 0) {
+        if (--it->second.numDependencies == 0) {
+            // it carries on with what it was waiting for
+            it->second.isWaiting = false;
+        }
+    }
+}
+
+void Oven::setWaiting(Baker* baker) {
+    Lock lock(_bakersMutex);
+
+    auto it = _runningBakers.find(baker);
+    if (it != _runningBakers.end() && it->second.numDependencies > 0) {
+        it->second.isWaiting = true;
+        startQueuedBakers();
+    }
+}
+
+void Oven::finishBaker(Baker* baker) {
+    Lock lock(_bakersMutex);
+
+    auto it = _runningBakers.find(baker);
+    if (it == _runningBakers.end()) {
+        // already finished, or still queued and released when its turn comes
+        return;
+    }
+
+    const RunningBaker& running = it->second;
+    quint64 now = usecTimestampNow();
+    quint64 bakeUsecs = now - running.startedUsecs;
+
+    StageTiming& timing = _stageTimings[running.stage];
+    ++timing.numBaked;
+    timing.totalQueuedUsecs += running.startedUsecs - running.queuedUsecs;
+    timing.totalBakeUsecs += bakeUsecs;
+    timing.maxBakeUsecs = std::max(timing.maxBakeUsecs, bakeUsecs);
+
+    Baker* parent = running.parent;
+    _runningBakers.erase(it);
+    releaseDependency(parent);
+
+    startQueuedBakers();
+}
+
+QStringList Oven::getStageTimingSummary() const {
+    Lock lock(_bakersMutex);
+
+    auto seconds = [](quint64 usecs) {
+        return QString::number((double)usecs / USECS_PER_SECOND, 'f', 2) + "s";
+    };
+
+    QStringList summary;
+    for (auto it = _stageTimings.begin(); it != _stageTimings.end(); ++it) {
+        const StageTiming& timing = it.value();
+        summary << QString("%1: %2 baked, %3 total, %4 average, %5 longest, %6 average wait")
+            .arg(it.key())
+            .arg(timing.numBaked)
+            .arg(seconds(timing.totalBakeUsecs))
+            .arg(seconds(timing.totalBakeUsecs / timing.numBaked))
+            .arg(seconds(timing.maxBakeUsecs))
+            .arg(seconds(timing.totalQueuedUsecs / timing.numBaked));
+    }
+    return summary;
+}
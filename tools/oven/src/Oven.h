@@ -13,10 +13,18 @@
 #define hifi_Oven_h
 
 #include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
+#include <QtCore/QMap>
+#include <QtCore/QPointer>
+#include <QtCore/QStringList>
+
 class QThread;
+class Baker;
 
 class Oven {
 
@@ -26,17 +34,70 @@ public:
 
     static Oven& instance() { return *_staticInstance; }
 
+    // Queues the baker, which is moved to the next free worker thread and baked there. A baker started by another
+    // baker that waits on it, like the textures of a model's materials, is that baker's dependency: dependencies are
+    // started before anything else that is queued, and once the bakers on a thread have gone back to its event loop
+    // to wait on their dependencies, the thread takes dependencies, so that the bakers waiting can't hold up what they
+    // wait on. It doesn't take other bakers, which would hold up the waiting bakers when their dependencies finish.
+    // Call it from the thread the baker lives on.
+    void startBaker(Baker* baker, Baker* dependent = nullptr);
+
+    // For bakers that only wait on the bakers they start, such as DomainBaker; they don't take a place in the queue,
+    // which would keep a thread from the bakers they wait on.
     QThread* getNextWorkerThread();
 
+    // The number of bakers of each type that have finished, how long they took and how long they were queued for
+    QStringList getStageTimingSummary() const;
+
 private:
+    struct QueuedBaker {
+        QPointer<Baker> baker;
+        Baker* parent { nullptr };      // the running baker this is a dependency of
+        QString stage;
+        quint64 queuedUsecs { 0 };
+    };
+
+    struct RunningBaker {
+        int threadIndex { 0 };
+        Baker* parent { nullptr };
+        QString stage;
+        quint64 queuedUsecs { 0 };
+        quint64 startedUsecs { 0 };
+        int numDependencies { 0 };
+        bool isWaiting { false };       // back in its thread's event loop with dependencies still to finish
+    };
+
+    struct StageTiming {
+        int numBaked { 0 };
+        quint64 totalQueuedUsecs { 0 };
+        quint64 totalBakeUsecs { 0 };
+        quint64 maxBakeUsecs { 0 };
+    };
+
+    using Lock = std::unique_lock<std::mutex>;
+
     void setupWorkerThreads(int numWorkerThreads);
     void setupFBXBakerThread();
 
+    // called with the lock held
+    void startQueuedBakers();
+    void releaseDependency(Baker* parent);
+
+    void setWaiting(Baker* baker);
+
+    void finishBaker(Baker* baker);
+
     std::vector<std::unique_ptr<QThread>> _workerThreads;
 
     std::atomic<uint32_t> _nextWorkerThreadIndex;
     int _numWorkerThreads;
 
+    mutable std::mutex _bakersMutex;
+    std::deque<QueuedBaker> _queuedDependencies;
+    std::deque<QueuedBaker> _queuedBakers;
+    std::unordered_map<Baker*, RunningBaker> _runningBakers;
+    QMap<QString, StageTiming> _stageTimings;
+
     static Oven* _staticInstance;
 };
 
@@ -221,7 +221,8 @@ void DomainBakeWidget::bakeButtonClicked() {
         // watch the baker's progress so that we can put its progress in the results table
         connect(domainBaker.get(), &DomainBaker::bakeProgress, this, &DomainBakeWidget::handleBakerProgress);
 
-        // move the baker to the next available Oven worker thread
+        // move the baker to an Oven worker thread; it only waits on the bakers it queues, so it doesn't take a place
+        // in the queue itself
         auto nextThread = Oven::instance().getNextWorkerThread();
         domainBaker->moveToThread(nextThread);
 
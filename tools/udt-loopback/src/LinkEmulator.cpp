@@ -0,0 +1,120 @@
+//
+//  LinkEmulator.cpp
+//  tools/udt-loopback/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LinkEmulator.h"
+
+#include <algorithm>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+static const int DELIVERY_INTERVAL_MSECS = 1;
+static const double BITS_PER_BYTE = 8.0;
+
+LinkEmulator::LinkEmulator(const Settings& settings) :
+    _settings(settings)
+{
+}
+
+void LinkEmulator::start() {
+    _socket = new QUdpSocket(this);
+    _socket->bind(QHostAddress::LocalHost, 0);
+    _localPort = _socket->localPort();
+    connect(_socket, &QUdpSocket::readyRead, this, &LinkEmulator::readDatagrams);
+
+    _deliveryTimer = new QTimer(this);
+    _deliveryTimer->setTimerType(Qt::PreciseTimer);
+    connect(_deliveryTimer, &QTimer::timeout, this, &LinkEmulator::deliverDatagrams);
+    _deliveryTimer->start(DELIVERY_INTERVAL_MSECS);
+}
+
+void LinkEmulator::setEndpoints(const HifiSockAddr& sender, const HifiSockAddr& receiver) {
+    _sender = sender;
+    _receiver = receiver;
+
+    // a new pair of endpoints starts on an idle link
+    _pending.clear();
+    _bottleneckFreeAt = 0;
+}
+
+LinkEmulator::Stats LinkEmulator::sampleStats() {
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    Stats stats = _stats;
+    _stats = Stats();
+    return stats;
+}
+
+void LinkEmulator::readDatagrams() {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    while (_socket->hasPendingDatagrams()) {
+        QByteArray data(_socket->pendingDatagramSize(), 0);
+        QHostAddress address;
+        quint16 port;
+        _socket->readDatagram(data.data(), data.size(), &address, &port);
+
+        auto now = usecTimestampNow();
+        quint64 jitter = _settings.jitterMsecs > 0 ? (quint64)(unit(_generator) * _settings.jitterMsecs * USECS_PER_MSEC) : 0;
+        quint64 propagation = _settings.delayMsecs * USECS_PER_MSEC + jitter;
+
+        if (HifiSockAddr(address, port) != _sender) {
+            // the return path is not the bottleneck
+            schedule(now + propagation, data, _sender);
+            continue;
+        }
+
+        if (unit(_generator) < _settings.lossRatio) {
+            std::lock_guard<std::mutex> lock(_statsMutex);
+            ++_stats.lostPackets;
+            continue;
+        }
+
+        // drop-tail bottleneck queue: the datagram leaves once everything ahead of it has been serialized
+        double usecsPerByte = BITS_PER_BYTE / _settings.rateMbps;
+        quint64 queueStart = std::max(now, _bottleneckFreeAt);
+        quint64 queueDelay = queueStart - now;
+
+        if (queueDelay * _settings.rateMbps / BITS_PER_BYTE > _settings.bufferBytes) {
+            std::lock_guard<std::mutex> lock(_statsMutex);
+            ++_stats.queueDrops;
+            continue;
+        }
+
+        _bottleneckFreeAt = queueStart + (quint64)(data.size() * usecsPerByte);
+
+        {
+            std::lock_guard<std::mutex> lock(_statsMutex);
+            ++_stats.forwardedPackets;
+            _stats.forwardedBytes += data.size();
+            _stats.queueDelayUsecs += queueDelay;
+            _stats.maxQueueDelayUsecs = std::max(_stats.maxQueueDelayUsecs, queueDelay);
+        }
+
+        schedule(_bottleneckFreeAt + propagation, data, _receiver);
+    }
+}
+
+void LinkEmulator::deliverDatagrams() {
+    auto now = usecTimestampNow();
+    while (!_pending.empty() && _pending.front().deliverAt <= now) {
+        auto& datagram = _pending.front();
+        _socket->writeDatagram(datagram.data, datagram.destination.getAddress(), datagram.destination.getPort());
+        _pending.pop_front();
+    }
+}
+
+void LinkEmulator::schedule(quint64 deliverAt, QByteArray data, const HifiSockAddr& destination) {
+    // jitter can reorder datagrams, just like a real path
+    auto it = std::upper_bound(_pending.begin(), _pending.end(), deliverAt, [](quint64 time, const Datagram& datagram) {
+        return time < datagram.deliverAt;
+    });
+    _pending.insert(it, { deliverAt, std::move(data), destination });
+}
@@ -0,0 +1,93 @@
+//
+//  LinkEmulator.h
+//  tools/udt-loopback/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_LinkEmulator_h
+#define hifi_LinkEmulator_h
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <random>
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtNetwork/QUdpSocket>
+
+#include <HifiSockAddr.h>
+
+// A UDP relay that stands in for the path between two local sockets.
+// Datagrams from the sender go through a drop-tail bottleneck queue of limited rate, random loss and a propagation
+// delay with jitter; datagrams from the receiver (ACKs) only see the propagation delay.
+class LinkEmulator : public QObject {
+    Q_OBJECT
+public:
+    struct Settings {
+        double lossRatio { 0.0 };
+        int delayMsecs { 0 }; // one way
+        int jitterMsecs { 0 };
+        double rateMbps { 10.0 };
+        int bufferBytes { 64 * 1024 };
+    };
+
+    struct Stats {
+        uint64_t forwardedPackets { 0 };
+        uint64_t forwardedBytes { 0 };
+        uint64_t lostPackets { 0 };
+        uint64_t queueDrops { 0 };
+        uint64_t queueDelayUsecs { 0 }; // summed over forwarded packets
+        uint64_t maxQueueDelayUsecs { 0 };
+    };
+
+    LinkEmulator(const Settings& settings);
+
+    // both must be called on the emulator's thread
+    void start();
+    void setEndpoints(const HifiSockAddr& sender, const HifiSockAddr& receiver);
+
+    // the port the sender should send to, valid once start() has run
+    quint16 localPort() const { return _localPort; }
+
+    Stats sampleStats();
+
+private slots:
+    void readDatagrams();
+    void deliverDatagrams();
+
+private:
+    struct Datagram {
+        quint64 deliverAt;
+        QByteArray data;
+        HifiSockAddr destination;
+    };
+
+    void schedule(quint64 deliverAt, QByteArray data, const HifiSockAddr& destination);
+
+    Settings _settings;
+
+    QUdpSocket* _socket { nullptr };
+    QTimer* _deliveryTimer { nullptr };
+    std::atomic<quint16> _localPort { 0 };
+
+    HifiSockAddr _sender;
+    HifiSockAddr _receiver;
+
+    std::deque<Datagram> _pending; // sorted by delivery time
+    quint64 _bottleneckFreeAt { 0 };
+
+    std::mt19937 _generator { 742272 };
+
+    std::mutex _statsMutex;
+    Stats _stats;
+};
+
+#endif // hifi_LinkEmulator_h
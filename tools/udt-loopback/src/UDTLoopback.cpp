@@ -0,0 +1,221 @@
+//
+//  UDTLoopback.cpp
+//  tools/udt-loopback/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UDTLoopback.h"
+
+#include <QtCore/QDebug>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <udt/CongestionControl.h>
+#include <udt/Packet.h>
+
+const QCommandLineOption CONGESTION_CONTROL_OPTION {
+    "cc", "comma separated congestion controls to compare (default is vegas,bbr)", "names", "vegas,bbr"
+};
+const QCommandLineOption LOSS_OPTION { "loss", "random loss on the forward path (default is 0)", "percent", "0" };
+const QCommandLineOption DELAY_OPTION { "delay", "one way propagation delay (default is 40)", "milliseconds", "40" };
+const QCommandLineOption JITTER_OPTION { "jitter", "extra random delay per datagram (default is 0)", "milliseconds", "0" };
+const QCommandLineOption RATE_OPTION { "rate", "bottleneck rate (default is 20)", "Mb/s", "20" };
+const QCommandLineOption BUFFER_OPTION { "buffer", "bottleneck buffer (default is 128)", "kilobytes", "128" };
+const QCommandLineOption DURATION_OPTION { "duration", "length of each transfer (default is 10)", "seconds", "10" };
+const QCommandLineOption PACKET_SIZE_OPTION {
+    "packet-size", "size for sent packets in bytes (defaults to " + QString::number(udt::MAX_PACKET_SIZE) + ")", "bytes"
+};
+
+const QStringList STATS_TABLE_HEADERS {
+    "   CC   ", "Goodput (Mb/s)", "Avg Queue (ms)", "Max Queue (ms)", "Lost (P)", "Queue Drops (P)", "Re-sent (P)"
+};
+
+static const int NUM_INITIAL_PACKETS = 500;
+static const int STATS_INTERVAL_MSECS = 1000;
+static const double MEGABITS_PER_BYTE = 8.0 / 1000000.0;
+
+UDTLoopback::UDTLoopback(int& argc, char** argv) :
+    QCoreApplication(argc, argv)
+{
+    parseArguments();
+
+    _link = new LinkEmulator(_linkSettings);
+    _link->moveToThread(&_linkThread);
+    connect(&_linkThread, &QThread::finished, _link, &QObject::deleteLater);
+    _linkThread.start();
+    QMetaObject::invokeMethod(_link, [this] { _link->start(); }, Qt::BlockingQueuedConnection);
+
+    _statsTimer = new QTimer(this);
+    connect(_statsTimer, &QTimer::timeout, this, &UDTLoopback::sampleStats);
+
+    QMetaObject::invokeMethod(this, "startRun", Qt::QueuedConnection);
+}
+
+UDTLoopback::~UDTLoopback() {
+    _sender.reset();
+    _receiver.reset();
+
+    _linkThread.quit();
+    _linkThread.wait();
+}
+
+void UDTLoopback::parseArguments() {
+    _argumentParser.setApplicationDescription("High Fidelity UDT Congestion Control Loopback Test");
+    const QCommandLineOption helpOption = _argumentParser.addHelpOption();
+
+    _argumentParser.addOptions({
+        CONGESTION_CONTROL_OPTION, LOSS_OPTION, DELAY_OPTION, JITTER_OPTION, RATE_OPTION, BUFFER_OPTION,
+        DURATION_OPTION, PACKET_SIZE_OPTION
+    });
+
+    if (!_argumentParser.parse(arguments())) {
+        qCritical() << _argumentParser.errorText();
+        _argumentParser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (_argumentParser.isSet(helpOption)) {
+        _argumentParser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    _congestionControls = _argumentParser.value(CONGESTION_CONTROL_OPTION).split(',', QString::SkipEmptyParts);
+    for (auto& name : _congestionControls) {
+        if (!udt::createCongestionControlFactory(name)) {
+            qCritical() << "Unknown congestion control" << name;
+            _argumentParser.showHelp(1);
+        }
+    }
+
+    _linkSettings.lossRatio = _argumentParser.value(LOSS_OPTION).toDouble() / 100.0;
+    _linkSettings.delayMsecs = _argumentParser.value(DELAY_OPTION).toInt();
+    _linkSettings.jitterMsecs = _argumentParser.value(JITTER_OPTION).toInt();
+    _linkSettings.rateMbps = std::max(_argumentParser.value(RATE_OPTION).toDouble(), 0.1);
+    _linkSettings.bufferBytes = _argumentParser.value(BUFFER_OPTION).toInt() * 1024;
+    _durationSecs = std::max(_argumentParser.value(DURATION_OPTION).toInt(), 1);
+
+    if (_argumentParser.isSet(PACKET_SIZE_OPTION)) {
+        _packetSize = std::min(std::max(_argumentParser.value(PACKET_SIZE_OPTION).toInt(),
+                                        udt::Packet::localHeaderSize(false) + 1), udt::MAX_PACKET_SIZE);
+    }
+
+    qDebug().nospace() << "Link: " << _linkSettings.rateMbps << " Mb/s, " << _linkSettings.delayMsecs << " ms delay, "
+        << _linkSettings.jitterMsecs << " ms jitter, " << _linkSettings.lossRatio * 100.0 << "% loss, "
+        << _linkSettings.bufferBytes / 1024 << " KB buffer";
+}
+
+void UDTLoopback::startRun() {
+    ++_runIndex;
+    if (_runIndex >= _congestionControls.size()) {
+        qDebug() << qPrintable(STATS_TABLE_HEADERS.join(" | "));
+        for (auto& result : _results) {
+            qDebug() << qPrintable(result);
+        }
+        quit();
+        return;
+    }
+
+    auto name = _congestionControls[_runIndex];
+    qDebug() << "Running" << name << "for" << _durationSecs << "seconds";
+
+    // fresh sockets for every run, so no connection state carries over
+    _sender.reset(new udt::Socket());
+    _receiver.reset(new udt::Socket());
+    _sender->setCongestionControlFactory(udt::createCongestionControlFactory(name));
+    _sender->bind(QHostAddress::LocalHost);
+    _receiver->bind(QHostAddress::LocalHost);
+
+    _receivedBytes = 0;
+    _sampleReceivedBytes = 0;
+    _receiver->setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
+        _receivedBytes += packet->getPayloadSize();
+    });
+
+    HifiSockAddr senderAddress(QHostAddress::LocalHost, _sender->localPort());
+    HifiSockAddr receiverAddress(QHostAddress::LocalHost, _receiver->localPort());
+    QMetaObject::invokeMethod(_link, [this, senderAddress, receiverAddress] {
+        _link->setEndpoints(senderAddress, receiverAddress);
+    }, Qt::BlockingQueuedConnection);
+    _link->sampleStats();
+    _runLinkStats = LinkEmulator::Stats();
+
+    _target = HifiSockAddr(QHostAddress::LocalHost, _link->localPort());
+
+    _runStart = _lastSample = usecTimestampNow();
+    for (int i = 0; i < NUM_INITIAL_PACKETS; ++i) {
+        sendPacket();
+    }
+    // everytime we hear a packet has gone out we add a new one, so the sender is never short of data
+    _sender->connectToSendSignal(_target, this, SLOT(refillPacket()));
+
+    _statsTimer->start(STATS_INTERVAL_MSECS);
+    QTimer::singleShot(_durationSecs * MSECS_PER_SECOND, this, &UDTLoopback::finishRun);
+}
+
+void UDTLoopback::sendPacket() {
+    if (!_sender) {
+        return;
+    }
+
+    int payloadSize = _packetSize - udt::Packet::localHeaderSize(false);
+    auto packet = udt::Packet::create(payloadSize, true);
+    packet->setPayloadSize(payloadSize);
+    _sender->writePacket(std::move(packet), _target);
+}
+
+void UDTLoopback::sampleStats() {
+    auto now = usecTimestampNow();
+    auto linkStats = _link->sampleStats();
+
+    _runLinkStats.forwardedPackets += linkStats.forwardedPackets;
+    _runLinkStats.forwardedBytes += linkStats.forwardedBytes;
+    _runLinkStats.lostPackets += linkStats.lostPackets;
+    _runLinkStats.queueDrops += linkStats.queueDrops;
+    _runLinkStats.queueDelayUsecs += linkStats.queueDelayUsecs;
+    _runLinkStats.maxQueueDelayUsecs = std::max(_runLinkStats.maxQueueDelayUsecs, linkStats.maxQueueDelayUsecs);
+
+    double seconds = (double)(now - _lastSample) / USECS_PER_SECOND;
+    double goodput = (_receivedBytes - _sampleReceivedBytes) * MEGABITS_PER_BYTE / seconds;
+    double averageQueueDelay = linkStats.forwardedPackets > 0 ?
+        (double)linkStats.queueDelayUsecs / linkStats.forwardedPackets / USECS_PER_MSEC : 0.0;
+
+    qDebug().nospace() << "  " << qPrintable(QString::number(goodput, 'f', 2)) << " Mb/s, "
+        << qPrintable(QString::number(averageQueueDelay, 'f', 2)) << " ms queued";
+
+    _lastSample = now;
+    _sampleReceivedBytes = _receivedBytes;
+}
+
+void UDTLoopback::finishRun() {
+    _statsTimer->stop();
+    sampleStats();
+
+    auto senderStats = _sender->sampleStatsForConnection(_target);
+    double seconds = (double)(usecTimestampNow() - _runStart) / USECS_PER_SECOND;
+    double averageQueueDelay = _runLinkStats.forwardedPackets > 0 ?
+        (double)_runLinkStats.queueDelayUsecs / _runLinkStats.forwardedPackets / USECS_PER_MSEC : 0.0;
+
+    int headerIndex = -1;
+    QStringList values {
+        _congestionControls[_runIndex].rightJustified(STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(_receivedBytes * MEGABITS_PER_BYTE / seconds, 'f', 2).rightJustified(STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(averageQueueDelay, 'f', 2).rightJustified(STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number((double)_runLinkStats.maxQueueDelayUsecs / USECS_PER_MSEC, 'f', 2).rightJustified(STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(_runLinkStats.lostPackets).rightJustified(STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(_runLinkStats.queueDrops).rightJustified(STATS_TABLE_HEADERS[++headerIndex].size()),
+        QString::number(senderStats.retransmittedPackets).rightJustified(STATS_TABLE_HEADERS[++headerIndex].size())
+    };
+    _results << values.join(" | ");
+
+    // tearing down the sockets stops their send queues; wait for the link to go idle before the next run
+    _sender.reset();
+    _receiver.reset();
+
+    static const int DRAIN_MSECS = 500;
+    QTimer::singleShot(DRAIN_MSECS, this, &UDTLoopback::startRun);
+}
@@ -0,0 +1,75 @@
+//
+//  UDTLoopback.h
+//  tools/udt-loopback/src
+//
+//  Created by High Fidelity on 2019-10-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_UDTLoopback_h
+#define hifi_UDTLoopback_h
+
+#include <memory>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QStringList>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+#include <udt/Constants.h>
+#include <udt/Socket.h>
+
+#include "LinkEmulator.h"
+
+// Sends a bulk reliable transfer between two sockets in this process through a LinkEmulator,
+// once per congestion control, and compares their goodput and the queueing delay they cause at the bottleneck.
+class UDTLoopback : public QCoreApplication {
+    Q_OBJECT
+public:
+    UDTLoopback(int& argc, char** argv);
+    ~UDTLoopback();
+
+public slots:
+    void refillPacket() { sendPacket(); } // adds a new packet to the queue when we are told one is sent
+
+private slots:
+    void startRun();
+    void sampleStats();
+    void finishRun();
+
+private:
+    void parseArguments();
+    void sendPacket();
+
+    QCommandLineParser _argumentParser;
+
+    LinkEmulator::Settings _linkSettings;
+    QThread _linkThread;
+    LinkEmulator* _link { nullptr };
+
+    QStringList _congestionControls;
+    int _runIndex { -1 };
+    int _durationSecs { 10 };
+    int _packetSize { udt::MAX_PACKET_SIZE };
+
+    std::unique_ptr<udt::Socket> _sender;
+    std::unique_ptr<udt::Socket> _receiver;
+    HifiSockAddr _target; // the emulator, as seen by the sender
+
+    quint64 _runStart { 0 };
+    quint64 _lastSample { 0 };
+    uint64_t _receivedBytes { 0 }; // payload bytes handed to the receiver, duplicates excluded
+    uint64_t _sampleReceivedBytes { 0 };
+    LinkEmulator::Stats _runLinkStats;
+    QTimer* _statsTimer { nullptr };
+
+    QStringList _results;
+};
+
+#endif // hifi_UDTLoopback_h